@@ -365,7 +365,7 @@ void NewResearchListState::fillProjectList(bool markAllAsSeen)
 	while (researchRuleIt != _projects.end())
 	{
 		rule = (*researchRuleIt);
-		ruleStatus = _game->getSavedGame()->getResearchRuleStatus(rule->getName());
+		ruleStatus = _game->getSavedGame()->getResearchRuleStatus(rule);
 
 		// filter
 		if (_btnShowOnlyNew->getPressed() || selectedSort == 3)
@@ -354,7 +354,7 @@ bool SoldierArmorState::harnessSetArmor(const std::string& armorType)
 	{
 		if (armorItem.type == armorType)
 		{
-			Armor* next = _game->getMod()->getArmor(armorType, false);
+			Armor* next = _game->getMod()->getArmorById(_game->getMod()->getRuleId(armorType));
 			if (!next) return false;
 			applyArmorSelection(next);
 			return true;
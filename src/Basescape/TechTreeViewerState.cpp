@@ -21,6 +21,7 @@
 #include "../Engine/Action.h"
 #include "../Engine/Game.h"
 #include "../Mod/Mod.h"
+#include "../Mod/DependencyGraph.h"
 #include "../Mod/RuleArcScript.h"
 #include "../Mod/RuleBaseFacility.h"
 #include "../Mod/RuleCraft.h"
@@ -367,9 +368,6 @@ void TechTreeViewerState::initLists()
 		}
 		//
 
-		const std::vector<std::string> &researchList = _game->getMod()->getResearchList();
-		const std::vector<std::string> &manufactureList = _game->getMod()->getManufactureList();
-
 		// 0. common pre-calculation
 		const std::vector<const RuleResearch*>& reqs = rule->getRequirements();
 		const std::vector<const RuleResearch*>& deps = rule->getDependencies();
@@ -391,136 +389,41 @@ void TechTreeViewerState::initLists()
 		const std::vector<const RuleResearch*>& free = rule->getGetOneFree();
 		auto& freeProtected = rule->getGetOneFreeProtected();
 
-		for (auto& j : manufactureList)
+		const DependencyGraph::ResearchLinks &links = _game->getMod()->getDependencyGraph()->getResearch(rule);
+		for (auto* i : links.manufacture)
 		{
-			RuleManufacture *temp = _game->getMod()->getManufacture(j);
-			for (auto& i : temp->getRequirements())
-			{
-				if (i == rule)
-				{
-					requiredByManufacture.push_back(j);
-				}
-			}
+			requiredByManufacture.push_back(i->getName());
 		}
-
-		for (auto& f : _game->getMod()->getBaseFacilitiesList())
+		for (auto* i : links.facilities)
 		{
-			RuleBaseFacility *temp = _game->getMod()->getBaseFacility(f);
-			for (auto& i : temp->getRequirements())
-			{
-				if (i == rule->getName())
-				{
-					requiredByFacilities.push_back(f);
-				}
-			}
+			requiredByFacilities.push_back(i->getType());
 		}
-
-		for (auto& item : _game->getMod()->getItemsList())
+		for (auto* i : links.items)
 		{
-			RuleItem *temp = _game->getMod()->getItem(item);
-			for (auto& i : temp->getRequirements())
-			{
-				if (i == rule)
-				{
-					requiredByItems.push_back(item);
-				}
-			}
-			for (auto& i : temp->getBuyRequirements())
-			{
-				if (i == rule)
-				{
-					requiredByItems.push_back(item);
-				}
-			}
+			requiredByItems.push_back(i->getType());
 		}
-
-		for (auto& transf : _game->getMod()->getSoldierTransformationList())
+		for (auto* i : links.transformations)
 		{
-			RuleSoldierTransformation* temp = _game->getMod()->getSoldierTransformation(transf);
-			for (auto& i : temp->getRequiredResearch())
-			{
-				if (i == rule->getName())
-				{
-					requiredByTransformations.push_back(transf);
-				}
-			}
+			requiredByTransformations.push_back(i->getName());
 		}
-
-		for (auto& c : _game->getMod()->getCraftsList())
+		for (auto* i : links.crafts)
 		{
-			RuleCraft *temp = _game->getMod()->getCraft(c);
-			for (auto& i : temp->getRequirements())
-			{
-				if (i == rule->getName())
-				{
-					requiredByCrafts.push_back(c);
-				}
-			}
+			requiredByCrafts.push_back(i->getType());
 		}
-
-		for (auto& j : researchList)
+		auto names = [](const std::vector<RuleResearch*> &list, std::vector<std::string> &out)
 		{
-			RuleResearch *temp = _game->getMod()->getResearch(j);
-			for (auto& i : temp->getUnlocked())
-			{
-				if (i == rule)
-				{
-					unlockedBy.push_back(j);
-				}
-			}
-			for (auto& i : temp->getDisabled())
-			{
-				if (i == rule)
-				{
-					disabledBy.push_back(j);
-				}
-			}
-			for (auto& i : temp->getReenabled())
-			{
-				if (i == rule)
-				{
-					reenabledBy.push_back(j);
-				}
-			}
-			for (auto& i : temp->getGetOneFree())
+			for (auto* i : list)
 			{
-				if (i == rule)
-				{
-					getForFreeFrom.push_back(j);
-				}
+				out.push_back(i->getName());
 			}
-			for (auto& itMap : temp->getGetOneFreeProtected())
-			{
-				for (auto& i : itMap.second)
-				{
-					if (i == rule)
-					{
-						getForFreeFrom.push_back(j);
-					}
-				}
-			}
-			if (!Mod::isEmptyRuleName(temp->getLookup()))
-			{
-				if (temp->getLookup() == rule->getName())
-				{
-					lookupOf.push_back(j);
-				}
-			}
-			for (auto& i : temp->getRequirements())
-			{
-				if (i == rule)
-				{
-					requiredByResearch.push_back(j);
-				}
-			}
-			for (auto& i : temp->getDependencies())
-			{
-				if (i == rule)
-				{
-					leadsTo.push_back(j);
-				}
-			}
-		}
+		};
+		names(links.unlockedBy, unlockedBy);
+		names(links.disabledBy, disabledBy);
+		names(links.reenabledBy, reenabledBy);
+		names(links.getOneFreeFrom, getForFreeFrom);
+		names(links.lookupOf, lookupOf);
+		names(links.requiredBy, requiredByResearch);
+		names(links.leadsTo, leadsTo);
 
 		// 1. item required
 		if (rule->needItem())
@@ -1631,36 +1534,11 @@ void TechTreeViewerState::initLists()
 		}
 
 		// 4. produced by
+		const DependencyGraph::ItemLinks &links = _game->getMod()->getDependencyGraph()->getItem(rule);
 		std::vector<std::string> producedBy;
-		for (auto& j : _game->getMod()->getManufactureList())
+		for (auto* i : links.producedBy)
 		{
-			RuleManufacture* temp = _game->getMod()->getManufacture(j);
-			bool found = false;
-			for (auto& i : temp->getProducedItems())
-			{
-				if (i.first == rule)
-				{
-					producedBy.push_back(j);
-					found = true;
-					break;
-				}
-			}
-			if (!found)
-			{
-				for (auto& itMap : temp->getRandomProducedItems())
-				{
-					for (auto& i : itMap.second)
-					{
-						if (i.first == rule)
-						{
-							producedBy.push_back(j);
-							found = true;
-							break;
-						}
-					}
-					if (found) break;
-				}
-			}
+			producedBy.push_back(i->getName());
 		}
 		if (producedBy.size() > 0)
 		{
@@ -1687,24 +1565,9 @@ void TechTreeViewerState::initLists()
 
 		// 5. spawned by
 		std::vector<std::string> spawnedBy;
-		for (auto& j : _game->getMod()->getResearchList())
+		for (auto* i : links.spawnedBy)
 		{
-			RuleResearch* temp = _game->getMod()->getResearch(j);
-			if (temp->getSpawnedItem() == rule->getType())
-			{
-				spawnedBy.push_back(j);
-			}
-			else
-			{
-				for (auto& sil : temp->getSpawnedItemList())
-				{
-					if (sil == rule->getType())
-					{
-						spawnedBy.push_back(j);
-						break;
-					}
-				}
-			}
+			spawnedBy.push_back(i->getName());
 		}
 		if (spawnedBy.size() > 0)
 		{
@@ -1800,14 +1663,10 @@ void TechTreeViewerState::initLists()
 
 		// 3. produced by
 		std::vector<std::string> producedBy;
-		for (auto& j : _game->getMod()->getManufactureList())
+		auto& producers = _game->getMod()->getDependencyGraph()->getCraft(rule).producedBy;
+		if (!producers.empty())
 		{
-			RuleManufacture* temp = _game->getMod()->getManufacture(j);
-			if (temp->getProducedCraft() == rule)
-			{
-				producedBy.push_back(j);
-				break;
-			}
+			producedBy.push_back(producers.front()->getName());
 		}
 		if (producedBy.size() > 0)
 		{
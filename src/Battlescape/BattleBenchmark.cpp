@@ -0,0 +1,324 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "BattleBenchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include "AIModule.h"
+#include "BattlescapeGame.h"
+#include "BattlescapeGenerator.h"
+#include "BattlescapeState.h"
+#include "Pathfinding.h"
+#include "TileEngine.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Game.h"
+#include "../Engine/Options.h"
+#include "../Engine/RNG.h"
+#include "../Menu/NewBattleState.h"
+#include "../Mod/AlienDeployment.h"
+#include "../Mod/Mod.h"
+#include "../Mod/RuleCraft.h"
+#include "../Mod/RuleGlobe.h"
+#include "../Savegame/AlienBase.h"
+#include "../Savegame/BattleUnit.h"
+#include "../Savegame/Craft.h"
+#include "../Savegame/MissionSite.h"
+#include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/SavedGame.h"
+#include "../Savegame/Tile.h"
+#include "../Savegame/Ufo.h"
+
+namespace OpenXcom
+{
+
+namespace BattleBenchmark
+{
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+double elapsedMs(Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * Picks the terrain New Battle would offer first for a mission.
+ */
+std::string defaultTerrain(const Mod *mod, const AlienDeployment *deployment)
+{
+	std::set<std::string> terrains;
+	std::vector<std::string> deployTerrains = deployment->getTerrains();
+	std::vector<std::string> globeTerrains = mod->getGlobe()->getTerrains(deployTerrains.empty() ? "" : deployment->getType());
+	terrains.insert(deployTerrains.begin(), deployTerrains.end());
+	terrains.insert(globeTerrains.begin(), globeTerrains.end());
+	if (terrains.empty())
+	{
+		throw Exception("Benchmark mission " + deployment->getType() + " has no terrain");
+	}
+	return *terrains.begin();
+}
+
+/**
+ * Picks the first craft New Battle would offer.
+ */
+std::string defaultCraft(const Mod *mod)
+{
+	for (auto& craftType : mod->getCraftsList())
+	{
+		if (mod->getCraft(craftType)->isForNewBattle())
+		{
+			return craftType;
+		}
+	}
+	throw Exception("Benchmark needs a craft available for new battles");
+}
+
+/**
+ * Carries out an AI decision without the animated states, so the next
+ * round decides on a changed battle. A walk puts the unit on the last
+ * tile of its path it can pay for; any other action only costs its time
+ * units, shots don't hit anything.
+ * @param bgame Battle.
+ * @param action Decision of the unit.
+ */
+void applyDecision(SavedBattleGame *bgame, BattleAction &action)
+{
+	BattleUnit *unit = action.actor;
+	if (action.type == BA_WALK)
+	{
+		Pathfinding *pf = bgame->getPathfinding();
+		pf->calculate(unit, action.target, action.getMoveType());
+		const std::vector<int> &path = pf->getPath();
+		Position pos = unit->getPosition();
+		for (auto i = path.rbegin(); i != path.rend(); ++i)
+		{
+			PathfindingStep r = pf->getTUCost(pos, *i, unit, 0, action.getMoveType());
+			if (r.cost.time == Pathfinding::INVALID_MOVE_COST || r.cost.time > unit->getTimeUnits() || r.cost.energy > unit->getEnergy())
+			{
+				break;
+			}
+			unit->spendTimeUnits(r.cost.time);
+			unit->spendEnergy(r.cost.energy);
+			pos = r.pos;
+		}
+		pf->abortPath();
+		if (pos != unit->getPosition())
+		{
+			unit->setTile(bgame->getTile(pos), bgame);
+			unit->setPosition(pos);
+			bgame->getTileEngine()->calculateFOV(unit);
+		}
+	}
+	else if (action.type != BA_NONE && action.type != BA_RETHINK)
+	{
+		action.updateTU();
+		action.spendTU();
+	}
+}
+
+} // namespace
+
+/**
+ * Generates a skirmish battle and measures it. The current savegame
+ * is replaced, so this only makes sense outside of a campaign.
+ * @param game Pointer to the core game.
+ * @param config Battle to generate.
+ * @return Phase timings.
+ */
+Report run(Game *game, const Config &config)
+{
+	const Mod *mod = game->getMod();
+	if (game->getSavedGame())
+	{
+		throw Exception("Benchmark can't run with a game in progress");
+	}
+
+	Report report;
+	report.mission = config.mission.empty() ? mod->getDeploymentsList().front() : config.mission;
+	AlienDeployment *deployment = mod->getDeployment(report.mission, true);
+	bool baseDefense = report.mission == "STR_BASE_DEFENSE";
+	report.terrain = config.terrain.empty() ? defaultTerrain(mod, deployment) : config.terrain;
+	report.alienRace = config.alienRace.empty() ? mod->getAlienRacesList().front() : config.alienRace;
+	report.craft = config.craft.empty() ? defaultCraft(mod) : config.craft;
+	RuleTerrain *terrain = mod->getTerrain(report.terrain, true);
+	mod->getAlienRace(report.alienRace, true);
+	const RuleCraft *craftRule = mod->getCraft(report.craft, true);
+	int alienTech = std::min(std::max(config.alienTech, 0), (int)mod->getAlienItemLevels().size() - 1);
+
+	RNG::setSeed(config.seed);
+
+	Craft *craft = 0;
+	SavedGame *save = NewBattleState::createSave(mod, craftRule, &craft);
+	game->setSavedGame(save);
+	save->setDifficulty((GameDifficulty)Clamp(config.difficulty, (int)DIFF_BEGINNER, (int)DIFF_SUPERHUMAN));
+
+	SavedBattleGame *bgame = new SavedBattleGame(game->getMod(), game->getLanguage());
+	save->setBattleGame(bgame);
+	bgame->setMissionType(report.mission);
+	BattlescapeGenerator bgen = BattlescapeGenerator(game);
+	bgen.setTerrain(terrain);
+
+	// same setup as NewBattleState::btnOkClick
+	if (baseDefense)
+	{
+		bgen.setBase(craft->getBase());
+		craft = 0;
+	}
+	else if (deployment->isAlienBase())
+	{
+		AlienBase *b = new AlienBase(deployment, -1);
+		b->setId(1);
+		b->setAlienRace(report.alienRace);
+		craft->setDestination(b);
+		bgen.setAlienBase(b);
+		save->getAlienBases()->push_back(b);
+	}
+	else if (mod->getUfo(report.mission))
+	{
+		Ufo *u = new Ufo(mod->getUfo(report.mission), 1);
+		u->setId(1);
+		craft->setDestination(u);
+		bgen.setUfo(u);
+		u->setStatus(config.ufoLanded ? Ufo::LANDED : Ufo::CRASHED);
+		bgame->setMissionType(config.ufoLanded ? "STR_UFO_GROUND_ASSAULT" : "STR_UFO_CRASH_RECOVERY");
+		save->getUfos()->push_back(u);
+	}
+	else
+	{
+		const RuleAlienMission *mission = mod->getAlienMission(mod->getAlienMissionList().front());
+		MissionSite *m = new MissionSite(mission, deployment, nullptr);
+		m->setId(1);
+		m->setAlienRace(report.alienRace);
+		craft->setDestination(m);
+		bgen.setMissionSite(m);
+		save->getMissionSites()->push_back(m);
+	}
+	if (craft)
+	{
+		craft->setSpeed(0);
+		bgen.setCraft(craft);
+	}
+	bgen.setWorldShade(config.darkness);
+	bgen.setAlienRace(report.alienRace);
+	bgen.setAlienItemlevel(alienTech);
+	bgame->setDepth(config.depth);
+
+	Clock::time_point start = Clock::now();
+	bgen.run();
+	report.generationMs = elapsedMs(start);
+
+	// the battle state sizes its surfaces for the battlescape
+	int baseX = Options::baseXResolution, baseY = Options::baseYResolution;
+	Options::baseXResolution = Options::baseXBattlescape;
+	Options::baseYResolution = Options::baseYBattlescape;
+	BattlescapeState *bs = new BattlescapeState;
+	Options::baseXResolution = baseX;
+	Options::baseYResolution = baseY;
+	bs->getBattleGame()->spawnFromPrimedItems();
+	bgame->setBattleState(bs);
+	bgame->startFirstTurn();
+
+	report.mapX = bgame->getMapSizeX();
+	report.mapY = bgame->getMapSizeY();
+	report.mapZ = bgame->getMapSizeZ();
+	std::vector<BattleUnit*> hostiles;
+	for (auto* unit : *bgame->getUnits())
+	{
+		if (unit->isOut())
+		{
+			continue;
+		}
+		if (unit->getFaction() == FACTION_PLAYER)
+		{
+			++report.playerUnits;
+		}
+		else if (unit->getFaction() == FACTION_HOSTILE)
+		{
+			hostiles.push_back(unit);
+		}
+	}
+	report.hostileUnits = (int)hostiles.size();
+
+	// the generator already did both once, these are the full passes a turn change or explosion costs
+	start = Clock::now();
+	bgame->getTileEngine()->recalculateFOV();
+	report.fovMs = elapsedMs(start);
+
+	start = Clock::now();
+	bgame->getTileEngine()->calculateLighting(LL_AMBIENT, TileEngine::invalid, 0, true);
+	report.lightingMs = elapsedMs(start);
+
+	start = Clock::now();
+	for (auto* unit : hostiles)
+	{
+		bgame->getPathfinding()->findReachable(unit, BattleActionCost());
+	}
+	report.pathfindingMs = elapsedMs(start);
+
+	// each round is an alien turn: decide (timed), carry the decisions out, end the turn
+	for (auto* unit : hostiles)
+	{
+		if (!unit->getAIModule())
+		{
+			unit->setAIModule(new AIModule(bgame, unit, 0));
+		}
+		report.units.push_back(UnitTiming{ unit->getId(), unit->getType(), 0, 0.0 });
+	}
+	for (int turn = 0; turn < config.turns; ++turn)
+	{
+		// the alien turn starts, which gives them their time units back
+		do
+		{
+			bgame->endTurn();
+		}
+		while (bgame->getSide() != FACTION_HOSTILE);
+		bgame->getTileEngine()->recalculateFOV();
+
+		for (size_t i = 0; i < hostiles.size(); ++i)
+		{
+			BattleUnit *unit = hostiles[i];
+			unit->setHiding(false);
+			BattleAction action;
+			action.actor = unit;
+			action.number = 1;
+			start = Clock::now();
+			unit->think(&action);
+			if (action.type == BA_RETHINK)
+			{
+				unit->think(&action);
+			}
+			double ms = elapsedMs(start);
+			report.units[i].decisions++;
+			report.units[i].ms += ms;
+			report.aiMs += ms;
+			applyDecision(bgame, action);
+		}
+	}
+
+	delete bs;
+	game->setSavedGame(0);
+	return report;
+}
+
+}
+
+}
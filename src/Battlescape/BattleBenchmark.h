@@ -0,0 +1,78 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+
+namespace OpenXcom
+{
+
+class Game;
+
+/**
+ * Repeatable battlescape workload for measuring performance.
+ * Builds a skirmish battle the same way New Battle does, then
+ * times the expensive parts of starting and playing it: map
+ * generation, a full FOV and lighting pass, reachability for
+ * every alien and the AI decisions of a number of alien turns.
+ * The decisions are carried out between turns without the
+ * animations (walks move the unit, shots only cost time units),
+ * so each turn decides on a different battle. The RNG is seeded
+ * first, so the same settings give the same battle and the same
+ * decisions on every run.
+ */
+namespace BattleBenchmark
+{
+	/// Battle to generate and how long to run the AI.
+	struct Config
+	{
+		std::string mission, terrain, craft, alienRace;
+		int seed = 1;
+		int turns = 3;
+		int difficulty = 0;
+		int darkness = 0;
+		int alienTech = 0;
+		int depth = 0;
+		bool ufoLanded = true;
+	};
+
+	/// AI cost of a single unit over all rounds.
+	struct UnitTiming
+	{
+		int id;
+		std::string type;
+		int decisions;
+		double ms;
+	};
+
+	/// Wall times of each phase, in milliseconds.
+	struct Report
+	{
+		std::string mission, terrain, alienRace, craft;
+		int mapX = 0, mapY = 0, mapZ = 0;
+		int playerUnits = 0, hostileUnits = 0;
+		double generationMs = 0, fovMs = 0, lightingMs = 0, pathfindingMs = 0, aiMs = 0;
+		std::vector<UnitTiming> units;
+	};
+
+	/// Generates the battle, runs the measured phases and discards the battle again.
+	Report run(Game *game, const Config &config);
+}
+
+}
@@ -0,0 +1,233 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "BattlePool.h"
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace OpenXcom
+{
+
+namespace BattlePool
+{
+
+namespace
+{
+
+/// Block sizes are rounded up to this, which also keeps blocks aligned like operator new.
+const size_t Granularity = 16;
+const size_t ChunkSize = 64 * 1024;
+
+struct FreeBlock
+{
+	FreeBlock *next;
+};
+
+/// Blocks of one size: recycled ones first, then the rest of the current chunk.
+struct SizeClass
+{
+	FreeBlock *free = nullptr;
+	char *next = nullptr;
+	char *end = nullptr;
+};
+
+std::mutex poolMutex;
+std::vector<SizeClass> classes;
+std::vector<void*> chunks;
+size_t chunkBytes = 0, freeBytes = 0;
+int liveTotal = 0;
+bool battleOver = false;
+KindStats kinds[POOL_KINDS] =
+{
+	{ "units", 0, 0, 0, 0 },
+	{ "items", 0, 0, 0, 0 },
+	{ "states", 0, 0, 0, 0 },
+	{ "explosions", 0, 0, 0, 0 },
+	{ "projectiles", 0, 0, 0, 0 },
+};
+
+void releaseChunks()
+{
+	for (void *chunk : chunks)
+	{
+		::operator delete(chunk);
+	}
+	chunks.clear();
+	classes.clear();
+	chunkBytes = 0;
+	freeBytes = 0;
+}
+
+}
+
+/**
+ * Gets a block for a new object, recycling a freed one of the same
+ * size when possible.
+ * @param size Object size in bytes.
+ * @param kind Object type, for the counters.
+ * @return Block of at least that size.
+ */
+void *allocate(size_t size, Kind kind)
+{
+	std::lock_guard<std::mutex> lock(poolMutex);
+	kinds[kind].turnAllocs++;
+	kinds[kind].totalAllocs++;
+	kinds[kind].live++;
+	liveTotal++;
+	battleOver = false;
+	if (size > MaxPooled)
+	{
+		return ::operator new(size);
+	}
+
+	size_t index = (std::max(size, sizeof(FreeBlock)) + Granularity - 1) / Granularity;
+	size_t block = index * Granularity;
+	if (index >= classes.size())
+	{
+		classes.resize(index + 1);
+	}
+	SizeClass &sizeClass = classes[index];
+	if (sizeClass.free)
+	{
+		FreeBlock *p = sizeClass.free;
+		sizeClass.free = p->next;
+		freeBytes -= block;
+		return p;
+	}
+	if (sizeClass.next == nullptr || (size_t)(sizeClass.end - sizeClass.next) < block)
+	{
+		size_t bytes = std::max(ChunkSize, block * 8);
+		char *chunk = static_cast<char*>(::operator new(bytes));
+		chunks.push_back(chunk);
+		chunkBytes += bytes;
+		sizeClass.next = chunk;
+		sizeClass.end = chunk + bytes;
+	}
+	void *p = sizeClass.next;
+	sizeClass.next += block;
+	return p;
+}
+
+/**
+ * Puts the block of a deleted object on its free list. If the battle
+ * already ended and this was the last object, all chunks go.
+ * @param p Block to give back.
+ * @param size Object size in bytes, the same as when allocated.
+ * @param kind Object type, for the counters.
+ */
+void deallocate(void *p, size_t size, Kind kind)
+{
+	if (!p)
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> lock(poolMutex);
+	kinds[kind].live--;
+	liveTotal--;
+	if (size > MaxPooled)
+	{
+		::operator delete(p);
+	}
+	else
+	{
+		size_t index = (std::max(size, sizeof(FreeBlock)) + Granularity - 1) / Granularity;
+		FreeBlock *block = static_cast<FreeBlock*>(p);
+		block->next = classes[index].free;
+		classes[index].free = block;
+		freeBytes += index * Granularity;
+	}
+	if (battleOver && liveTotal == 0)
+	{
+		releaseChunks();
+	}
+}
+
+/**
+ * Counts objects destroyed in place as gone without touching their
+ * blocks. Those stay taken until the chunks are released, which
+ * happens once the battle ended and no pooled object is left.
+ * @param count Number of objects destroyed.
+ * @param kind Object type, for the counters.
+ */
+void discard(size_t count, Kind kind)
+{
+	if (count == 0)
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> lock(poolMutex);
+	kinds[kind].live -= (int)count;
+	liveTotal -= (int)count;
+	if (battleOver && liveTotal == 0)
+	{
+		releaseChunks();
+	}
+}
+
+/**
+ * Moves the allocation counts of this turn to the last turn ones.
+ */
+void newTurn()
+{
+	std::lock_guard<std::mutex> lock(poolMutex);
+	for (auto& k : kinds)
+	{
+		k.lastTurnAllocs = k.turnAllocs;
+		k.turnAllocs = 0;
+	}
+}
+
+/**
+ * Marks the battle as over. The chunks are released right away if
+ * nothing pooled is left, otherwise when the last object is deleted,
+ * unless something new gets allocated first.
+ */
+void endBattle()
+{
+	std::lock_guard<std::mutex> lock(poolMutex);
+	battleOver = true;
+	for (auto& k : kinds)
+	{
+		k.turnAllocs = 0;
+		k.lastTurnAllocs = 0;
+	}
+	if (liveTotal == 0)
+	{
+		releaseChunks();
+	}
+}
+
+/**
+ * Gets a snapshot of the counters.
+ * @return Allocation counts and memory held.
+ */
+Stats getStats()
+{
+	std::lock_guard<std::mutex> lock(poolMutex);
+	Stats stats;
+	std::copy(std::begin(kinds), std::end(kinds), std::begin(stats.kinds));
+	stats.chunkBytes = chunkBytes;
+	stats.freeBytes = freeBytes;
+	return stats;
+}
+
+}
+
+}
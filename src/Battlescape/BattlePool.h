@@ -0,0 +1,108 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <vector>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Memory for the objects a battle creates and destroys all the time:
+ * units, items, battle states, explosions and projectiles. Blocks are
+ * carved out of big chunks and recycled through a free list per block
+ * size, so a long battle doesn't fragment the heap. During a battle
+ * objects are deleted one by one and their blocks recycled. When the
+ * battle is torn down, destroyAll() only runs the destructors and the
+ * blocks go with their chunks, all at once, when the last pooled object
+ * is gone. The classes opt in with BATTLE_POOL_ALLOCATED.
+ */
+namespace BattlePool
+{
+	/// Bigger objects come straight from the heap.
+	const size_t MaxPooled = 16 * 1024;
+
+	/// Pooled object types, for the allocation counters.
+	enum Kind { POOL_UNITS, POOL_ITEMS, POOL_STATES, POOL_EXPLOSIONS, POOL_PROJECTILES, POOL_KINDS };
+
+	/// Counters of one object type.
+	struct KindStats
+	{
+		const char *name;
+		Uint64 turnAllocs, lastTurnAllocs, totalAllocs;
+		int live;
+	};
+
+	/// Counters of all types and the memory held.
+	struct Stats
+	{
+		KindStats kinds[POOL_KINDS];
+		size_t chunkBytes, freeBytes;
+	};
+
+	/// Gets a block for a new object.
+	void *allocate(size_t size, Kind kind);
+	/// Gives back the block of a deleted object.
+	void deallocate(void *p, size_t size, Kind kind);
+	/// Forgets objects destroyed in place, their blocks go with the chunks.
+	void discard(size_t count, Kind kind);
+	/// Starts counting allocations for a new turn.
+	void newTurn();
+	/// Releases all chunks once the last object is gone.
+	void endBattle();
+	/// Gets a copy of the counters.
+	Stats getStats();
+
+	/**
+	 * Destroys pooled objects of a battle that is being torn down. Only
+	 * the destructors run, the blocks are not put back on the free
+	 * lists: endBattle() releases them together with their chunks.
+	 * @param objects Objects to destroy, cleared afterwards.
+	 * @param kind Object type, for the counters.
+	 */
+	template<typename T>
+	void destroyAll(std::vector<T*> &objects, Kind kind)
+	{
+		size_t count = 0;
+		for (T *p : objects)
+		{
+			if (!p)
+			{
+				continue;
+			}
+			if (sizeof(T) > MaxPooled)
+			{
+				delete p;
+				continue;
+			}
+			p->~T();
+			count++;
+		}
+		objects.clear();
+		discard(count, kind);
+	}
+}
+
+}
+
+/// Routes new/delete of a class through the battle pool.
+#define BATTLE_POOL_ALLOCATED(kind) \
+	static void *operator new(size_t size) { return ::OpenXcom::BattlePool::allocate(size, ::OpenXcom::BattlePool::kind); } \
+	static void operator delete(void *p, size_t size) { ::OpenXcom::BattlePool::deallocate(p, size, ::OpenXcom::BattlePool::kind); }
@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "BattlescapeGame.h"
+#include "BattlePool.h"
 
 namespace OpenXcom
 {
@@ -32,6 +33,8 @@ protected:
 	BattlescapeGame *_parent;
 	BattleAction _action;
 public:
+	BATTLE_POOL_ALLOCATED(POOL_STATES)
+
 	/// Creates a new BattleState linked to the game.
 	BattleState(BattlescapeGame *parent, BattleAction action);
 	/// Creates a new BattleState linked to the game.
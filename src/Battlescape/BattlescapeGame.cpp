@@ -61,6 +61,7 @@
 #include <sstream>
 
 #include "../CoopMod/connectionTCP.h"
+#include "../CoopMod/CoopMessages.h"
 
 namespace OpenXcom
 {
@@ -287,7 +288,32 @@ void BattlescapeGame::movePlayerTarget(std::string obj_str)
 		getMap()->getCamera()->centerOnPosition(_currentAction.actor->getPosition());
 	}
 
-	_save->getPathfinding()->calculate(_currentAction.actor, _currentAction.target, _currentAction.getMoveType());
+	// walk the peer's own path if it sent one, only older versions leave it to us
+	const Json::Value &path = obj["path"];
+	bool walk = path.isArray() && !path.empty();
+	if (!walk && obj["interrupted"].asBool())
+	{
+		// the first step was already out of reach there, so the unit doesn't move;
+		// its abortPath brings the final time units and energy
+		return;
+	}
+	if (walk)
+	{
+		std::vector<PathfindingStep> steps(path.size());
+		std::vector<int> directions(path.size());
+		for (Json::ArrayIndex i = 0; i < path.size(); ++i)
+		{
+			const Json::Value &step = path[i];
+			directions[i] = step["dir"].asInt();
+			steps[i].cost = { step["tu"].asInt(), step["energy"].asInt() };
+			steps[i].pos = Position(step["x"].asInt(), step["y"].asInt(), step["z"].asInt());
+		}
+		_save->getPathfinding()->setCoopPath(_currentAction.actor, steps, directions, obj["strafeMove"].asBool());
+	}
+	else
+	{
+		_save->getPathfinding()->calculate(_currentAction.actor, _currentAction.target, _currentAction.getMoveType());
+	}
 
 	statePushBack(new UnitWalkBState(this, _currentAction));
 
@@ -983,20 +1009,19 @@ int BattlescapeGame::think()
 	if (getCoopMod()->getCoopStatic() == true && getCoopMod()->_isActivePlayerSync == true && getCoopMod()->_isActiveAISync == true)
 	{
 
-		Json::Value root;
-		root["state"] = "update_progress";
-		root["ret"] = ret;
+		AIProgress progress;
+		progress.ret = ret;
 
-		root["selected_unit_id"] = -1;
+		progress.selectedUnitId = -1;
 
 		if (_save->getSelectedUnit())
 		{
-			root["selected_unit_id"] = _save->getSelectedUnit()->getId();
+			progress.selectedUnitId = _save->getSelectedUnit()->getId();
 		}
 
-		root["AISecondMove"] = _AISecondMove;
+		progress.secondMove = _AISecondMove;
 
-		getCoopMod()->sendTCPPacketData(root.toStyledString());
+		CoopJson::send(progress);
 	}
 
 	// coop
@@ -18,7 +18,6 @@
  */
 #include "BattlescapeGenerator.h"
 #include "../Engine/Exception.h"
-#include "../Engine/FileMap.h"
 #include "../Engine/Game.h"
 #include "../Engine/Logger.h"
 #include "../Engine/Options.h"
@@ -2238,18 +2237,19 @@ int BattlescapeGenerator::loadMAP(MapBlock* mapblock, int xoff, int yoff, int zo
 {
 	int sizex, sizey, sizez;
 	int x = xoff, y = yoff, z = zoff;
-	char size[3];
-	unsigned char value[4];
 	std::string filename = "MAPS/" + mapblock->getName() + ".MAP";
 	unsigned int terrainObjectID;
 
-	// Load file
-	auto mapFile = FileMap::getIStream(filename);
+	// Load file, blocks keep it in memory after the first use
+	const auto& mapFile = mapblock->getMapFile();
+	if (mapFile.size() < 3)
+	{
+		throw Exception("Invalid MAP file: " + filename);
+	}
 
-	mapFile->read((char*)&size, sizeof(size));
-	sizey = (int)size[0];
-	sizex = (int)size[1];
-	sizez = (int)size[2];
+	sizey = (int)(char)mapFile[0];
+	sizex = (int)(char)mapFile[1];
+	sizez = (int)(char)mapFile[2];
 
 	mapblock->setSizeZ(sizez);
 
@@ -2299,8 +2299,10 @@ int BattlescapeGenerator::loadMAP(MapBlock* mapblock, int xoff, int yoff, int zo
 		throw Exception("Something is wrong in your map definitions, craft/ufo map is too tall?");
 	}
 
-	while (mapFile->read((char*)&value, sizeof(value)))
+	// an incomplete record at the end is ignored, like a short read would
+	for (size_t offset = 3; offset + 4 <= mapFile.size(); offset += 4)
 	{
+		const unsigned char *value = &mapFile[offset];
 		for (int part = O_FLOOR; part < O_MAX; ++part)
 		{
 			terrainObjectID = ((unsigned char)value[part]);
@@ -2334,11 +2336,6 @@ int BattlescapeGenerator::loadMAP(MapBlock* mapblock, int xoff, int yoff, int zo
 		}
 	}
 
-	if (!mapFile->eof())
-	{
-		throw Exception("Invalid MAP file: " + filename);
-	}
-
 	// Add the craft offset to the positions of the items if we're loading a craft map
 	// But don't do so if loading a verticalLevel, since the z offset of the craft is handled by that code
 	if (craft && zoff == 0)
@@ -2510,16 +2507,16 @@ int BattlescapeGenerator::loadMAP(MapBlock* mapblock, int xoff, int yoff, int zo
  */
 void BattlescapeGenerator::loadRMP(MapBlock* mapblock, int xoff, int yoff, int zoff, int segment)
 {
-	unsigned char value[24];
 	std::string filename = "ROUTES/" + mapblock->getName() + ".RMP";
-	// Load file
-	auto mapFile = FileMap::getIStream(filename);
+	// Load file, blocks keep it in memory after the first use
+	const auto& routeFile = mapblock->getRouteFile();
 
 	size_t nodeOffset = _save->getNodes()->size();
 	std::vector<int> badNodes;
 	int nodesAdded = 0;
-	while (mapFile->read((char*)&value, sizeof(value)))
+	for (size_t offset = 0; offset + 24 <= routeFile.size(); offset += 24)
 	{
+		const unsigned char *value = &routeFile[offset];
 		int pos_x = value[1];
 		int pos_y = value[0];
 		int pos_z = value[2];
@@ -2586,11 +2583,6 @@ void BattlescapeGenerator::loadRMP(MapBlock* mapblock, int xoff, int yoff, int z
 			nodeCounter--;
 		}
 	}
-
-	if (!mapFile->eof())
-	{
-		throw Exception("Invalid RMP file: " + filename);
-	}
 }
 
 /**
@@ -41,6 +41,7 @@
 #include "DebriefingState.h"
 #include "MiniMapState.h"
 #include "BattlescapeGenerator.h"
+#include "BattlePool.h"
 #include "BriefingState.h"
 #include "ExtendedBattlescapeLinksState.h"
 #include "../lodepng.h"
@@ -1219,6 +1220,9 @@ void BattlescapeState::think()
 {
 	static bool popped = false;
 
+	// autosaves are written in the background, their errors show up here
+	SaveGameState::asyncErrors(OPT_BATTLESCAPE, _palette);
+
 	if (_gameTimer->isRunning())
 	{
 		if (_popups.empty())
@@ -4695,7 +4699,7 @@ void BattlescapeState::moveCoopInventory(std::string ammos_str, std::string item
 	{
 
 		_game->getCoopMod()->_selectedItemID = currentItem->getId();
-		_game->getCoopMod()->_selectedItemType = currentItem->getRules()->getType();
+		_game->getCoopMod()->_selectedItemRuleId = currentItem->getRules()->getRuleId();
 
 		if (unit && tu == true)
 		{
@@ -5200,6 +5204,18 @@ inline void BattlescapeState::handle(Action *action)
 						debug("Resetting tile visibility");
 						_save->resetTiles();
 					}
+					// "ctrl-o" - battle pool allocations of the last turn
+					else if (_save->getDebugMode() && key == SDLK_o && ctrlPressed)
+					{
+						BattlePool::Stats pool = BattlePool::getStats();
+						std::ostringstream ss;
+						ss << "Pool " << pool.chunkBytes / 1024 << "K, " << pool.freeBytes / 1024 << "K free, last turn";
+						for (const auto& k : pool.kinds)
+						{
+							ss << " " << k.name[0] << k.lastTurnAllocs;
+						}
+						debug(ss.str());
+					}
 					else if (_save->getDebugMode() && (key == SDLK_k || key == SDLK_j) && ctrlPressed)
 					{
 						bool stunOnly = (key == SDLK_j);
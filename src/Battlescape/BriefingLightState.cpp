@@ -119,7 +119,7 @@ void BriefingLightState::checkStartingCondition(AlienDeployment *deployment)
 
 			for (auto& armorType : list)
 			{
-				Armor* armor = _game->getMod()->getArmor(armorType, false);
+				Armor* armor = _game->getMod()->getArmorById(_game->getMod()->getRuleId(armorType));
 				ArticleDefinition* article = _game->getMod()->getUfopaediaArticle(armor ? armor->getUfopediaType() : armorType, false);
 				if (article && Ufopaedia::isArticleAvailable(_game->getSavedGame(), article))
 				{
@@ -191,7 +191,7 @@ void BriefingLightState::lstArmorsClick(Action* action)
 
 	auto idx = halfSize + _lstArmors->getSelectedRow();
 	const std::string& armorType = _armorNameList[idx].first;
-	Armor* armor = _game->getMod()->getArmor(armorType, false);
+	Armor* armor = _game->getMod()->getArmorById(_game->getMod()->getRuleId(armorType));
 	if (armor)
 	{
 		std::string articleId = armor->getUfopediaType();
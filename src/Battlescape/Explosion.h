@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Position.h"
+#include "BattlePool.h"
 
 namespace OpenXcom
 {
@@ -34,6 +35,8 @@ private:
 	bool _big, _hit;
 	int _frames;
 public:
+	BATTLE_POOL_ALLOCATED(POOL_EXPLOSIONS)
+
 	static const int HIT_FRAMES;
 	static const int EXPLODE_FRAMES;
 	static const int BULLET_FRAMES;
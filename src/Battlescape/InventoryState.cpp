@@ -1122,7 +1122,7 @@ bool InventoryState::tryArmorChange(const std::string& armorName)
 
 	Armor* next = nullptr;
 	{
-		next = _game->getMod()->getArmor(armorName, false);
+		next = _game->getMod()->getArmorById(_game->getMod()->getRuleId(armorName));
 	}
 
 	// check armor availability
@@ -2633,10 +2633,10 @@ void InventoryState::think()
 	}
 
 	// coop
-	if (_game->getCoopMod()->getCoopStatic() == true && _game->getCoopMod()->_selectedItemID != -1 && _game->getCoopMod()->_selectedItemType != "" && _inv && _inv->getSelectedItem())
+	if (_game->getCoopMod()->getCoopStatic() == true && _game->getCoopMod()->_selectedItemID != -1 && _game->getCoopMod()->_selectedItemRuleId != -1 && _inv && _inv->getSelectedItem())
 	{
 
-		if (_inv->getSelectedItem()->getId() == _game->getCoopMod()->_selectedItemID && _inv->getSelectedItem()->getRules()->getType() == _game->getCoopMod()->_selectedItemType)
+		if (_inv->getSelectedItem()->getId() == _game->getCoopMod()->_selectedItemID && _inv->getSelectedItem()->getRules()->getRuleId() == _game->getCoopMod()->_selectedItemRuleId)
 		{
 
 			_inv->setSelectedItem(0);
@@ -2644,7 +2644,7 @@ void InventoryState::think()
 		}
 
 		_game->getCoopMod()->_selectedItemID = -1;
-		_game->getCoopMod()->_selectedItemType = "";
+		_game->getCoopMod()->_selectedItemRuleId = -1;
 
 	}
 
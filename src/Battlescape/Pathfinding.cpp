@@ -26,6 +26,7 @@
 #include "../Mod/Mod.h"
 #include "../Savegame/BattleUnit.h"
 #include "../Engine/Options.h"
+#include "../Engine/Profiler.h"
 #include "../fmath.h"
 #include "BattlescapeGame.h"
 
@@ -85,6 +86,7 @@ void Pathfinding::calculate(BattleUnit *unit, Position endPosition, BattleAction
 {
 	_totalTUCost = {};
 	_path.clear();
+	_coopSteps.clear();
 
 	const int size = bam != BAM_MISSILE ? unit->getArmor()->getSize() : 1;
 
@@ -187,6 +189,7 @@ void Pathfinding::calculate(BattleUnit *unit, Position endPosition, BattleAction
  */
 bool Pathfinding::aStarPath(Position startPosition, Position endPosition, BattleActionMove bam, const BattleUnit *missileTarget, bool sneak, int maxTUCost)
 {
+	PROFILE_ZONE("Pathfinding::aStarPath");
 	// reset every node, so we have to check them all
 	for (auto& pn : _nodes)
 	{
@@ -778,6 +781,10 @@ int Pathfinding::dequeuePath()
 	if (_path.empty()) return -1;
 	int last_element = _path.back();
 	_path.pop_back();
+	if (!_coopSteps.empty())
+	{
+		_coopSteps.pop_back();
+	}
 	return last_element;
 }
 
@@ -792,6 +799,7 @@ void Pathfinding::abortPath()
 	{
 		_totalTUCost = {};
 		_path.clear();
+		_coopSteps.clear();
 	}
 
 }
@@ -800,6 +808,39 @@ void Pathfinding::abortPathCoop()
 {
 	_totalTUCost = {};
 	_path.clear();
+	_coopSteps.clear();
+}
+
+/**
+ * Takes over the path the peer calculated for one of its units, so
+ * it is walked step by step without searching for it again here.
+ * @param unit Unit taking the path.
+ * @param steps Cost and end tile of each step, first step first.
+ * @param directions Direction of each step, first step first.
+ * @param strafeMove Is the unit strafing?
+ */
+void Pathfinding::setCoopPath(BattleUnit *unit, const std::vector<PathfindingStep> &steps, const std::vector<int> &directions, bool strafeMove)
+{
+	_unit = unit;
+	_strafeMove = strafeMove;
+	_totalTUCost = {};
+	for (const auto &step : steps)
+	{
+		_totalTUCost = _totalTUCost + step.cost;
+	}
+	_path.assign(directions.rbegin(), directions.rend()); //paths are stored in reverse order
+	_coopSteps.assign(steps.rbegin(), steps.rend());
+}
+
+/**
+ * Gets the cost and end tile of the next step, as the peer worked
+ * them out, so the step isn't costed again here.
+ * @return The next step, or null if the path was calculated here.
+ */
+const PathfindingStep *Pathfinding::getCoopStep() const
+{
+	if (_coopSteps.empty() || _coopSteps.size() != _path.size()) return nullptr;
+	return &_coopSteps.back();
 }
 
 /**
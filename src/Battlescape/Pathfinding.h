@@ -72,6 +72,8 @@ private:
 	/// Determines whether a unit can fall down from this tile.
 	bool canFallDown(const Tile *destinationTile, int size) const;
 	std::vector<int> _path;
+	/// Costs and end tiles of the path's steps when they came from the peer, in the same order.
+	std::vector<PathfindingStep> _coopSteps;
 public:
 	/// Determines whether the unit is going up a stairs.
 	bool isOnStairs(Position startPosition, Position endPosition) const;
@@ -252,6 +254,10 @@ public:
 	/// Aborts the current path.
 	void abortPath();
 	void abortPathCoop();
+	/// Takes over a path someone else calculated, with its step costs.
+	void setCoopPath(BattleUnit *unit, const std::vector<PathfindingStep> &steps, const std::vector<int> &directions, bool strafeMove);
+	/// Gets the cost of the next step of a path set by setCoopPath, if any.
+	const PathfindingStep *getCoopStep() const;
 	/// Gets the strafe move setting.
 	bool getStrafeMove() const;
 	/// Checks, for the up/down button, if the movement is valid.
@@ -20,6 +20,7 @@
 #include <vector>
 #include "Position.h"
 #include "BattlescapeGame.h"
+#include "BattlePool.h"
 
 namespace OpenXcom
 {
@@ -37,6 +38,8 @@ class Mod;
 class Projectile
 {
 public:
+	BATTLE_POOL_ALLOCATED(POOL_PROJECTILES)
+
 	/// Offset of voxel path where item should be drop.
 	static const int ItemDropVoxelOffset = -2;
 
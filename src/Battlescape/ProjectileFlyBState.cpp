@@ -39,6 +39,7 @@
 #include "BattlescapeState.h"
 #include "../Savegame/BattleUnitStatistics.h"
 #include "../fmath.h"
+#include "../CoopMod/CoopMessages.h"
 
 namespace OpenXcom
 {
@@ -536,71 +537,47 @@ void ProjectileFlyBState::init()
 	if (_parent->isCoop() == true && _parent->getCoopMod()->_isActivePlayerSync == true && _action.autoShotCounter <= 1)
 	{
 
-		Json::Value obj;
-
-		obj["state"] = "ProjectileFlyBState";
-		obj["actor_id"] = _action.actor->getId();
-		obj["actor_tu"] = _action.actor->coop_tu;
-		obj["actor_energy"] = _action.actor->coop_energy;
-		obj["actor_morale"] = _action.actor->coop_morale;
-		obj["actor_health"] = _action.actor->coop_health;
-		obj["actor_mana"] = _action.actor->coop_mana;
-		obj["actor_stun"] = _action.actor->coop_stun;
-		obj["actor_no_line_fire"] = _action.actor->coop_no_line_fire;
-		obj["actor_unable_to_throw_here"] = _action.actor->coop_unable_to_throw_here;
-		obj["type"] = (int)_action.type;
-		obj["hand"] = _parent->getCoopWeaponHand();
-		obj["fusetimer"] = _action.weapon->getFuseTimer();
-		obj["fuse"] = _action.weapon->isFuseEnabled();
-		obj["coords"]["target"]["x"] = _action.target.x;
-		obj["coords"]["target"]["y"] = _action.target.y;
-		obj["coords"]["target"]["z"] = _action.target.z;
-		obj["coords"]["start"]["x"] = _action.actor->getPosition().x;
-		obj["coords"]["start"]["y"] = _action.actor->getPosition().y;
-		obj["coords"]["start"]["z"] = _action.actor->getPosition().z;
-		obj["targeting"] = _action.targeting;
+		std::string hand = _parent->getCoopWeaponHand();
+
+		ProjectileFly fly;
+		fly.actorId = _action.actor->getId();
+		fly.actorTu = _action.actor->coop_tu;
+		fly.actorEnergy = _action.actor->coop_energy;
+		fly.actorMorale = _action.actor->coop_morale;
+		fly.actorHealth = _action.actor->coop_health;
+		fly.actorMana = _action.actor->coop_mana;
+		fly.actorStun = _action.actor->coop_stun;
+		fly.actorNoLineFire = _action.actor->coop_no_line_fire;
+		fly.actorUnableToThrowHere = _action.actor->coop_unable_to_throw_here;
+		fly.type = (int)_action.type;
+		fly.hand = hand;
+		fly.fuseTimer = _action.weapon->getFuseTimer();
+		fly.fuse = _action.weapon->isFuseEnabled();
+		fly.coords.target = _action.target;
+		fly.coords.start = _action.actor->getPosition();
+		fly.targeting = _action.targeting;
 		// fix!
-		obj["weapon_type"] = _action.weapon->getRules()->getType();
+		fly.weaponType = _action.weapon->getRules()->getType();
 
-		obj["projectiles"] = _parent->getCoopMod()->_coopProjectilesClient;
+		fly.projectiles = &_parent->getCoopMod()->_coopProjectilesClient;
 
-		obj["ammo_type"] = "";
-		obj["ammo_id"] = -1;
+		fly.ammoType = "";
+		fly.ammoId = -1;
 
 		if (_ammo)
 		{
 
-			obj["ammo_type"] = _ammo->getRules()->getType();
-			obj["ammo_id"] = _ammo->getId();
+			fly.ammoType = _ammo->getRules()->getType();
+			fly.ammoId = _ammo->getId();
 
 		}
 
-		int pos_index = 0;
-		for (Position pos : _action.waypoints)
-		{
-
-			obj["waypoints"][pos_index]["pos_x"] = pos.x;
-			obj["waypoints"][pos_index]["pos_y"] = pos.y;
-			obj["waypoints"][pos_index]["pos_z"] = pos.z;
-			
-			pos_index++;
-		}
-
-		int trajectory_index = 0;
-		for (Position &trajectory_pos : _parent->getCoopMod()->_trajectoryCoop)
-		{
-
-			obj["trajectory"][trajectory_index]["pos_x"] = trajectory_pos.x;
-			obj["trajectory"][trajectory_index]["pos_y"] = trajectory_pos.y;
-			obj["trajectory"][trajectory_index]["pos_z"] = trajectory_pos.z;
+		fly.waypoints = &_action.waypoints;
+		fly.trajectory = &_parent->getCoopMod()->_trajectoryCoop;
 
-			trajectory_index++;
-
-		}
+		CoopJson::send(fly);
 
 		_parent->getCoopMod()->_trajectoryCoop.clear();
-
-		_parent->getCoopMod()->sendTCPPacketData(obj.toStyledString());
 	}
 
 }
@@ -819,10 +796,7 @@ void ProjectileFlyBState::deinit()
 	if (_parent->getCoopMod()->getCoopStatic() == true && _parent->getCoopMod()->getHost() == true)
 	{
 
-		Json::Value obj;
-		obj["state"] = "hasHitUnit";
-
-		_parent->getCoopMod()->sendTCPPacketData(obj.toStyledString());
+		CoopJson::send(ProjectileLanded{});
 	}
 
 }
@@ -860,10 +834,7 @@ void ProjectileFlyBState::think()
 			if (_parent->getCoopMod()->getCoopStatic() == true && _parent->getCoopMod()->getHost() == true)
 			{
 
-				Json::Value obj;
-				obj["state"] = "hasHitUnit";
-
-				_parent->getCoopMod()->sendTCPPacketData(obj.toStyledString());
+				CoopJson::send(ProjectileLanded{});
 
 			}
 
@@ -40,9 +40,11 @@
 #include "../Mod/RuleSkill.h"
 #include "Pathfinding.h"
 #include "../Engine/Options.h"
+#include "../Engine/Profiler.h"
 #include "ProjectileFlyBState.h"
 #include "MeleeAttackBState.h"
 #include "../fmath.h"
+#include "../CoopMod/CoopMessages.h"
 
 namespace OpenXcom
 {
@@ -1123,6 +1125,7 @@ void TileEngine::calculateUnitLighting(MapSubset gs)
 
 void TileEngine::calculateLighting(LightLayers layer, Position position, int eventRadius, bool terrianChanged)
 {
+	PROFILE_ZONE("TileEngine::calculateLighting");
 	const auto gsMap = MapSubset{ _save->getMapSizeX(), _save->getMapSizeY() };
 	auto gsDynamic = gsMap;
 	auto gsStatic = gsDynamic;
@@ -1702,6 +1705,7 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 */
 bool TileEngine::calculateFOV(BattleUnit *unit, bool doTileRecalc, bool doUnitRecalc)
 {
+	PROFILE_ZONE("TileEngine::calculateFOV(unit)");
 	//Force a full FOV recheck for this unit.
 	if (doTileRecalc) calculateTilesInFOV(unit);
 	return doUnitRecalc ? calculateUnitsInFOV(unit) : false;
@@ -2500,6 +2504,7 @@ bool TileEngine::canTargetTile(Position *originVoxel, Tile *tile, int part, Posi
  */
 void TileEngine::calculateFOV(Position position, int eventRadius, const bool updateTiles, const bool appendToTileVisibility)
 {
+	PROFILE_ZONE("TileEngine::calculateFOV(position)");
 	int updateRadius;
 	if (eventRadius == -1)
 	{
@@ -3315,21 +3320,17 @@ bool TileEngine::hitUnit(BattleActionAttack attack, BattleUnit *target, const Po
 		if (_save->getBattleGame()->getCoopMod()->getCoopStatic() == true && _save->getBattleGame()->getCoopMod()->getHost() == true)
 		{
 
-			Json::Value root;
-			root["state"] = "hit_unit";
-			root["unit_id"] = target->getId();
-			root["health"] = target->getHealth();
-			root["stunlevel"] = target->getStunlevel();
+			UnitHit hit;
+			hit.unitId = target->getId();
+			hit.health = target->getHealth();
+			hit.stunlevel = target->getStunlevel();
 
-			Json::Value fatalArray(Json::arrayValue);
 			for (int i = 0; i < BODYPART_MAX; ++i)
 			{
-				fatalArray.append(target->getFatalWoundsCoop()[i]);
+				hit.fatalWounds[i] = target->getFatalWoundsCoop()[i];
 			}
 
-			root["fatalWounds"] = fatalArray;
-
-			_save->getBattleGame()->getCoopMod()->sendTCPPacketData(root.toStyledString());
+			CoopJson::send(hit);
 		}
 	}
 
@@ -3484,59 +3485,22 @@ void TileEngine::hit(BattleActionAttack attack, Position center, int power, cons
 
 			_save->getBattleGame()->getCoopMod()->_smokeRNGs.push_back(_smokeRNG);
 
-			Json::Value root;
-			root["state"] = "hit_tile";
-
-			root["center_x"] = center.x;
-			root["center_y"] = center.y;
-			root["center_z"] = center.z;
+			TileHit hit;
+			hit.center = center;
 
-			root["power"] = power;
-			root["rangeAtack"] = rangeAtack;
-			root["terrainMeleeTilePart"] = terrainMeleeTilePart;
+			hit.power = power;
+			hit.rangeAtack = rangeAtack;
+			hit.terrainMeleeTilePart = terrainMeleeTilePart;
 
-			root["seed"] = seed;
-			root["smokeRNG"] = _smokeRNG;
+			hit.seed = seed;
+			hit.smokeRNG = _smokeRNG;
 
 			// new!!!
-			root["ArmorEffectiveness"] = type->ArmorEffectiveness;
-			root["FireBlastCalc"] = type->FireBlastCalc;
-			root["FireThreshold"] = type->FireThreshold;
-			root["FixRadius"] = type->FixRadius;
-			root["IgnoreDirection"] = type->IgnoreDirection;
-			root["IgnoreNormalMoraleLose"] = type->IgnoreNormalMoraleLose;
-			root["IgnoreOverKill"] = type->IgnoreOverKill;
-			root["IgnorePainImmunity"] = type->IgnorePainImmunity;
-			root["IgnoreSelfDestruct"] = type->IgnoreSelfDestruct;
-			root["RadiusEffectiveness"] = type->RadiusEffectiveness;
-			root["RadiusReduction"] = type->RadiusReduction;
-			root["RandomArmor"] = type->RandomArmor;
-			root["RandomArmorPre"] = type->RandomArmorPre;
-			root["RandomEnergy"] = type->RandomEnergy;
-			root["RandomHealth"] = type->RandomHealth;
-			root["RandomItem"] = type->RandomItem;
-			root["RandomMana"] = type->RandomMana;
-			root["RandomMorale"] = type->RandomMorale;
-			root["RandomStun"] = type->RandomStun;
-			root["RandomTile"] = type->RandomTile;
-			root["RandomTime"] = type->RandomTime;
-			root["RandomType"] = _save->getBattleGame()->getCoopMod()->ItemDamageRandomTypeToInt(type->RandomType);
-			root["RandomWound"] = type->RandomWound;
-			root["ResistType"] = _save->getBattleGame()->getCoopMod()->ItemDamageTypeToInt(type->ResistType);
-			root["SmokeThreshold"] = type->SmokeThreshold;
-			root["TileDamageMethod"] = type->TileDamageMethod;
-			root["ToArmor"] = type->ToArmor;
-			root["ToArmorPre"] = type->ToArmorPre;
-			root["ToEnergy"] = type->ToEnergy;
-			root["ToHealth"] = type->ToHealth;
-			root["ToItem"] = type->ToItem;
-			root["ToMana"] = type->ToMana;
-			root["ToMorale"] = type->ToMorale;
-			root["ToStun"] = type->ToStun;
-			root["ToTile"] = type->ToTile;
-			root["ToWound"] = type->ToWound;
-
-			_save->getBattleGame()->getCoopMod()->sendTCPPacketData(root.toStyledString());
+			hit.damageType = type;
+			hit.randomType = _save->getBattleGame()->getCoopMod()->ItemDamageRandomTypeToInt(type->RandomType);
+			hit.resistType = _save->getBattleGame()->getCoopMod()->ItemDamageTypeToInt(type->ResistType);
+
+			CoopJson::send(hit);
 
 		}
 
@@ -3871,17 +3835,7 @@ void TileEngine::explode(BattleActionAttack attack, Position center, int power,
 	if (connectionTCP::getCoopStatic() == true && connectionTCP::getHost() == true && connectionTCP::getCoopGamemode() != 2 && connectionTCP::getCoopGamemode() != 3)
 	{
 
-		Json::Value root;
-		root["state"] = "calc_explode_fov";
-
-		root["maxRadius"] = maxRadius;
-		root["coop_is_second_fov"] = coop_is_second_fov;
-
-		root["center_tile_x"] = centetTile.x;
-		root["center_tile_y"] = centetTile.y;
-		root["center_tile_z"] = centetTile.z;
-
-		connectionTCP::sendTCPPacketStaticData2(root.toStyledString());
+		CoopJson::send(ExplodeFov{ maxRadius, coop_is_second_fov, centetTile });
 
 	}
 
@@ -6174,6 +6128,7 @@ bool TileEngine::validateThrow(BattleAction &action, Position originVoxel, Posit
  */
 void TileEngine::recalculateFOV()
 {
+	PROFILE_ZONE("TileEngine::recalculateFOV");
 	for (auto* bu : *_save->getUnits())
 	{
 		if (bu->getTile() != 0)
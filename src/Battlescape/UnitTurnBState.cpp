@@ -25,6 +25,7 @@
 #include "../Savegame/SavedBattleGame.h"
 #include "Map.h"
 #include "TileEngine.h"
+#include "../CoopMod/CoopMessages.h"
 
 namespace OpenXcom
 {
@@ -66,52 +67,38 @@ void UnitTurnBState::deinit()
 
 		if (turned)
 		{
-			Json::Value turn;
-			turn["state"] = "turnBattlescapeUnit";
-			turn["id"] = _unit->getId();
+			UnitTurn turn;
+			turn.id = _unit->getId();
+			turn.coords.start = _unit->getPosition();
+			turn.coords.end = _action.target;
 
-			turn["coords"]["start"]["x"] = _unit->getPosition().x;
-			turn["coords"]["start"]["y"] = _unit->getPosition().y;
-			turn["coords"]["start"]["z"] = _unit->getPosition().z;
+			turn.actionTypeNone = (_action.type == BA_NONE);
 
-			turn["coords"]["end"]["x"] = _action.target.x;
-			turn["coords"]["end"]["y"] = _action.target.y;
-			turn["coords"]["end"]["z"] = _action.target.z;
+			turn.tu = _unit->getTimeUnits();
+			turn.energy = _unit->getEnergy();
+			turn.health = _unit->getHealth();
+			turn.morale = _unit->getMorale();
+			turn.stunlevel = _unit->getStunlevel();
+			turn.mana = _unit->getMana();
 
-			turn["isActionTypeNone"] = (_action.type == BA_NONE);
+			CoopJson::Message msg(CoopJson::Schema<UnitTurn>::state);
+			CoopJson::writeFields(msg, turn);
 
-			turn["tu"] = _unit->getTimeUnits();
-			turn["energy"] = _unit->getEnergy();
-			turn["health"] = _unit->getHealth();
-			turn["morale"] = _unit->getMorale();
-			turn["stunlevel"] = _unit->getStunlevel();
-			turn["mana"] = _unit->getMana();
-
-			if (_parent->getCoopGamemode() != 2 && _parent->getCoopGamemode() != 3 && _parent->getCoopMod()->_isActiveAISync == false)
+			if (_parent->getCoopGamemode() != 2 && _parent->getCoopGamemode() != 3 && _parent->getCoopMod()->_isActiveAISync == false && !_unit->getVisibleUnits()->empty())
 			{
-				int j = 0;
-				for (auto* bu : *_unit->getVisibleUnits())
+				// one entry per visible unit, all carrying the turning unit's own id
+				msg.key("visible_units").beginArray();
+				for (size_t j = 0; j < _unit->getVisibleUnits()->size(); ++j)
 				{
-					turn["visible_units"][j]["unit_id"] = _unit->getId();
-					j++;
+					msg.beginObject().field("unit_id", _unit->getId()).endObject();
 				}
+				msg.endArray();
 			}
 
-			_parent->getCoopMod()->sendTCPPacketData(turn.toStyledString());
+			msg.send();
 		}
 
-		Json::Value obj;
-		obj["state"] = "afterBattlescapeUnitTurn";
-
-		obj["setDirection"] = _unit->getDirection();
-		obj["setFaceDirection"] = _unit->getFaceDirection();
-
-		obj["setTurretDirection"] = _unit->getTurretDirection();
-		obj["setTurretToDirection"] = _unit->getTurretToDirection();
-
-		obj["unit_id"] = _unit->getId();
-
-		_parent->getCoopMod()->sendTCPPacketData(obj.toStyledString());
+		CoopJson::send(UnitFacing{ _unit->getDirection(), _unit->getFaceDirection(), _unit->getTurretDirection(), _unit->getTurretToDirection(), _unit->getId() });
 	}
 
 	// coop
@@ -33,6 +33,7 @@
 #include "../Mod/Armor.h"
 #include "../Mod/Mod.h"
 #include "UnitFallBState.h"
+#include "../CoopMod/CoopMessages.h"
 
 namespace OpenXcom
 {
@@ -81,44 +82,60 @@ void UnitWalkBState::init()
 	// coop
 	if (_parent->isCoop() == true && _parent->getCoopMod()->_isActivePlayerSync == true)
 	{
-		Json::Value obj;
-		obj["state"] = "BattleScapeMove";
-
-		int index = 0;
-
-		obj["id"] = _unit->getId();
-
-		int startx = _unit->getPosition().x;
-		int starty = _unit->getPosition().y;
-		int startz = _unit->getPosition().z;
-
-		obj["coords"]["start"]["x"] = startx;
-		obj["coords"]["start"]["y"] = starty;
-		obj["coords"]["start"]["z"] = startz;
-
-		obj["coords"]["end"]["x"] = _target.x;
-		obj["coords"]["end"]["y"] = _target.y;
-		obj["coords"]["end"]["z"] = _target.z;
-
-		obj["tu"] = _unit->getTimeUnits();
-		obj["energy"] = _unit->getEnergy();
-		obj["health"] = _unit->getHealth();
-		obj["morale"] = _unit->getMorale();
-		obj["stunlevel"] = _unit->getStunlevel();
-		obj["mana"] = _unit->getMana();
-
-		obj["strafe"] = _action.strafe;
-		obj["run"] = _action.run;
-		obj["sneak"] = _action.sneak;
+		UnitMove move;
+		move.id = _unit->getId();
+		move.coords.start = _unit->getPosition();
+		move.coords.end = _target;
+
+		move.tu = _unit->getTimeUnits();
+		move.energy = _unit->getEnergy();
+		move.health = _unit->getHealth();
+		move.morale = _unit->getMorale();
+		move.stunlevel = _unit->getStunlevel();
+		move.mana = _unit->getMana();
+
+		move.strafe = _action.strafe;
+		move.run = _action.run;
+		move.sneak = _action.sneak;
 
 		// new
-		obj["visible"] = _unit->getVisible();
-		obj["hiding"] = _unit->isHiding();
-
-		obj["setDirection"] = _unit->getDirection();
-		obj["setFaceDirection"] = _unit->getFaceDirection();
+		move.visible = _unit->getVisible();
+		move.hiding = _unit->isHiding();
+
+		move.direction = _unit->getDirection();
+		move.faceDirection = _unit->getFaceDirection();
+
+		// the path as it will be walked here, cut where the time units or energy run out
+		// or where the next step would eat into the reserved time units
+		std::vector<UnitStep> path;
+		const std::vector<int> &directions = _pf->getPath();
+		path.reserve(directions.size());
+		Position pos = _unit->getPosition();
+		int tu = 0;
+		int energy = 0;
+		// same as think(): a reserve the unit can't afford to begin with isn't kept
+		bool reserve = _parent->getPanicHandled() && _parent->checkReservedTU(_unit, 0, 0, true);
+		move.interrupted = false;
+		_pf->setUnit(_unit);
+		for (auto i = directions.rbegin(); i != directions.rend(); ++i)
+		{
+			PathfindingStep r = _pf->getTUCost(pos, *i, _unit, 0, _action.getMoveType());
+			if (r.cost.time == Pathfinding::INVALID_MOVE_COST
+				|| tu + r.cost.time > _unit->getTimeUnits() || energy + r.cost.energy > _unit->getEnergy()
+				|| (reserve && !_parent->checkReservedTU(_unit, tu + r.cost.time, energy + r.cost.energy, true)))
+			{
+				move.interrupted = true;
+				break;
+			}
+			tu += r.cost.time;
+			energy += r.cost.energy;
+			path.push_back(UnitStep{ *i, r.cost.time, r.cost.energy, r.pos });
+			pos = r.pos;
+		}
+		move.strafeMove = _pf->getStrafeMove();
+		move.path = &path;
 
-		_parent->getCoopMod()->sendTCPPacketData(obj.toStyledString());
+		CoopJson::send(move);
 
 	}
 
@@ -136,35 +153,34 @@ void UnitWalkBState::deinit()
 	if (_parent->isCoop() == true && _parent->getCoopMod()->_isActivePlayerSync == true)
 	{
 
-		Json::Value root;
+		UnitStop stop;
+		stop.unitId = _unit->getId();
+		stop.pos = _unit->getPosition();
 
-		root["state"] = "abortPath";
+		stop.direction = _unit->getDirection();
+		stop.faceDirection = _unit->getFaceDirection();
 
-		root["unit_id"] = _unit->getId();
+		stop.turretDirection = _unit->getTurretDirection();
+		stop.turretToDirection = _unit->getTurretToDirection();
 
-		root["x"] = _unit->getPosition().x;
-		root["y"] = _unit->getPosition().y;
-		root["z"] = _unit->getPosition().z;
+		stop.tu = _unit->getTimeUnits();
+		stop.energy = _unit->getEnergy();
 
-		root["setDirection"] = _unit->getDirection();
-		root["setFaceDirection"] = _unit->getFaceDirection();
+		CoopJson::Message msg(CoopJson::Schema<UnitStop>::state);
+		CoopJson::writeFields(msg, stop);
 
-		root["setTurretDirection"] = _unit->getTurretDirection();
-		root["setTurretToDirection"] = _unit->getTurretToDirection();
-
-		if (_parent->getCoopGamemode() != 2 && _parent->getCoopGamemode() != 3 && _parent->getCoopMod()->_isActiveAISync == false)
+		if (_parent->getCoopGamemode() != 2 && _parent->getCoopGamemode() != 3 && _parent->getCoopMod()->_isActiveAISync == false && !_unit->getVisibleUnits()->empty())
 		{
-			int j = 0;
-			for (auto* bu : *_unit->getVisibleUnits())
+			// one entry per visible unit, all carrying the walker's own id
+			msg.key("visible_units").beginArray();
+			for (size_t j = 0; j < _unit->getVisibleUnits()->size(); ++j)
 			{
-
-				root["visible_units"][j]["unit_id"] = _unit->getId();
-
-				j++;
+				msg.beginObject().field("unit_id", _unit->getId()).endObject();
 			}
+			msg.endArray();
 		}
-	
-		_parent->getCoopMod()->sendTCPPacketData(root.toStyledString());
+
+		msg.send();
 
 	}
 
@@ -440,8 +456,18 @@ void UnitWalkBState::think()
 				_unit->setFaceDirection(_unit->getDirection());
 			}
 
-			_pf->setUnit(_unit); //TODO: remove as was done by `getTUCost`
-			PathfindingStep r = _pf->getTUCost(_unit->getPosition(), dir, _unit, 0, _action.getMoveType());
+			// coop: a path from the peer comes with its costs
+			const PathfindingStep *sent = _falling ? nullptr : _pf->getCoopStep();
+			PathfindingStep r;
+			if (sent)
+			{
+				r = *sent;
+			}
+			else
+			{
+				_pf->setUnit(_unit); //TODO: remove as was done by `getTUCost`
+				r = _pf->getTUCost(_unit->getPosition(), dir, _unit, 0, _action.getMoveType());
+			}
 
 			int tu = r.cost.time;
 			int energy = r.cost.energy;
@@ -470,7 +496,8 @@ void UnitWalkBState::think()
 				return cancelCurentMove();
 			}
 
-			if (_parent->getPanicHandled() && !_falling && _parent->checkReservedTU(_unit, tu, energy) == false)
+			// coop: a path from the peer is already cut where its reserve starts
+			if (!sent && _parent->getPanicHandled() && !_falling && _parent->checkReservedTU(_unit, tu, energy) == false)
 			{
 				return cancelCurentMove();
 			}
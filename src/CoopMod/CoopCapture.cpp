@@ -0,0 +1,273 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ * Copyright 2023-2026 XComCoopTeam (https://www.moddb.com/mods/openxcom-coop-mod)
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CoopCapture.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Options.h"
+
+namespace OpenXcom
+{
+
+namespace CoopCapture
+{
+
+namespace
+{
+
+const char Magic[8] = { 'O', 'X', 'C', 'C', 'A', 'P', 1, 0 };
+/// Buffered bytes that trigger a write.
+const size_t FlushBytes = 64 * 1024;
+/// Longest a record waits in the buffer when more keep coming.
+const std::chrono::milliseconds FlushInterval(100);
+
+std::atomic<bool> recording(false);
+std::atomic<uint64_t> recorded(0);
+/// Guards everything below; the transport threads record concurrently.
+std::mutex mutex;
+FILE *file = nullptr;
+std::string buffer;
+std::chrono::steady_clock::time_point started;
+std::chrono::steady_clock::time_point lastFlush;
+uint64_t lastUs = 0;
+
+void writeVarint(std::string &out, uint64_t v)
+{
+	while (v >= 0x80)
+	{
+		out += (char)(v | 0x80);
+		v >>= 7;
+	}
+	out += (char)v;
+}
+
+bool readVarint(const unsigned char *&p, const unsigned char *end, uint64_t &v)
+{
+	v = 0;
+	for (int shift = 0; p < end && shift < 64; shift += 7)
+	{
+		unsigned char b = *p++;
+		v |= (uint64_t)(b & 0x7F) << shift;
+		if (!(b & 0x80))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Writes the buffer through to the OS, so a crash of the
+ * game can't lose it. Needs the mutex.
+ */
+void flushLocked()
+{
+	if (file && !buffer.empty())
+	{
+		if (fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size() || fflush(file) != 0)
+		{
+			Log(LOG_ERROR) << "[coop] packet capture write failed";
+		}
+	}
+	buffer.clear();
+	lastFlush = std::chrono::steady_clock::now();
+}
+
+}
+
+/**
+ * Starts a capture. Does nothing if one is already running.
+ * @param path File to write, replaced if it exists.
+ * @return True if this call started the capture.
+ */
+bool start(const std::string &path)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (file)
+	{
+		return false;
+	}
+	file = CrossPlatform::openFile(path, false);
+	if (!file)
+	{
+		Log(LOG_ERROR) << "[coop] can't write packet capture " << path;
+		return false;
+	}
+	buffer.assign(Magic, sizeof(Magic));
+	started = std::chrono::steady_clock::now();
+	lastFlush = started;
+	lastUs = 0;
+	recorded = 0;
+	recording.store(true, std::memory_order_release);
+	Log(LOG_INFO) << "[coop] capturing packets to " << path;
+	return true;
+}
+
+/**
+ * Stops the capture and closes the file.
+ */
+void stop()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (!file)
+	{
+		return;
+	}
+	recording.store(false, std::memory_order_release);
+	flushLocked();
+	fclose(file);
+	file = nullptr;
+	Log(LOG_INFO) << "[coop] packet capture closed, " << recorded.load() << " messages";
+}
+
+/**
+ * @return True while a capture is running.
+ */
+bool isRecording()
+{
+	return recording.load(std::memory_order_acquire);
+}
+
+/**
+ * Appends a message, with the time since the previous one.
+ * @param flags Combination of Flags.
+ * @param payload Message body, without the transport's framing.
+ */
+void record(int flags, const std::string &payload)
+{
+	if (!recording.load(std::memory_order_acquire))
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> lock(mutex);
+	if (!file)
+	{
+		return;
+	}
+	// stamped under the lock, so the deltas never go negative
+	auto clock = std::chrono::steady_clock::now();
+	uint64_t now = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(clock - started).count();
+	writeVarint(buffer, now - lastUs);
+	lastUs = now;
+	buffer += (char)flags;
+	writeVarint(buffer, payload.size());
+	buffer += payload;
+	recorded++;
+	if (buffer.size() >= FlushBytes || clock - lastFlush >= FlushInterval)
+	{
+		flushLocked();
+	}
+}
+
+/**
+ * Writes out the buffered records. The transports call it after
+ * each batch they send or receive, so the messages right before
+ * a crash end up in the file.
+ */
+void flush()
+{
+	if (!recording.load(std::memory_order_acquire))
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> lock(mutex);
+	flushLocked();
+}
+
+/**
+ * @return Messages recorded since the last start().
+ */
+uint64_t getRecorded()
+{
+	return recorded.load();
+}
+
+/**
+ * Gets a new capture file name under captures/ in the user folder,
+ * creating the folder if needed.
+ * @param host True for the host's side of the session.
+ * @return Full path.
+ */
+std::string makePath(bool host)
+{
+	std::string folder = Options::getUserFolder() + "captures/";
+	if (!CrossPlatform::folderExists(folder))
+	{
+		CrossPlatform::createFolder(folder);
+	}
+	std::time_t t = std::time(nullptr);
+	char stamp[32];
+	std::strftime(stamp, sizeof(stamp), "%Y-%m-%d_%H-%M-%S", std::localtime(&t));
+	return folder + (host ? "host_" : "client_") + stamp + ".oxcap";
+}
+
+/**
+ * Reads a whole capture file.
+ * @param path File to read.
+ * @return Records in capture order, with absolute times.
+ */
+std::vector<Record> load(const std::string &path)
+{
+	RawData data = CrossPlatform::readFileRaw(path);
+	const unsigned char *p = (const unsigned char*)data.data();
+	const unsigned char *end = p + data.size();
+	if (data.size() < sizeof(Magic) || std::memcmp(p, Magic, sizeof(Magic)) != 0)
+	{
+		throw Exception(path + " is not a co-op packet capture");
+	}
+	p += sizeof(Magic);
+
+	std::vector<Record> records;
+	uint64_t time = 0;
+	while (p < end)
+	{
+		const unsigned char *begin = p;
+		uint64_t delta, size;
+		if (!readVarint(p, end, delta) || p >= end)
+		{
+			p = begin;
+			break;
+		}
+		int flags = *p++;
+		if (!readVarint(p, end, size) || size > (uint64_t)(end - p))
+		{
+			p = begin;
+			break;
+		}
+		time += delta;
+		records.push_back(Record{ time, flags, std::string((const char*)p, (size_t)size) });
+		p += size;
+	}
+	if (p < end)
+	{
+		Log(LOG_WARNING) << "[coop] " << path << " ends in a partial record, read " << records.size() << " messages";
+	}
+	return records;
+}
+
+}
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ * Copyright 2023-2026 XComCoopTeam (https://www.moddb.com/mods/openxcom-coop-mod)
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OpenXcom
+{
+
+/**
+ * Packet capture for co-op sessions. The transport threads (TCP client,
+ * TCP host, UDP) hand every message they frame or unframe to record(),
+ * which appends it to a compact binary log: the time since the previous
+ * record, a flags byte and the payload. While no capture runs, record()
+ * is a single atomic load.
+ *
+ * File layout: the 8 byte magic "OXCCAP" 1 0, then one record after the
+ * other, each a varint delta in microseconds, a flags byte, a varint
+ * length and the payload bytes. Records are written through after each
+ * transport batch and at least every 100 ms, so a file cut short by a
+ * crash loads up to its last complete record.
+ */
+namespace CoopCapture
+{
+	/// What a record carries, combined into its flags byte.
+	enum Flags { OUTBOUND = 1, SNAPSHOT = 2, UDP = 4 };
+
+	/// One captured message.
+	struct Record
+	{
+		uint64_t timeUs;
+		int flags;
+		std::string payload;
+	};
+
+	/// Starts writing a capture file.
+	bool start(const std::string &path);
+	/// Writes out what's buffered and closes the file.
+	void stop();
+	/// Checks if a capture is being written.
+	bool isRecording();
+	/// Appends a message to the capture, if one is running.
+	void record(int flags, const std::string &payload);
+	/// Writes out the buffered records.
+	void flush();
+	/// Gets the number of messages recorded by the current or last capture.
+	uint64_t getRecorded();
+	/// Gets a fresh file name in the user folder.
+	std::string makePath(bool host);
+	/// Reads a capture file.
+	std::vector<Record> load(const std::string &path);
+}
+
+}
@@ -0,0 +1,301 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ * Copyright 2023-2026 XComCoopTeam (https://www.moddb.com/mods/openxcom-coop-mod)
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CoopJson.h"
+#include <cmath>
+#include <cstdio>
+#include "connectionTCP.h"
+
+namespace OpenXcom
+{
+
+namespace CoopJson
+{
+
+namespace
+{
+
+/// Room for the largest messages, so the buffer rarely grows at all.
+const size_t InitialCapacity = 4096;
+
+thread_local std::string buffer;
+thread_local bool bufferBusy = false;
+
+const char Hex[] = "0123456789abcdef";
+
+}
+
+Writer::Writer() : _out(nullptr), _comma(false)
+{
+}
+
+Writer::Writer(std::string &out) : _out(&out), _comma(false)
+{
+}
+
+void Writer::separate()
+{
+	if (_comma)
+	{
+		*_out += ',';
+	}
+}
+
+Writer &Writer::beginObject()
+{
+	separate();
+	*_out += '{';
+	_comma = false;
+	return *this;
+}
+
+Writer &Writer::endObject()
+{
+	*_out += '}';
+	_comma = true;
+	return *this;
+}
+
+Writer &Writer::beginArray()
+{
+	separate();
+	*_out += '[';
+	_comma = false;
+	return *this;
+}
+
+Writer &Writer::endArray()
+{
+	*_out += ']';
+	_comma = true;
+	return *this;
+}
+
+/**
+ * @param name Plain key, written without escaping.
+ */
+Writer &Writer::key(const char *name)
+{
+	separate();
+	*_out += '"';
+	*_out += name;
+	*_out += "\":";
+	_comma = false;
+	return *this;
+}
+
+Writer &Writer::null()
+{
+	separate();
+	*_out += "null";
+	_comma = true;
+	return *this;
+}
+
+Writer &Writer::value(bool v)
+{
+	separate();
+	*_out += v ? "true" : "false";
+	_comma = true;
+	return *this;
+}
+
+/**
+ * Same text as jsoncpp's writers, so a value reads back bit for bit:
+ * 17 significant digits, a '.' whatever the locale, ".0" on whole
+ * numbers, null for NaN and an overflowing literal for infinities.
+ */
+Writer &Writer::value(double v)
+{
+	separate();
+	if (std::isnan(v))
+	{
+		*_out += "null";
+	}
+	else if (std::isinf(v))
+	{
+		*_out += v < 0 ? "-1e+9999" : "1e+9999";
+	}
+	else
+	{
+		char buf[32];
+		int len = std::snprintf(buf, sizeof(buf), "%.17g", v);
+		bool point = false;
+		for (int i = 0; i < len; ++i)
+		{
+			if (buf[i] == ',')
+			{
+				buf[i] = '.';
+			}
+			point = point || buf[i] == '.' || buf[i] == 'e';
+		}
+		_out->append(buf, len);
+		if (!point)
+		{
+			*_out += ".0";
+		}
+	}
+	_comma = true;
+	return *this;
+}
+
+/**
+ * Escapes quotes, backslashes and control characters; everything else,
+ * UTF-8 included, is copied as is.
+ */
+Writer &Writer::value(std::string_view v)
+{
+	separate();
+	*_out += '"';
+	size_t run = 0;
+	for (size_t i = 0; i < v.size(); ++i)
+	{
+		unsigned char c = v[i];
+		if (c >= 0x20 && c != '"' && c != '\\')
+		{
+			continue;
+		}
+		_out->append(v.data() + run, i - run);
+		run = i + 1;
+		switch (c)
+		{
+		case '"': *_out += "\\\""; break;
+		case '\\': *_out += "\\\\"; break;
+		case '\b': *_out += "\\b"; break;
+		case '\f': *_out += "\\f"; break;
+		case '\n': *_out += "\\n"; break;
+		case '\r': *_out += "\\r"; break;
+		case '\t': *_out += "\\t"; break;
+		default:
+			*_out += "\\u00";
+			*_out += Hex[c >> 4];
+			*_out += Hex[c & 0xF];
+			break;
+		}
+	}
+	_out->append(v.data() + run, v.size() - run);
+	*_out += '"';
+	_comma = true;
+	return *this;
+}
+
+/**
+ * Walks the tree without building any intermediate string.
+ */
+Writer &Writer::value(const Json::Value &v)
+{
+	switch (v.type())
+	{
+	case Json::nullValue:
+		return null();
+	case Json::intValue:
+		return value((int64_t)v.asLargestInt());
+	case Json::uintValue:
+		return value((uint64_t)v.asLargestUInt());
+	case Json::realValue:
+		return value(v.asDouble());
+	case Json::booleanValue:
+		return value(v.asBool());
+	case Json::stringValue:
+	{
+		const char *begin, *end;
+		v.getString(&begin, &end);
+		return value(std::string_view(begin, end - begin));
+	}
+	case Json::arrayValue:
+		beginArray();
+		for (const auto &i : v)
+		{
+			value(i);
+		}
+		return endArray();
+	case Json::objectValue:
+		beginObject();
+		for (auto i = v.begin(); i != v.end(); ++i)
+		{
+			const char *end;
+			const char *name = i.memberName(&end);
+			value(std::string_view(name, end - name));
+			*_out += ':';
+			_comma = false;
+			value(*i);
+		}
+		return endObject();
+	}
+	return *this;
+}
+
+/**
+ * Takes this thread's buffer, unless a message is already using it,
+ * and writes the opening `{"state":...`.
+ * @param state Message type.
+ */
+Message::Message(const char *state) : _pooled(!bufferBusy), _closed(false)
+{
+	if (_pooled)
+	{
+		bufferBusy = true;
+		if (buffer.capacity() < InitialCapacity)
+		{
+			buffer.reserve(InitialCapacity);
+		}
+		_out = &buffer;
+	}
+	else
+	{
+		_out = &_own;
+	}
+	_out->clear();
+	beginObject();
+	field("state", state);
+}
+
+Message::~Message()
+{
+	if (_pooled)
+	{
+		bufferBusy = false;
+	}
+}
+
+/**
+ * @return The message text, valid until the message is destroyed.
+ */
+const std::string &Message::finish()
+{
+	if (!_closed)
+	{
+		endObject();
+		_closed = true;
+	}
+	return *_out;
+}
+
+/**
+ * Copies the message out at its exact size, the one allocation on the
+ * way to the wire, since the TX queue holds its own strings.
+ */
+void Message::send()
+{
+	enqueueTx(std::string(finish()));
+}
+
+}
+
+}
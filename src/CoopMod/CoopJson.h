@@ -0,0 +1,320 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ * Copyright 2023-2026 XComCoopTeam (https://www.moddb.com/mods/openxcom-coop-mod)
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <json/json.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Streaming JSON for the high-frequency co-op messages. Instead of building
+ * a Json::Value tree and styling it, a message is written straight into a
+ * per-thread buffer that keeps its capacity between messages, so encoding
+ * allocates nothing once the buffer has grown; only the finished message is
+ * copied out, at its exact size, for the TX queue.
+ *
+ * A message type is a plain struct plus a Schema specialization listing its
+ * fields, which is expanded at compile time:
+ *
+ *     template<> struct Schema<TileFire>
+ *     {
+ *         static constexpr const char *state = "set_fire_tile";
+ *         static constexpr auto fields = std::make_tuple(
+ *             field("fire", &TileFire::fire), ...);
+ *     };
+ *
+ * Members can be numbers, bools, std::string_view, Json::Value, structs with
+ * their own Schema (nested objects), std::vector, std::list or std::array of
+ * those (arrays), or pointers to any of them. Like a Json::Value that was
+ * never indexed, a null pointer or an empty list leaves its key out. The
+ * output parses to the same values as the old toStyledString() of the same
+ * tree, without the indentation.
+ */
+namespace CoopJson
+{
+	/**
+	 * Appends JSON tokens to a string, taking care of the commas.
+	 * Keys are written as given, so they must not need escaping.
+	 */
+	class Writer
+	{
+	protected:
+		std::string *_out;
+		bool _comma;
+
+		/// Creates a writer with no output; the derived class sets it.
+		Writer();
+		/// Writes a comma if the previous token needs one.
+		void separate();
+	public:
+		/// Creates a writer appending to a string.
+		explicit Writer(std::string &out);
+		/// Opens an object.
+		Writer &beginObject();
+		/// Closes an object.
+		Writer &endObject();
+		/// Opens an array.
+		Writer &beginArray();
+		/// Closes an array.
+		Writer &endArray();
+		/// Writes an object key; the value follows.
+		Writer &key(const char *name);
+		/// Writes a null.
+		Writer &null();
+		/// Writes a bool.
+		Writer &value(bool v);
+		/// Writes a number like jsoncpp does (%.17g, always with a '.' or 'e').
+		Writer &value(double v);
+		/// Writes an escaped string.
+		Writer &value(std::string_view v);
+		/// Writes a string.
+		Writer &value(const char *v) { return value(std::string_view(v)); }
+		/// Writes a string.
+		Writer &value(const std::string &v) { return value(std::string_view(v)); }
+		/// Writes a whole Json::Value tree.
+		Writer &value(const Json::Value &v);
+		/// Writes an integer.
+		template<class T>
+		std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, Writer&> value(T v)
+		{
+			separate();
+			char buf[24];
+			auto res = std::to_chars(buf, buf + sizeof(buf), v);
+			_out->append(buf, res.ptr - buf);
+			_comma = true;
+			return *this;
+		}
+		/// Writes a key and its value.
+		template<class T>
+		Writer &field(const char *name, const T &v)
+		{
+			key(name);
+			return value(v);
+		}
+		/// Gets what has been written so far.
+		const std::string &str() const { return *_out; }
+	};
+
+	/**
+	 * A message being written into this thread's reusable buffer, opened
+	 * with its "state". A message started while another one is still being
+	 * written on the same thread gets a buffer of its own.
+	 */
+	class Message : public Writer
+	{
+		std::string _own;
+		bool _pooled, _closed;
+	public:
+		/// Opens a message.
+		explicit Message(const char *state);
+		/// Gives the buffer back.
+		~Message();
+		Message(const Message&) = delete;
+		Message &operator=(const Message&) = delete;
+		/// Closes the message and gets its text.
+		const std::string &finish();
+		/// Closes the message and queues it for the peer.
+		void send();
+	};
+
+	/// Field list of a message or nested type; specialize with `state` and `fields`.
+	template<class T>
+	struct Schema
+	{
+	};
+
+	/// A named member.
+	template<class T, class M, class S>
+	struct Field
+	{
+		const char *name;
+		M T::*member;
+	};
+
+	/// A member whose own fields are written into the enclosing object.
+	template<class T, class M, class S>
+	struct Inline
+	{
+		M T::*member;
+	};
+
+	/**
+	 * Lists a member under a key. @a S picks another type's Schema for it
+	 * (or for its elements), for a type written under different key names.
+	 */
+	template<class S = void, class T, class M>
+	constexpr Field<T, M, S> field(const char *name, M T::*member)
+	{
+		return Field<T, M, S>{ name, member };
+	}
+
+	/// Lists a member whose fields go straight into the enclosing object.
+	template<class S = void, class T, class M>
+	constexpr Inline<T, M, S> inlined(M T::*member)
+	{
+		return Inline<T, M, S>{ member };
+	}
+
+	namespace detail
+	{
+		template<class T, class = void>
+		struct HasSchema : std::false_type {};
+		template<class T>
+		struct HasSchema<T, std::void_t<decltype(Schema<T>::fields)>> : std::true_type {};
+
+		template<class T>
+		struct IsList : std::false_type {};
+		template<class T, class A>
+		struct IsList<std::vector<T, A>> : std::true_type {};
+		template<class T, class A>
+		struct IsList<std::list<T, A>> : std::true_type {};
+		template<class T, size_t N>
+		struct IsList<std::array<T, N>> : std::true_type {};
+
+		/// The schema to write @a M with: @a S if given, else M's own.
+		template<class M, class S>
+		using SchemaOf = std::conditional_t<std::is_void_v<S>, M, S>;
+
+		/// Checks if a member would be a key never set in a Json::Value.
+		template<class M>
+		bool isAbsent(const M &v)
+		{
+			if constexpr (std::is_pointer_v<M>)
+				return v == nullptr || isAbsent(*v);
+			else if constexpr (IsList<M>::value)
+				return v.empty();
+			else
+				return false;
+		}
+
+		template<class S, class T>
+		void writeMembers(Writer &w, const T &obj);
+
+		template<class S, class M>
+		void writeValue(Writer &w, const M &v)
+		{
+			if constexpr (std::is_pointer_v<M>)
+			{
+				static_assert(!std::is_same_v<std::remove_cv_t<std::remove_pointer_t<M>>, char>, "strings are std::string_view");
+				if (v)
+					writeValue<S>(w, *v);
+				else
+					w.null();
+			}
+			else if constexpr (IsList<M>::value)
+			{
+				w.beginArray();
+				for (const auto &i : v)
+					writeValue<S>(w, i);
+				w.endArray();
+			}
+			else if constexpr (HasSchema<SchemaOf<M, S>>::value)
+			{
+				w.beginObject();
+				writeMembers<SchemaOf<M, S>>(w, v);
+				w.endObject();
+			}
+			else
+			{
+				w.value(v);
+			}
+		}
+
+		template<class T, class M, class S>
+		void writeField(Writer &w, const T &obj, const Field<T, M, S> &f)
+		{
+			const M &v = obj.*f.member;
+			if (!isAbsent(v))
+			{
+				w.key(f.name);
+				writeValue<S>(w, v);
+			}
+		}
+
+		template<class T, class M, class S>
+		void writeField(Writer &w, const T &obj, const Inline<T, M, S> &f)
+		{
+			const M &v = obj.*f.member;
+			if constexpr (std::is_pointer_v<M>)
+			{
+				if (v)
+					writeMembers<SchemaOf<std::remove_cv_t<std::remove_pointer_t<M>>, S>>(w, *v);
+			}
+			else
+			{
+				writeMembers<SchemaOf<M, S>>(w, v);
+			}
+		}
+
+		template<class S, class T>
+		void writeMembers(Writer &w, const T &obj)
+		{
+			std::apply([&](const auto &...f) { (writeField(w, obj, f), ...); }, Schema<S>::fields);
+		}
+	}
+
+	/**
+	 * Writes the fields of @a obj into the object being written.
+	 * @param w Writer inside an object.
+	 * @param obj Message or nested value with a Schema.
+	 */
+	template<class T>
+	void writeFields(Writer &w, const T &obj)
+	{
+		detail::writeMembers<T>(w, obj);
+	}
+
+	/**
+	 * Encodes a message.
+	 * @param msg Message with a Schema.
+	 * @return The JSON text, at its exact size.
+	 */
+	template<class T>
+	std::string encode(const T &msg)
+	{
+		Message m(Schema<T>::state);
+		writeFields(m, msg);
+		return m.finish();
+	}
+
+	/**
+	 * Encodes a message and queues it for the peer.
+	 * @param msg Message with a Schema.
+	 */
+	template<class T>
+	void send(const T &msg)
+	{
+		Message m(Schema<T>::state);
+		writeFields(m, msg);
+		m.send();
+	}
+}
+
+}
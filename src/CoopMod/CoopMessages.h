@@ -0,0 +1,483 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ * Copyright 2023-2026 XComCoopTeam (https://www.moddb.com/mods/openxcom-coop-mod)
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <string_view>
+#include <vector>
+#include "CoopJson.h"
+#include "../Battlescape/Position.h"
+#include "../Mod/RuleDamageType.h"
+#include "../Mod/Unit.h"
+
+namespace OpenXcom
+{
+
+/*
+ * The high-frequency battle messages, sent with CoopJson::send(). The keys
+ * in each Schema are the ones the handlers in connectionTCP read, so they
+ * must not change; the structs only collect the values.
+ */
+
+/// A start and an end tile.
+struct Coords
+{
+	Position start, end;
+};
+
+/// A projectile's target and the shooter's tile.
+struct ShotCoords
+{
+	Position target, start;
+};
+
+/// destroy_tile: a tile part destroyed on the host.
+struct TileDestroy
+{
+	Position pos;
+	int part, specialType, explosive, explosiveType;
+};
+
+/// set_fire_tile: a tile's fire changed on the host.
+struct TileFire
+{
+	Position pos;
+	int fire, animationOffset;
+};
+
+/// set_smoke_tile: a tile's smoke changed on the host.
+struct TileSmoke
+{
+	Position pos;
+	int smoke, animationOffset, overlaps;
+};
+
+/// calc_explode_fov: recalculate the view around an explosion.
+struct ExplodeFov
+{
+	int maxRadius;
+	bool secondFov;
+	Position centerTile;
+};
+
+/// convertUnit: a unit turned into another one (zombies and the like).
+struct UnitConvert
+{
+	int unitId;
+	bool respawn;
+	int spawnFaction;
+	std::string_view spawnType;
+};
+
+/// One step of a walk: its direction, what it costs and where it ends.
+struct UnitStep
+{
+	int dir, tu, energy;
+	Position pos;
+};
+
+/**
+ * BattleScapeMove: a unit starts walking. The path is the walker's own, cut
+ * where its time units, energy or reserve run out (interrupted), so the peer
+ * walks it as is instead of searching for one.
+ */
+struct UnitMove
+{
+	int id;
+	Coords coords;
+	int tu, energy, health, morale, stunlevel, mana;
+	bool strafe, run, sneak, visible, hiding;
+	int direction, faceDirection;
+	bool strafeMove, interrupted;
+	const std::vector<UnitStep> *path;
+};
+
+/// abortPath: where a walk really ended and what it cost; visible_units follows, if any.
+struct UnitStop
+{
+	int unitId;
+	Position pos;
+	int direction, faceDirection, turretDirection, turretToDirection;
+	int tu, energy;
+};
+
+/// turnBattlescapeUnit: a unit turned; visible_units follows, if any.
+struct UnitTurn
+{
+	int id;
+	Coords coords;
+	bool actionTypeNone;
+	int tu, energy, health, morale, stunlevel, mana;
+};
+
+/// afterBattlescapeUnitTurn: a unit's facing after a turn.
+struct UnitFacing
+{
+	int direction, faceDirection, turretDirection, turretToDirection;
+	int unitId;
+};
+
+/// ProjectileFlyBState: a unit shoots or throws.
+struct ProjectileFly
+{
+	int actorId, actorTu, actorEnergy, actorMorale, actorHealth, actorMana, actorStun;
+	bool actorNoLineFire, actorUnableToThrowHere;
+	int type;
+	std::string_view hand;
+	int fuseTimer;
+	bool fuse;
+	ShotCoords coords;
+	bool targeting;
+	std::string_view weaponType;
+	const Json::Value *projectiles;
+	std::string_view ammoType;
+	int ammoId;
+	const std::list<Position> *waypoints;
+	const std::vector<Position> *trajectory;
+};
+
+/// hasHitUnit: the host's projectile has landed.
+struct ProjectileLanded
+{
+};
+
+/// hit_unit: a unit's health after a hit on the host.
+struct UnitHit
+{
+	int unitId, health, stunlevel;
+	std::array<int, BODYPART_MAX> fatalWounds;
+};
+
+/// hit_tile: a hit on the host, with its rolled damage and damage type.
+struct TileHit
+{
+	Position center;
+	int power;
+	bool rangeAtack;
+	int terrainMeleeTilePart;
+	uint64_t seed, smokeRNG;
+	const RuleDamageType *damageType;
+	int randomType, resistType;
+};
+
+/// update_progress: the host's AI progress.
+struct AIProgress
+{
+	int ret, selectedUnitId;
+	bool secondMove;
+};
+
+/// Key names for positions written flat or in lists.
+struct TilePosKeys;
+struct CenterKeys;
+struct CenterTileKeys;
+struct ListPosKeys;
+
+namespace CoopJson
+{
+
+template<> struct Schema<Position>
+{
+	static constexpr auto fields = std::make_tuple(
+		field("x", &Position::x),
+		field("y", &Position::y),
+		field("z", &Position::z));
+};
+
+template<> struct Schema<TilePosKeys>
+{
+	static constexpr auto fields = std::make_tuple(
+		field("tile_pos_x", &Position::x),
+		field("tile_pos_y", &Position::y),
+		field("tile_pos_z", &Position::z));
+};
+
+template<> struct Schema<CenterKeys>
+{
+	static constexpr auto fields = std::make_tuple(
+		field("center_x", &Position::x),
+		field("center_y", &Position::y),
+		field("center_z", &Position::z));
+};
+
+template<> struct Schema<CenterTileKeys>
+{
+	static constexpr auto fields = std::make_tuple(
+		field("center_tile_x", &Position::x),
+		field("center_tile_y", &Position::y),
+		field("center_tile_z", &Position::z));
+};
+
+template<> struct Schema<ListPosKeys>
+{
+	static constexpr auto fields = std::make_tuple(
+		field("pos_x", &Position::x),
+		field("pos_y", &Position::y),
+		field("pos_z", &Position::z));
+};
+
+template<> struct Schema<Coords>
+{
+	static constexpr auto fields = std::make_tuple(
+		field("start", &Coords::start),
+		field("end", &Coords::end));
+};
+
+template<> struct Schema<ShotCoords>
+{
+	static constexpr auto fields = std::make_tuple(
+		field("target", &ShotCoords::target),
+		field("start", &ShotCoords::start));
+};
+
+/// The damage type fields hit_tile carries; the two enums go as ints separately.
+template<> struct Schema<RuleDamageType>
+{
+	static constexpr auto fields = std::make_tuple(
+		field("ArmorEffectiveness", &RuleDamageType::ArmorEffectiveness),
+		field("FireBlastCalc", &RuleDamageType::FireBlastCalc),
+		field("FireThreshold", &RuleDamageType::FireThreshold),
+		field("FixRadius", &RuleDamageType::FixRadius),
+		field("IgnoreDirection", &RuleDamageType::IgnoreDirection),
+		field("IgnoreNormalMoraleLose", &RuleDamageType::IgnoreNormalMoraleLose),
+		field("IgnoreOverKill", &RuleDamageType::IgnoreOverKill),
+		field("IgnorePainImmunity", &RuleDamageType::IgnorePainImmunity),
+		field("IgnoreSelfDestruct", &RuleDamageType::IgnoreSelfDestruct),
+		field("RadiusEffectiveness", &RuleDamageType::RadiusEffectiveness),
+		field("RadiusReduction", &RuleDamageType::RadiusReduction),
+		field("RandomArmor", &RuleDamageType::RandomArmor),
+		field("RandomArmorPre", &RuleDamageType::RandomArmorPre),
+		field("RandomEnergy", &RuleDamageType::RandomEnergy),
+		field("RandomHealth", &RuleDamageType::RandomHealth),
+		field("RandomItem", &RuleDamageType::RandomItem),
+		field("RandomMana", &RuleDamageType::RandomMana),
+		field("RandomMorale", &RuleDamageType::RandomMorale),
+		field("RandomStun", &RuleDamageType::RandomStun),
+		field("RandomTile", &RuleDamageType::RandomTile),
+		field("RandomTime", &RuleDamageType::RandomTime),
+		field("RandomWound", &RuleDamageType::RandomWound),
+		field("SmokeThreshold", &RuleDamageType::SmokeThreshold),
+		field("TileDamageMethod", &RuleDamageType::TileDamageMethod),
+		field("ToArmor", &RuleDamageType::ToArmor),
+		field("ToArmorPre", &RuleDamageType::ToArmorPre),
+		field("ToEnergy", &RuleDamageType::ToEnergy),
+		field("ToHealth", &RuleDamageType::ToHealth),
+		field("ToItem", &RuleDamageType::ToItem),
+		field("ToMana", &RuleDamageType::ToMana),
+		field("ToMorale", &RuleDamageType::ToMorale),
+		field("ToStun", &RuleDamageType::ToStun),
+		field("ToTile", &RuleDamageType::ToTile),
+		field("ToWound", &RuleDamageType::ToWound));
+};
+
+template<> struct Schema<TileDestroy>
+{
+	static constexpr const char *state = "destroy_tile";
+	static constexpr auto fields = std::make_tuple(
+		inlined<TilePosKeys>(&TileDestroy::pos),
+		field("tile_part", &TileDestroy::part),
+		field("special_tile_type", &TileDestroy::specialType),
+		field("explosive", &TileDestroy::explosive),
+		field("explosive_type", &TileDestroy::explosiveType));
+};
+
+template<> struct Schema<TileFire>
+{
+	static constexpr const char *state = "set_fire_tile";
+	static constexpr auto fields = std::make_tuple(
+		inlined<TilePosKeys>(&TileFire::pos),
+		field("fire", &TileFire::fire),
+		field("animation_offset", &TileFire::animationOffset));
+};
+
+template<> struct Schema<TileSmoke>
+{
+	static constexpr const char *state = "set_smoke_tile";
+	static constexpr auto fields = std::make_tuple(
+		inlined<TilePosKeys>(&TileSmoke::pos),
+		field("smoke", &TileSmoke::smoke),
+		field("animation_offset", &TileSmoke::animationOffset),
+		field("overlaps", &TileSmoke::overlaps));
+};
+
+template<> struct Schema<ExplodeFov>
+{
+	static constexpr const char *state = "calc_explode_fov";
+	static constexpr auto fields = std::make_tuple(
+		field("maxRadius", &ExplodeFov::maxRadius),
+		field("coop_is_second_fov", &ExplodeFov::secondFov),
+		inlined<CenterTileKeys>(&ExplodeFov::centerTile));
+};
+
+template<> struct Schema<UnitConvert>
+{
+	static constexpr const char *state = "convertUnit";
+	static constexpr auto fields = std::make_tuple(
+		field("unit_id", &UnitConvert::unitId),
+		field("respawn", &UnitConvert::respawn),
+		field("spawn_unit_faction", &UnitConvert::spawnFaction),
+		field("spawn_unit_type", &UnitConvert::spawnType));
+};
+
+template<> struct Schema<UnitStep>
+{
+	static constexpr auto fields = std::make_tuple(
+		field("dir", &UnitStep::dir),
+		field("tu", &UnitStep::tu),
+		field("energy", &UnitStep::energy),
+		inlined(&UnitStep::pos));
+};
+
+template<> struct Schema<UnitMove>
+{
+	static constexpr const char *state = "BattleScapeMove";
+	static constexpr auto fields = std::make_tuple(
+		field("id", &UnitMove::id),
+		field("coords", &UnitMove::coords),
+		field("tu", &UnitMove::tu),
+		field("energy", &UnitMove::energy),
+		field("health", &UnitMove::health),
+		field("morale", &UnitMove::morale),
+		field("stunlevel", &UnitMove::stunlevel),
+		field("mana", &UnitMove::mana),
+		field("strafe", &UnitMove::strafe),
+		field("run", &UnitMove::run),
+		field("sneak", &UnitMove::sneak),
+		field("visible", &UnitMove::visible),
+		field("hiding", &UnitMove::hiding),
+		field("setDirection", &UnitMove::direction),
+		field("setFaceDirection", &UnitMove::faceDirection),
+		field("strafeMove", &UnitMove::strafeMove),
+		field("interrupted", &UnitMove::interrupted),
+		field("path", &UnitMove::path));
+};
+
+template<> struct Schema<UnitStop>
+{
+	static constexpr const char *state = "abortPath";
+	static constexpr auto fields = std::make_tuple(
+		field("unit_id", &UnitStop::unitId),
+		inlined(&UnitStop::pos),
+		field("setDirection", &UnitStop::direction),
+		field("setFaceDirection", &UnitStop::faceDirection),
+		field("setTurretDirection", &UnitStop::turretDirection),
+		field("setTurretToDirection", &UnitStop::turretToDirection),
+		field("tu", &UnitStop::tu),
+		field("energy", &UnitStop::energy));
+};
+
+template<> struct Schema<UnitTurn>
+{
+	static constexpr const char *state = "turnBattlescapeUnit";
+	static constexpr auto fields = std::make_tuple(
+		field("id", &UnitTurn::id),
+		field("coords", &UnitTurn::coords),
+		field("isActionTypeNone", &UnitTurn::actionTypeNone),
+		field("tu", &UnitTurn::tu),
+		field("energy", &UnitTurn::energy),
+		field("health", &UnitTurn::health),
+		field("morale", &UnitTurn::morale),
+		field("stunlevel", &UnitTurn::stunlevel),
+		field("mana", &UnitTurn::mana));
+};
+
+template<> struct Schema<UnitFacing>
+{
+	static constexpr const char *state = "afterBattlescapeUnitTurn";
+	static constexpr auto fields = std::make_tuple(
+		field("setDirection", &UnitFacing::direction),
+		field("setFaceDirection", &UnitFacing::faceDirection),
+		field("setTurretDirection", &UnitFacing::turretDirection),
+		field("setTurretToDirection", &UnitFacing::turretToDirection),
+		field("unit_id", &UnitFacing::unitId));
+};
+
+template<> struct Schema<ProjectileFly>
+{
+	static constexpr const char *state = "ProjectileFlyBState";
+	static constexpr auto fields = std::make_tuple(
+		field("actor_id", &ProjectileFly::actorId),
+		field("actor_tu", &ProjectileFly::actorTu),
+		field("actor_energy", &ProjectileFly::actorEnergy),
+		field("actor_morale", &ProjectileFly::actorMorale),
+		field("actor_health", &ProjectileFly::actorHealth),
+		field("actor_mana", &ProjectileFly::actorMana),
+		field("actor_stun", &ProjectileFly::actorStun),
+		field("actor_no_line_fire", &ProjectileFly::actorNoLineFire),
+		field("actor_unable_to_throw_here", &ProjectileFly::actorUnableToThrowHere),
+		field("type", &ProjectileFly::type),
+		field("hand", &ProjectileFly::hand),
+		field("fusetimer", &ProjectileFly::fuseTimer),
+		field("fuse", &ProjectileFly::fuse),
+		field("coords", &ProjectileFly::coords),
+		field("targeting", &ProjectileFly::targeting),
+		field("weapon_type", &ProjectileFly::weaponType),
+		field("projectiles", &ProjectileFly::projectiles),
+		field("ammo_type", &ProjectileFly::ammoType),
+		field("ammo_id", &ProjectileFly::ammoId),
+		field<ListPosKeys>("waypoints", &ProjectileFly::waypoints),
+		field<ListPosKeys>("trajectory", &ProjectileFly::trajectory));
+};
+
+template<> struct Schema<ProjectileLanded>
+{
+	static constexpr const char *state = "hasHitUnit";
+	static constexpr auto fields = std::make_tuple();
+};
+
+template<> struct Schema<UnitHit>
+{
+	static constexpr const char *state = "hit_unit";
+	static constexpr auto fields = std::make_tuple(
+		field("unit_id", &UnitHit::unitId),
+		field("health", &UnitHit::health),
+		field("stunlevel", &UnitHit::stunlevel),
+		field("fatalWounds", &UnitHit::fatalWounds));
+};
+
+template<> struct Schema<TileHit>
+{
+	static constexpr const char *state = "hit_tile";
+	static constexpr auto fields = std::make_tuple(
+		inlined<CenterKeys>(&TileHit::center),
+		field("power", &TileHit::power),
+		field("rangeAtack", &TileHit::rangeAtack),
+		field("terrainMeleeTilePart", &TileHit::terrainMeleeTilePart),
+		field("seed", &TileHit::seed),
+		field("smokeRNG", &TileHit::smokeRNG),
+		inlined(&TileHit::damageType),
+		field("RandomType", &TileHit::randomType),
+		field("ResistType", &TileHit::resistType));
+};
+
+template<> struct Schema<AIProgress>
+{
+	static constexpr const char *state = "update_progress";
+	static constexpr auto fields = std::make_tuple(
+		field("ret", &AIProgress::ret),
+		field("selected_unit_id", &AIProgress::selectedUnitId),
+		field("AISecondMove", &AIProgress::secondMove));
+};
+
+}
+
+}
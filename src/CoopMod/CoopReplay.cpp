@@ -0,0 +1,285 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ * Copyright 2023-2026 XComCoopTeam (https://www.moddb.com/mods/openxcom-coop-mod)
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CoopReplay.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <json/json.h>
+#include "connectionTCP.h"
+#include "../Engine/Profiler.h"
+
+namespace OpenXcom
+{
+
+namespace CoopReplay
+{
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+/// A captured inbound message and when it arrived.
+struct Feed
+{
+	uint64_t timeUs;
+	std::string payload;
+};
+
+std::thread feeder;
+std::atomic<bool> stopping(false);
+std::mutex stopMutex;
+std::condition_variable stopSignal;
+std::atomic<uint64_t> total(0), fed(0);
+std::atomic<bool> fedAll(false);
+
+std::mutex sentMutex;
+std::map<std::string, uint64_t> sent;
+std::map<std::string, uint64_t> capturedSent;
+
+// main thread only
+bool active = false;
+Clock::time_point startedAt, lastHandledAt;
+uint64_t handled = 0;
+std::unordered_map<std::string, HandlerStats> handlers;
+
+/**
+ * Takes everything the game queued for the peer, like the transport
+ * thread would, and counts it by type.
+ */
+void drainTx()
+{
+	std::string msg;
+	while (g_txQ.pop(msg) || popSnapshot(msg))
+	{
+		std::string name = messageName(msg);
+		std::lock_guard<std::mutex> lock(sentMutex);
+		sent[name]++;
+	}
+}
+
+/**
+ * Sleeps a little, or less if stop() is called meanwhile.
+ * @return False once the replay has to stop.
+ */
+bool idle(std::chrono::microseconds wait)
+{
+	std::unique_lock<std::mutex> lock(stopMutex);
+	return !stopSignal.wait_for(lock, wait, [] { return stopping.load(); });
+}
+
+void feederLoop(std::vector<Feed> feed, double speed)
+{
+	Profiler::setThreadName("coop replay");
+	Clock::time_point begin = Clock::now();
+	uint64_t firstUs = feed.empty() ? 0 : feed.front().timeUs;
+	for (Feed &f : feed)
+	{
+		if (speed > 0)
+		{
+			Clock::time_point due = begin + std::chrono::microseconds((int64_t)((f.timeUs - firstUs) / speed));
+			for (Clock::time_point now = Clock::now(); now < due; now = Clock::now())
+			{
+				drainTx();
+				auto left = std::chrono::duration_cast<std::chrono::microseconds>(due - now);
+				if (!idle(std::min(left, std::chrono::microseconds(1000))))
+				{
+					return;
+				}
+			}
+		}
+		// never drop: at full speed the RX queue is what paces the replay
+		while (!g_rxQ.push(std::move(f.payload)))
+		{
+			drainTx();
+			if (!idle(std::chrono::microseconds(200)))
+			{
+				return;
+			}
+		}
+		fed++;
+		drainTx();
+	}
+	fedAll = true;
+	// the game keeps answering until the replay is stopped
+	do
+	{
+		drainTx();
+	}
+	while (idle(std::chrono::microseconds(5000)));
+}
+
+}
+
+/**
+ * Starts a replay, stopping the previous one. The caller sets the session
+ * up like a freshly connected client first.
+ * @param records Capture to play, in capture order.
+ * @param speed Multiple of the recorded pace, or 0 to feed as fast as possible.
+ */
+void start(const std::vector<CoopCapture::Record> &records, double speed)
+{
+	static bool stopAtExit = false;
+	if (!stopAtExit)
+	{
+		// a still running std::thread would terminate the program on shutdown
+		std::atexit(stop);
+		stopAtExit = true;
+	}
+	stop();
+
+	std::vector<Feed> feed;
+	std::map<std::string, uint64_t> captured;
+	for (const auto &r : records)
+	{
+		std::string name = messageName(r.payload);
+		if (r.flags & CoopCapture::OUTBOUND)
+		{
+			captured[name]++;
+		}
+		else if (name != "PING" && name != "PONG")
+		{
+			feed.push_back(Feed{ r.timeUs, r.payload });
+		}
+	}
+	{
+		std::lock_guard<std::mutex> lock(sentMutex);
+		sent.clear();
+		capturedSent.swap(captured);
+	}
+	total = feed.size();
+	fed = 0;
+	fedAll = false;
+	handled = 0;
+	handlers.clear();
+	startedAt = lastHandledAt = Clock::now();
+	active = true;
+	stopping = false;
+	feeder = std::thread(feederLoop, std::move(feed), speed);
+}
+
+/**
+ * Stops the replay thread. Whatever it already fed stays queued.
+ */
+void stop()
+{
+	if (!feeder.joinable())
+	{
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(stopMutex);
+		stopping = true;
+	}
+	stopSignal.notify_one();
+	feeder.join();
+	active = false;
+}
+
+/**
+ * @return True from start() until stop().
+ */
+bool isActive()
+{
+	return active;
+}
+
+/**
+ * Gets the replay's progress, the main-thread cost per message type
+ * (slowest in total first) and what was sent back. Main thread only.
+ * @return The report.
+ */
+Report getReport()
+{
+	Report report;
+	report.active = active;
+	report.fedAll = fedAll;
+	report.total = total;
+	report.fed = fed;
+	report.handled = handled;
+	report.wallMs = std::chrono::duration<double, std::milli>(lastHandledAt - startedAt).count();
+	for (const auto &i : handlers)
+	{
+		report.handlers.push_back(i.second);
+	}
+	std::sort(report.handlers.begin(), report.handlers.end(), [](const HandlerStats &a, const HandlerStats &b) { return a.totalMs > b.totalMs; });
+	std::lock_guard<std::mutex> lock(sentMutex);
+	report.sent = sent;
+	report.capturedSent = capturedSent;
+	return report;
+}
+
+/**
+ * @param payload Message body.
+ * @return Its "state", or its "type" for transport messages like PING.
+ */
+std::string messageName(const std::string &payload)
+{
+	Json::CharReaderBuilder rb;
+	std::unique_ptr<Json::CharReader> reader(rb.newCharReader());
+	Json::Value obj;
+	std::string errs;
+	if (!reader->parse(payload.data(), payload.data() + payload.size(), &obj, &errs) || !obj.isObject())
+	{
+		return "(invalid)";
+	}
+	if (obj.isMember("state"))
+	{
+		return obj["state"].asString();
+	}
+	return obj.get("type", "defaultState").asString();
+}
+
+HandlerTimer::HandlerTimer(const std::string &name) : _name(name), _active(active)
+{
+	if (_active)
+	{
+		_start = Clock::now();
+	}
+}
+
+HandlerTimer::~HandlerTimer()
+{
+	if (!_active)
+	{
+		return;
+	}
+	Clock::time_point end = Clock::now();
+	double ms = std::chrono::duration<double, std::milli>(end - _start).count();
+	HandlerStats &stats = handlers[_name];
+	if (stats.count == 0)
+	{
+		stats.name = _name;
+	}
+	stats.count++;
+	stats.totalMs += ms;
+	stats.maxMs = std::max(stats.maxMs, ms);
+	handled++;
+	lastHandledAt = end;
+}
+
+}
+
+}
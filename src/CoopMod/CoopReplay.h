@@ -0,0 +1,95 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ * Copyright 2023-2026 XComCoopTeam (https://www.moddb.com/mods/openxcom-coop-mod)
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "CoopCapture.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Plays the inbound side of a packet capture back into this instance.
+ * A replay thread stands in for the transport: it pushes the captured
+ * messages into the RX queue, at the recorded pace or as fast as the
+ * queue takes them, and drains whatever the game sends back. The main
+ * thread consumes them through the normal updateCoopTask() path, which
+ * times every onTCPMessage() call per message type while a replay runs.
+ *
+ * PING and PONG are answered by the transport itself and never reach
+ * the game, so they are left out of the replay.
+ */
+namespace CoopReplay
+{
+	/// Main-thread cost of one message type.
+	struct HandlerStats
+	{
+		std::string name;
+		uint64_t count;
+		double totalMs, maxMs;
+	};
+
+	/// Progress and results of the current or last replay.
+	struct Report
+	{
+		bool active, fedAll;
+		uint64_t total, fed, handled;
+		/// From start() to the last handled message.
+		double wallMs;
+		std::vector<HandlerStats> handlers;
+		/// Messages the game sent during the replay, by type.
+		std::map<std::string, uint64_t> sent;
+		/// Messages sent in the captured session, by type.
+		std::map<std::string, uint64_t> capturedSent;
+	};
+
+	/// Starts feeding a capture into the RX queue.
+	void start(const std::vector<CoopCapture::Record> &records, double speed);
+	/// Stops the replay thread.
+	void stop();
+	/// Checks if a replay is running.
+	bool isActive();
+	/// Gets the replay's progress and timings.
+	Report getReport();
+	/// Gets the type name of a message, as updateCoopTask() dispatches it.
+	std::string messageName(const std::string &payload);
+
+	/**
+	 * Times one message handler for the replay report; does nothing
+	 * while no replay runs. Main thread only.
+	 */
+	class HandlerTimer
+	{
+		const std::string &_name;
+		bool _active;
+		std::chrono::steady_clock::time_point _start;
+	public:
+		/// Starts timing a handler.
+		HandlerTimer(const std::string &name);
+		/// Adds the elapsed time to the handler's stats.
+		~HandlerTimer();
+	};
+}
+
+}
@@ -0,0 +1,423 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ * Copyright 2023-2026 XComCoopTeam (https://www.moddb.com/mods/openxcom-coop-mod)
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "HostFanout.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "../Engine/Logger.h"
+#include "../Engine/Profiler.h"
+
+namespace OpenXcom
+{
+
+namespace HostFanout
+{
+
+namespace
+{
+
+/// Enough for every CoopSnapSlot.
+const int MaxSlots = 8;
+/// Reliable bytes a peer may have waiting before it counts as stuck.
+const size_t QueueLimit = 16 * 1024 * 1024;
+/// One write takes at most this many queued messages...
+const size_t MaxBatchFrames = 64;
+/// ...or about this many bytes.
+const size_t MaxBatchBytes = 256 * 1024;
+
+/// A framed message, shared by every peer that still has to send it.
+typedef std::shared_ptr<const std::string> Frame;
+
+struct Peer
+{
+	int id = 0;
+	TCPsocket sock = nullptr;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::deque<Frame> queue;
+	size_t queuedBytes = 0, peakQueuedBytes = 0;
+	bool stopping = false;
+	bool overflowed = false;
+	/// Snapshot generation this peer sent last, per slot. Send thread only.
+	std::array<uint64_t, MaxSlots> snapshotSent{};
+	std::atomic<bool> failed{false};
+	std::atomic<uint64_t> sentBytes{0}, sentFrames{0};
+	std::atomic<uint64_t> snapshotsSent{0}, snapshotsSkipped{0};
+};
+
+std::mutex peersMutex;
+std::vector<std::shared_ptr<Peer>> peers;
+int nextId = 1;
+
+std::mutex snapshotMutex;
+std::array<Frame, MaxSlots> snapshots;
+/// Bumped on every publishSnapshot(), read without the lock for wake checks.
+std::array<std::atomic<uint64_t>, MaxSlots> snapshotGen{};
+
+Frame frame(const std::string &payload)
+{
+	auto out = std::make_shared<std::string>();
+	uint32_t be = SDL_SwapBE32((uint32_t)payload.size());
+	out->resize(4 + payload.size());
+	std::memcpy(&(*out)[0], &be, 4);
+	std::memcpy(&(*out)[4], payload.data(), payload.size());
+	return out;
+}
+
+bool hasNewSnapshot(const Peer &peer)
+{
+	for (int i = 0; i < MaxSlots; ++i)
+	{
+		if (snapshotGen[i].load(std::memory_order_acquire) != peer.snapshotSent[i])
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Adds the freshest value of every snapshot slot this peer hasn't sent yet.
+ */
+void appendSnapshots(Peer &peer, std::string &out)
+{
+	if (!hasNewSnapshot(peer))
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> lock(snapshotMutex);
+	for (int i = 0; i < MaxSlots; ++i)
+	{
+		uint64_t gen = snapshotGen[i].load(std::memory_order_relaxed);
+		if (gen == peer.snapshotSent[i] || !snapshots[i])
+		{
+			continue;
+		}
+		out += *snapshots[i];
+		peer.snapshotsSent++;
+		peer.snapshotsSkipped += gen - peer.snapshotSent[i] - 1;
+		peer.snapshotSent[i] = gen;
+	}
+}
+
+bool sendAll(TCPsocket sock, const std::string &data)
+{
+	size_t sent = 0;
+	while (sent < data.size())
+	{
+		int n = SDLNet_TCP_Send(sock, data.data() + sent, (int)(data.size() - sent));
+		if (n <= 0)
+		{
+			return false;
+		}
+		sent += n;
+	}
+	return true;
+}
+
+void senderLoop(std::shared_ptr<Peer> peer)
+{
+	Profiler::setThreadName("coop host send");
+	std::vector<Frame> batch;
+	std::string out;
+	for (;;)
+	{
+		batch.clear();
+		{
+			std::unique_lock<std::mutex> lock(peer->mutex);
+			peer->wake.wait(lock, [&] { return peer->stopping || !peer->queue.empty() || hasNewSnapshot(*peer); });
+			if (peer->stopping)
+			{
+				break;
+			}
+			size_t bytes = 0;
+			while (!peer->queue.empty() && batch.size() < MaxBatchFrames && bytes < MaxBatchBytes)
+			{
+				bytes += peer->queue.front()->size();
+				batch.push_back(std::move(peer->queue.front()));
+				peer->queue.pop_front();
+			}
+			peer->queuedBytes -= bytes;
+		}
+
+		PROFILE_ZONE("HostFanout::send");
+		out.clear();
+		for (const Frame &f : batch)
+		{
+			out += *f;
+		}
+		// snapshots ride the same write as the reliable batch
+		appendSnapshots(*peer, out);
+		if (!sendAll(peer->sock, out))
+		{
+			// the host thread still reads from the socket, wait for detach()
+			peer->failed = true;
+			std::unique_lock<std::mutex> lock(peer->mutex);
+			peer->wake.wait(lock, [&] { return peer->stopping; });
+			break;
+		}
+		peer->sentBytes += out.size();
+		peer->sentFrames += batch.size();
+	}
+	SDLNet_TCP_Close(peer->sock);
+}
+
+void stopPeer(Peer &peer)
+{
+	{
+		std::lock_guard<std::mutex> lock(peer.mutex);
+		peer.stopping = true;
+		peer.queue.clear();
+		peer.queuedBytes = 0;
+	}
+	peer.wake.notify_one();
+}
+
+/**
+ * Queues a frame for one peer, or flags it if its backlog is over the limit.
+ */
+void queueFrame(Peer &peer, const Frame &f)
+{
+	{
+		std::lock_guard<std::mutex> lock(peer.mutex);
+		if (peer.stopping || peer.overflowed)
+		{
+			return;
+		}
+		if (peer.queuedBytes + f->size() > QueueLimit)
+		{
+			peer.overflowed = true;
+			peer.failed = true;
+			return;
+		}
+		peer.queue.push_back(f);
+		peer.queuedBytes += f->size();
+		peer.peakQueuedBytes = std::max(peer.peakQueuedBytes, peer.queuedBytes);
+	}
+	peer.wake.notify_one();
+}
+
+}
+
+/**
+ * Starts serving a newly accepted client. Its messages are sent from a
+ * thread of its own, which also owns the socket from now on.
+ * @param sock Client socket.
+ * @return Peer ID for detach() and sendTo().
+ */
+int attach(TCPsocket sock)
+{
+	auto peer = std::make_shared<Peer>();
+	peer->sock = sock;
+	{
+		std::lock_guard<std::mutex> lock(snapshotMutex);
+		// a new client starts from the current snapshots
+		for (int i = 0; i < MaxSlots; ++i)
+		{
+			uint64_t gen = snapshotGen[i].load(std::memory_order_relaxed);
+			peer->snapshotSent[i] = gen > 0 ? gen - 1 : 0;
+		}
+	}
+	{
+		std::lock_guard<std::mutex> lock(peersMutex);
+		peer->id = nextId++;
+		peers.push_back(peer);
+	}
+	// detached: a send blocked on a dead link must not block the host thread
+	std::thread(senderLoop, peer).detach();
+	return peer->id;
+}
+
+/**
+ * Stops serving a client. Whatever it still had queued is discarded, and
+ * its thread closes the socket as soon as it's not stuck in a send.
+ * @param id Peer ID.
+ */
+void detach(int id)
+{
+	std::shared_ptr<Peer> peer;
+	{
+		std::lock_guard<std::mutex> lock(peersMutex);
+		for (auto i = peers.begin(); i != peers.end(); ++i)
+		{
+			if ((*i)->id == id)
+			{
+				peer = *i;
+				peers.erase(i);
+				break;
+			}
+		}
+	}
+	if (peer)
+	{
+		stopPeer(*peer);
+	}
+}
+
+/**
+ * Detaches every peer and forgets the snapshots, for the end of a session.
+ */
+void stop()
+{
+	std::vector<std::shared_ptr<Peer>> old;
+	{
+		std::lock_guard<std::mutex> lock(peersMutex);
+		old.swap(peers);
+	}
+	for (auto &peer : old)
+	{
+		stopPeer(*peer);
+	}
+	std::lock_guard<std::mutex> lock(snapshotMutex);
+	for (int i = 0; i < MaxSlots; ++i)
+	{
+		snapshots[i].reset();
+	}
+}
+
+/**
+ * Frames a message once and queues it for every peer.
+ * @param payload Message body.
+ */
+void publish(const std::string &payload)
+{
+	Frame f = frame(payload);
+	std::lock_guard<std::mutex> lock(peersMutex);
+	for (auto &peer : peers)
+	{
+		queueFrame(*peer, f);
+	}
+}
+
+/**
+ * Queues a message for one peer only, like a reply to its ping.
+ * @param id Peer ID.
+ * @param payload Message body.
+ */
+void sendTo(int id, const std::string &payload)
+{
+	std::lock_guard<std::mutex> lock(peersMutex);
+	for (auto &peer : peers)
+	{
+		if (peer->id == id)
+		{
+			queueFrame(*peer, frame(payload));
+			return;
+		}
+	}
+}
+
+/**
+ * Replaces a snapshot slot. Every peer sends the value current at its
+ * next write, skipping any it didn't get to.
+ * @param slot Snapshot slot.
+ * @param payload Message body.
+ */
+void publishSnapshot(int slot, const std::string &payload)
+{
+	if (slot < 0 || slot >= MaxSlots)
+	{
+		return;
+	}
+	Frame f = frame(payload);
+	{
+		std::lock_guard<std::mutex> lock(snapshotMutex);
+		snapshots[slot] = f;
+		snapshotGen[slot].fetch_add(1, std::memory_order_release);
+	}
+	std::lock_guard<std::mutex> lock(peersMutex);
+	for (auto &peer : peers)
+	{
+		// the send thread checks the generation under its own lock
+		{
+			std::lock_guard<std::mutex> peerLock(peer->mutex);
+		}
+		peer->wake.notify_one();
+	}
+}
+
+/**
+ * Gets the peers that have to be dropped: their send failed, or their
+ * backlog went over the limit.
+ * @return Peer IDs, each reported once.
+ */
+std::vector<int> takeFailed()
+{
+	std::vector<int> failed;
+	std::lock_guard<std::mutex> lock(peersMutex);
+	for (auto &peer : peers)
+	{
+		if (peer->failed.exchange(false))
+		{
+			if (peer->overflowed)
+			{
+				Log(LOG_WARNING) << "[coop] client " << peer->id << " fell " << peer->queuedBytes << " bytes behind, dropping it";
+			}
+			failed.push_back(peer->id);
+		}
+	}
+	return failed;
+}
+
+/**
+ * @return Number of clients being served.
+ */
+size_t getPeerCount()
+{
+	std::lock_guard<std::mutex> lock(peersMutex);
+	return peers.size();
+}
+
+/**
+ * Gets a snapshot of the counters.
+ * @return One entry per attached peer, oldest first.
+ */
+std::vector<PeerStats> getStats()
+{
+	std::vector<PeerStats> stats;
+	std::lock_guard<std::mutex> lock(peersMutex);
+	for (auto &peer : peers)
+	{
+		PeerStats s;
+		{
+			std::lock_guard<std::mutex> peerLock(peer->mutex);
+			s.queuedBytes = peer->queuedBytes;
+			s.peakQueuedBytes = peer->peakQueuedBytes;
+			s.overflowed = peer->overflowed;
+		}
+		s.id = peer->id;
+		s.sentBytes = peer->sentBytes.load();
+		s.sentFrames = peer->sentFrames.load();
+		s.snapshotsSent = peer->snapshotsSent.load();
+		s.snapshotsSkipped = peer->snapshotsSkipped.load();
+		stats.push_back(s);
+	}
+	return stats;
+}
+
+}
+
+}
@@ -0,0 +1,80 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ * Copyright 2023-2026 XComCoopTeam (https://www.moddb.com/mods/openxcom-coop-mod)
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <SDL_net.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Outbound side of the TCP host: one send queue and one send thread per
+ * connected client. The host thread frames each outgoing message once and
+ * every peer queues a reference to the same buffer, so N clients cost one
+ * serialization. Conflated snapshots are kept once too, with a generation
+ * counter; each peer remembers the last generation it sent, so a slow peer
+ * just skips to the freshest value instead of backing up.
+ *
+ * A peer that can't keep up only blocks its own send thread. If its
+ * reliable backlog grows past the limit it is flagged, and the host thread
+ * drops it with takeFailed(); the others never wait for it.
+ *
+ * Sockets given to attach() belong to the peer's send thread from then on:
+ * it closes them once detach() told it to stop. The host thread keeps
+ * reading from them until it calls detach().
+ */
+namespace HostFanout
+{
+	/// Counters of one peer.
+	struct PeerStats
+	{
+		int id;
+		size_t queuedBytes, peakQueuedBytes;
+		uint64_t sentBytes, sentFrames;
+		uint64_t snapshotsSent, snapshotsSkipped;
+		bool overflowed;
+	};
+
+	/// Starts a send thread for a newly accepted client.
+	int attach(TCPsocket sock);
+	/// Stops a peer; its thread closes the socket.
+	void detach(int id);
+	/// Detaches every peer and forgets the snapshots.
+	void stop();
+	/// Queues a message for every peer.
+	void publish(const std::string &payload);
+	/// Queues a message for a single peer.
+	void sendTo(int id, const std::string &payload);
+	/// Replaces the value of a conflated snapshot slot.
+	void publishSnapshot(int slot, const std::string &payload);
+	/// Gets the peers whose connection failed or fell too far behind.
+	std::vector<int> takeFailed();
+	/// Gets the number of attached peers.
+	size_t getPeerCount();
+	/// Gets a copy of every peer's counters.
+	std::vector<PeerStats> getStats();
+}
+
+}
@@ -116,7 +116,7 @@ namespace SharedEcon
 namespace {
 
 // ---- Command registry --------------------------------------------------------
-struct Handler { CmdValidator validate; CmdApplier apply; };
+struct Handler { CmdValidator validate; CmdApplier apply; CmdCoalesceKey coalesce; };
 std::unordered_map<std::string, Handler>& registry()
 {
 	static std::unordered_map<std::string, Handler> r;
@@ -136,10 +136,14 @@ struct PendingCmd
 	int baseId = -1;
 	Json::Value payload;
 	bool remote = false;
+	std::string key;                 // replica outgoing batch: coalescing key, "" = none
 };
+// Commands the host validates+applies as one unit (a single shared_cmd is a
+// batch of one). All entries come from the same seat.
+using PendingBatch = std::vector<PendingCmd>;
 
 std::mutex g_mx;                     // guards the four queues below
-std::deque<PendingCmd>  g_cmdQ;      // host:      to validate+apply+broadcast
+std::deque<PendingBatch> g_cmdQ;     // host:      to validate+apply+broadcast
 std::deque<Json::Value> g_applyQ;    // replica:   shared_apply to apply
 std::deque<std::string> g_failQ;     // initiator: shared_fail reasons to surface
 int g_resyncServeQ = 0;              // host:      pending shared_resync_requests
@@ -147,12 +151,25 @@ int g_resyncServeQ = 0;              // host:      pending shared_resync_request
 // Per-machine monotonic command sequence stamp (protocol `seq`).
 std::atomic<int> g_seqCounter{0};
 
+// Replica: commands waiting to go out as one envelope, sent by update().
+// Main thread only (submitLocalCmd and update both run there), so no lock.
+std::vector<PendingCmd> g_outBatch;
+// When the oldest waiting command was queued, and the screen on top then.
+std::chrono::steady_clock::time_point g_outBatchStart;
+const State* g_outBatchScreen = nullptr;
+// A batch this long goes out at once instead of waiting for the frame to end.
+const size_t MaxBatch = 64;
+// How long a batch ending in a coalescable command waits for more clicks.
+const std::chrono::milliseconds BatchHold(250);
+
 // ---- Diagnostics (harness-observable) ----------------------------------------
 std::atomic<uint64_t> g_cmdN{0};     // shared_cmd this host validated
 std::atomic<uint64_t> g_okN{0};      // shared_ok sent (host) / received (client)
 std::atomic<uint64_t> g_failN{0};    // shared_fail surfaced (initiator) / sent (host)
 std::atomic<uint64_t> g_applyN{0};   // shared_apply applied by this machine
 std::atomic<uint64_t> g_unknownN{0}; // shared_cmd naming an unregistered cmd
+std::atomic<uint64_t> g_sentN{0};    // shared_cmd/shared_batch envelopes sent (replica)
+std::atomic<uint64_t> g_batchN{0};   // shared_batch envelopes received (host)
 std::mutex g_failMx;
 std::string g_lastFail;
 
@@ -189,6 +206,29 @@ Base* resolveBase(Game* game, int baseId)
 	return (*bases)[baseId];
 }
 
+// Payloads carry rule type names, not rule IDs: IDs are handed out at load and
+// only match between peers running the same mods. A name is turned into its ID
+// once and the rule read from the ID-indexed array.
+RuleItem* resolveItem(Mod* mod, const std::string& type)
+{
+	return mod->getItemById(mod->getRuleId(type));
+}
+
+Armor* resolveArmor(Mod* mod, const std::string& type)
+{
+	return mod->getArmorById(mod->getRuleId(type));
+}
+
+Unit* resolveUnit(Mod* mod, const std::string& type)
+{
+	return mod->getUnitById(mod->getRuleId(type));
+}
+
+RuleResearch* resolveResearch(Mod* mod, const std::string& type)
+{
+	return mod->getResearchById(mod->getRuleId(type));
+}
+
 void setLastFail(const std::string& reason)
 {
 	std::lock_guard<std::mutex> lk(g_failMx);
@@ -333,7 +373,7 @@ bool buyValidate(Game* game, const Json::Value& payload, Base* base, int /*seat*
 		{
 		case TRANSFER_ITEM:
 		{
-			RuleItem* r = mod->getItem(rule, false);
+			RuleItem* r = resolveItem(mod, rule);
 			if (!r) { failReason = "unknown item: " + rule; return false; }
 			total += (int64_t)qty * r->getBuyCostAdjusted(base, save);
 			storeAdd += (double)qty * r->getSize();
@@ -414,7 +454,7 @@ void buyApply(Game* game, Json::Value& payload, Base* base, int seat)
 		{
 		case TRANSFER_ITEM:
 		{
-			RuleItem* r = mod->getItem(rule, false);
+			RuleItem* r = resolveItem(mod, rule);
 			if (!r) break;
 			if (r->getMonthlyBuyLimit() > 0) limitLog[r->getType()] += qty;
 			Transfer* t = new Transfer(r->getTransferTime());
@@ -535,7 +575,7 @@ bool sellValidate(Game* game, const Json::Value& payload, Base* base, int /*seat
 			std::string rule = it.get("rule", "").asString();
 			int qty = it.get("qty", 0).asInt();
 			if (qty <= 0) continue;
-			RuleItem* r = mod->getItem(rule, false);
+			RuleItem* r = resolveItem(mod, rule);
 			if (!r) { failReason = "unknown item: " + rule; return false; }
 			if (base->getStorageItems()->getItem(r) < qty)
 				{ failReason = "STR_NOT_ENOUGH_ITEMS_TO_SELL"; return false; }
@@ -584,7 +624,7 @@ void sellApply(Game* game, Json::Value& payload, Base* base, int /*seat*/)
 		for (const auto& it : items)
 		{
 			int qty = it.get("qty", 0).asInt();
-			RuleItem* r = mod->getItem(it.get("rule", "").asString(), false);
+			RuleItem* r = resolveItem(mod, it.get("rule", "").asString());
 			if (r && qty > 0) base->getStorageItems()->removeItem(r, qty);
 		}
 
@@ -644,7 +684,7 @@ bool containmentValidate(Game* game, const Json::Value& payload, Base* base, int
 		std::string rule = p.get("rule", "").asString();
 		int qty = p.get("qty", 0).asInt();
 		if (qty <= 0) continue;
-		RuleItem* r = mod->getItem(rule, false);
+		RuleItem* r = resolveItem(mod, rule);
 		if (!r) { failReason = "unknown alien: " + rule; return false; }
 		if (base->getStorageItems()->getItem(r) < qty)
 			{ failReason = "STR_NOT_ENOUGH_PRISONERS"; return false; }
@@ -668,13 +708,13 @@ void containmentApply(Game* game, Json::Value& payload, Base* base, int /*seat*/
 		std::string rule = p.get("rule", "").asString();
 		int qty = p.get("qty", 0).asInt();
 		if (qty <= 0) continue;
-		RuleItem* r = mod->getItem(rule, false);
+		RuleItem* r = resolveItem(mod, rule);
 		if (!r) continue;
 		base->getStorageItems()->removeItem(r, qty);
 		if (!sell)
 		{
 			// Execute: leave the geoscape corpse behind (funds untouched).
-			Unit* ruleUnit = mod->getUnit(rule, false);
+			Unit* ruleUnit = resolveUnit(mod, rule);
 			if (ruleUnit)
 			{
 				auto* ruleCorpse = ruleUnit->getArmor()->getCorpseGeoscape();
@@ -721,7 +761,7 @@ bool transferValidate(Game* game, const Json::Value& payload, Base* fromBase, in
 			std::string rule = it.get("rule", "").asString();
 			int qty = it.get("qty", 0).asInt();
 			if (qty <= 0) continue;
-			RuleItem* r = mod->getItem(rule, false);
+			RuleItem* r = resolveItem(mod, rule);
 			if (!r) { failReason = "unknown item: " + rule; return false; }
 			if (fromBase->getStorageItems()->getItem(r) < qty)
 				{ failReason = "STR_NOT_ENOUGH_ITEMS_TO_TRANSFER"; return false; }
@@ -796,7 +836,7 @@ void transferApply(Game* game, Json::Value& payload, Base* fromBase, int /*seat*
 		for (const auto& it : items)
 		{
 			int qty = it.get("qty", 0).asInt();
-			RuleItem* r = mod->getItem(it.get("rule", "").asString(), false);
+			RuleItem* r = resolveItem(mod, it.get("rule", "").asString());
 			if (!r || qty <= 0) continue;
 			fromBase->getStorageItems()->removeItem(r, qty);
 			Transfer* t = new Transfer(time);
@@ -889,7 +929,7 @@ bool resStartValidate(Game* game, const Json::Value& payload, Base* base, int /*
 	Mod* mod = game->getMod();
 	if (!save || !mod) { failReason = "no world"; return false; }
 	std::string pname = payload.get("project", "").asString();
-	RuleResearch* rule = mod->getResearch(pname, false);
+	RuleResearch* rule = resolveResearch(mod, pname);
 	if (!rule) { failReason = "unknown research: " + pname; return false; }
 	// Availability = rules + not-already-running-here + needed item + base funcs.
 	std::vector<RuleResearch*> avail;
@@ -908,7 +948,7 @@ void resStartApply(Game* game, Json::Value& payload, Base* base, int /*seat*/)
 	Mod* mod = game->getMod();
 	if (!save || !mod) return;
 	std::string pname = payload.get("project", "").asString();
-	RuleResearch* rule = mod->getResearch(pname, false);
+	RuleResearch* rule = resolveResearch(mod, pname);
 	if (!rule) return;
 	if (findResearchProject(base, pname)) return; // idempotent guard
 
@@ -1886,7 +1926,7 @@ bool craftEquipValidate(Game* game, const Json::Value& payload, Base* base, int
 	cost = 0; // no funds effect; broadcast still carries authoritative getFunds()
 	if (!base) { failReason = "base not found"; return false; }
 	if (!resolveOrderCraft(game, payload, base)) { failReason = "craft not found"; return false; }
-	const RuleItem* item = game->getMod()->getItem(payload.get("item", "").asString(), false);
+	const RuleItem* item = resolveItem(game->getMod(), payload.get("item", "").asString());
 	if (!item) { failReason = "unknown item"; return false; }
 	if (item->getVehicleUnit()) { failReason = "vehicles not routed"; return false; }
 	return true;
@@ -1896,7 +1936,7 @@ void craftEquipApply(Game* game, Json::Value& payload, Base* base, int /*seat*/)
 {
 	if (!base) return;
 	Craft* craft = resolveOrderCraft(game, payload, base);
-	const RuleItem* item = game->getMod()->getItem(payload.get("item", "").asString(), false);
+	const RuleItem* item = resolveItem(game->getMod(), payload.get("item", "").asString());
 	if (!craft || !item || item->getVehicleUnit()) return;
 
 	ItemContainer* craftItems = craft->getItems();
@@ -2016,7 +2056,7 @@ bool soldierArmorValidate(Game* game, const Json::Value& payload, Base* base, in
 	cost = 0;
 	if (!base) { failReason = "base not found"; return false; }
 	if (!findSoldier(base, payload.get("soldierId", -1).asInt())) { failReason = "soldier not found"; return false; }
-	if (!game->getMod()->getArmor(payload.get("armor", "").asString(), false)) { failReason = "unknown armor"; return false; }
+	if (!resolveArmor(game->getMod(), payload.get("armor", "").asString())) { failReason = "unknown armor"; return false; }
 	return true;
 }
 
@@ -2024,7 +2064,7 @@ void soldierArmorApply(Game* game, Json::Value& payload, Base* base, int /*seat*
 {
 	if (!base) return;
 	Soldier* s = findSoldier(base, payload.get("soldierId", -1).asInt());
-	Armor* next = game->getMod()->getArmor(payload.get("armor", "").asString(), false);
+	Armor* next = resolveArmor(game->getMod(), payload.get("armor", "").asString());
 	if (!s || !next) return;
 	Armor* prev = s->getArmor();
 	if (prev == next) return; // idempotent
@@ -2282,7 +2322,7 @@ void alertApply(Game* game, Json::Value& payload, Base* base, int /*seat*/)
 	}
 	else if (cls == "ResearchRequiredState")
 	{
-		if (RuleItem* it = mod->getItem(msg, false)) gs->popup(new ResearchRequiredState(it));
+		if (RuleItem* it = resolveItem(mod, msg)) gs->popup(new ResearchRequiredState(it));
 	}
 	else if (cls == "GeoscapeEventState")
 	{
@@ -2291,7 +2331,7 @@ void alertApply(Game* game, Json::Value& payload, Base* base, int /*seat*/)
 	else if (cls == "NewPossibleResearchState")
 	{
 		std::vector<RuleResearch*> v;
-		for (const auto& n : names) if (auto* r = mod->getResearch(n, false)) v.push_back(r);
+		for (const auto& n : names) if (auto* r = resolveResearch(mod, n)) v.push_back(r);
 		if (base) gs->popup(new NewPossibleResearchState(base, v));
 	}
 	else if (cls == "NewPossibleManufactureState")
@@ -2303,7 +2343,7 @@ void alertApply(Game* game, Json::Value& payload, Base* base, int /*seat*/)
 	else if (cls == "NewPossiblePurchaseState")
 	{
 		std::vector<RuleItem*> v;
-		for (const auto& n : names) if (auto* r = mod->getItem(n, false)) v.push_back(r);
+		for (const auto& n : names) if (auto* r = resolveItem(mod, n)) v.push_back(r);
 		if (base) gs->popup(new NewPossiblePurchaseState(base, v));
 	}
 	else if (cls == "NewPossibleCraftState")
@@ -2350,10 +2390,10 @@ void researchDoneApply(Game* game, Json::Value& payload, Base* base, int /*seat*
 	if (!save || !mod) return;
 
 	const std::string rName = payload.get("research", "").asString();
-	RuleResearch* research = mod->getResearch(rName, false);
+	RuleResearch* research = resolveResearch(mod, rName);
 	if (!research) return;
 	const std::string bName = payload.get("bonus", "").asString();
-	RuleResearch* bonus = bName.empty() ? nullptr : mod->getResearch(bName, false);
+	RuleResearch* bonus = bName.empty() ? nullptr : resolveResearch(mod, bName);
 
 	// Remove the base's matching ResearchProject and free its scientists, exactly
 	// as the host's time1Day did. Mark it finished first so removeResearch() does
@@ -2384,7 +2424,7 @@ void researchDoneApply(Game* game, Json::Value& payload, Base* base, int /*seat*
 
 	// Mirror the host popup (coop=true -> the ctor does NOT re-broadcast).
 	const std::string nrName = payload.get("newResearch", "").asString();
-	const RuleResearch* newResearch = nrName.empty() ? nullptr : mod->getResearch(nrName, false);
+	const RuleResearch* newResearch = nrName.empty() ? nullptr : resolveResearch(mod, nrName);
 	game->pushState(new ResearchCompleteState(newResearch, bonus, research, base, true));
 }
 
@@ -2553,6 +2593,37 @@ void dayTickApply(Game* game, Json::Value& payload, Base* base, int /*seat*/)
 		}
 }
 
+// ---- Coalescing keys ---------------------------------------------------------
+// Only commands whose payload is the complete target state of what the key
+// names qualify: the last one wins no matter what the earlier ones said.
+// (craft_assign does not: "off this craft" depends on where the soldier is.)
+std::string craftEquipKey(const Json::Value& p)
+{
+	return craftKey(p.get("craftType", "").asString(), p.get("craftId", 0).asInt())
+		+ "|" + p.get("item", "").asString();
+}
+
+std::string craftRearmKey(const Json::Value& p)
+{
+	return craftKey(p.get("craftType", "").asString(), p.get("craftId", 0).asInt())
+		+ "|" + std::to_string(p.get("slot", -1).asInt());
+}
+
+std::string soldierArmorKey(const Json::Value& p)
+{
+	return std::to_string(p.get("soldierId", -1).asInt());
+}
+
+std::string resAllocKey(const Json::Value& p)
+{
+	return p.get("project", "").asString();
+}
+
+std::string manAllocKey(const Json::Value& p)
+{
+	return p.get("item", "").asString();
+}
+
 // ---- Host-side command processing (main thread) ------------------------------
 void rejectHostCmd(Game* game, const PendingCmd& pc, const std::string& reason)
 {
@@ -2575,73 +2646,146 @@ void rejectHostCmd(Game* game, const PendingCmd& pc, const std::string& reason)
 	}
 }
 
-void processHostCmd(Game* game, const PendingCmd& pc)
+/// The wire form of one applied (or batched) command.
+Json::Value cmdEntry(const PendingCmd& pc, const Json::Value& payload)
+{
+	Json::Value e;
+	e["cmd"] = pc.cmd;
+	e["seq"] = pc.seq;
+	e["baseId"] = pc.baseId;
+	e["payload"] = payload;
+	return e;
+}
+
+void processHostBatch(Game* game, const PendingBatch& batch)
 {
+	if (batch.empty()) return;
 	auto& reg = registry();
-	auto hit = reg.find(pc.cmd);
-	if (hit == reg.end())
+	SavedGame* save = game->getSavedGame();
+
+	// Run the commands in order, each validated against the world the previous
+	// ones left behind (a res_alloc may follow the res_start it needs). Appliers
+	// have no undo, so a rejection cannot roll the batch back: everything before
+	// it stands, it and everything after it is refused as one. Either way the
+	// peers see a single shared_apply carrying the funds after the whole batch.
+	Json::Value applied(Json::arrayValue);
+	std::vector<const PendingCmd*> done;
+	const PendingCmd* failed = nullptr;
+	std::string failReason;
+	for (const PendingCmd& pc : batch)
 	{
-		++g_unknownN;
-		rejectHostCmd(game, pc, "unknown command: " + pc.cmd);
-		return;
+		auto hit = reg.find(pc.cmd);
+		if (hit == reg.end())
+		{
+			++g_unknownN;
+			failed = &pc;
+			failReason = "unknown command: " + pc.cmd;
+			break;
+		}
+
+		Base* base = resolveBase(game, pc.baseId);
+		int64_t cost = 0;
+		failReason.clear();
+		++g_cmdN;
+		if (!hit->second.validate(game, pc.payload, base, pc.seat, cost, failReason))
+		{
+			failed = &pc;
+			if (failReason.empty()) failReason = "rejected";
+			break;
+		}
+
+		// Passed: debit the authoritative funds and apply. The applier gets a
+		// MUTABLE payload copy so it can resolve host-only RNG into it (e.g. buy
+		// serializes generated soldiers); the resolved payload is what we
+		// broadcast, so replicas reconstruct instead of re-rolling.
+		save->setFunds(save->getFunds() - cost);
+		Json::Value payload = pc.payload;
+		hit->second.apply(game, payload, base, pc.seat);
+		++g_applyN;
+		applied.append(cmdEntry(pc, payload));
+		done.push_back(&pc);
 	}
 
-	Base* base = resolveBase(game, pc.baseId);
-	int64_t cost = 0;
-	std::string failReason;
-	++g_cmdN;
-	if (!hit->second.validate(game, pc.payload, base, pc.seat, cost, failReason))
+	if (!done.empty())
 	{
-		rejectHostCmd(game, pc, failReason.empty() ? "rejected" : failReason);
-		return;
+		// Broadcast shared_apply (carrying the post-mutation funds) to every peer
+		// and shared_ok to the initiator. A lone command keeps the flat shape.
+		Json::Value apply;
+		if (done.size() == 1)
+		{
+			apply = applied[0];
+		}
+		else
+		{
+			apply["cmds"] = applied;
+		}
+		apply["state"] = "shared_apply";
+		apply["seat"] = batch.front().seat;
+		apply["funds"] = Json::Value::Int64(save->getFunds());
+		// GAP-9: carry the host's authoritative current-month income/expenditure tails
+		// (read AFTER apply, so they include any gross flow the applier booked, e.g. a
+		// prod_done that both sells and restarts a unit). The replica adopts these
+		// verbatim instead of net-inferring them from setFunds, keeping the Graphs->
+		// Finance series exactly the host's. Funds alone are not enough: the host's
+		// gross income/expenditure decomposition cannot be reconstructed from the net.
+		if (!save->getIncomes().empty())
+			apply["incTail"] = Json::Value::Int64(save->getIncomes().back());
+		if (!save->getExpenditures().empty())
+			apply["expTail"] = Json::Value::Int64(save->getExpenditures().back());
+		broadcast(game, apply);
+
+		if (batch.front().remote && game->getCoopMod())
+		{
+			Json::Value ok;
+			ok["state"] = "shared_ok";
+			ok["seq"] = done.back()->seq;
+			ok["count"] = (int)done.size();
+			game->getCoopMod()->sendTCPPacketData(ok.toStyledString());
+			++g_okN;
+		}
+
+		// PRD-J10: the host's own open screens are as stale as a replica's after an
+		// apply (a client's buy moves the host's funds too), so both roles notify.
+		for (const PendingCmd* pc : done)
+			fireApplyListener(pc->cmd, pc->baseId, pc->seat);
 	}
 
-	// Passed: debit the authoritative funds, apply the mutation, then broadcast
-	// shared_apply (carrying the post-mutation funds) to every peer and shared_ok
-	// to the initiator. The applier gets a MUTABLE payload copy so it can resolve
-	// host-only RNG into it (e.g. buy serializes generated soldiers); the resolved
-	// payload is what we broadcast, so replicas reconstruct instead of re-rolling.
-	SavedGame* save = game->getSavedGame();
-	save->setFunds(save->getFunds() - cost);
-	Json::Value payload = pc.payload;
-	hit->second.apply(game, payload, base, pc.seat);
+	if (failed)
+	{
+		size_t skipped = batch.size() - done.size() - 1;
+		if (skipped > 0)
+		{
+			Log(LOG_INFO) << "[SHARED] " << failed->cmd << " rejected (" << failReason
+				<< "); " << skipped << " later command(s) of the batch refused with it";
+		}
+		rejectHostCmd(game, *failed, failReason);
+	}
+}
+
+// ---- Replica-side apply (main thread) ----------------------------------------
+void applyEntry(Game* game, const Json::Value& entry, int seat)
+{
+	std::string cmd = entry.get("cmd", "").asString();
+	int baseId = entry.get("baseId", -1).asInt();
+	Base* base = resolveBase(game, baseId);
+	auto& reg = registry();
+	auto hit = reg.find(cmd);
+	// NOTE: no "!base" early-return here. A creation command (base_new) carries
+	// baseId=-1 (no existing base) and its applier ignores @a base; every OTHER
+	// applier already null-guards @a base itself (if (!base) return;), so passing a
+	// null base straight through is safe and keeps base creation working on replicas.
+	if (hit == reg.end()) return;
+
+	// Mutable copy for the applier signature; the replica only READS the resolved
+	// payload (host already resolved any RNG before broadcasting).
+	Json::Value payload = entry["payload"];
+	hit->second.apply(game, payload, base, seat);
 	++g_applyN;
 
-	Json::Value apply;
-	apply["state"] = "shared_apply";
-	apply["cmd"] = pc.cmd;
-	apply["seq"] = pc.seq;
-	apply["seat"] = pc.seat;
-	apply["baseId"] = pc.baseId;
-	apply["payload"] = payload;
-	apply["funds"] = Json::Value::Int64(save->getFunds());
-	// GAP-9: carry the host's authoritative current-month income/expenditure tails
-	// (read AFTER apply, so they include any gross flow the applier booked, e.g. a
-	// prod_done that both sells and restarts a unit). The replica adopts these
-	// verbatim instead of net-inferring them from setFunds, keeping the Graphs->
-	// Finance series exactly the host's. Funds alone are not enough: the host's
-	// gross income/expenditure decomposition cannot be reconstructed from the net.
-	if (!save->getIncomes().empty())
-		apply["incTail"] = Json::Value::Int64(save->getIncomes().back());
-	if (!save->getExpenditures().empty())
-		apply["expTail"] = Json::Value::Int64(save->getExpenditures().back());
-	broadcast(game, apply);
-
-	if (pc.remote && game->getCoopMod())
-	{
-		Json::Value ok;
-		ok["state"] = "shared_ok";
-		ok["seq"] = pc.seq;
-		game->getCoopMod()->sendTCPPacketData(ok.toStyledString());
-		++g_okN;
-	}
-
-	// PRD-J10: the host's own open screens are as stale as a replica's after an
-	// apply (a client's buy moves the host's funds too), so both roles notify.
-	fireApplyListener(pc.cmd, pc.baseId, pc.seat);
+	// PRD-J10: tell the open screen its world just moved under it.
+	fireApplyListener(cmd, baseId, seat);
 }
 
-// ---- Replica-side apply (main thread) ----------------------------------------
 void processApply(Game* game, const Json::Value& ap)
 {
 	SavedGame* save = game->getSavedGame();
@@ -2670,33 +2814,95 @@ void processApply(Game* game, const Json::Value& ap)
 		}
 	}
 
-	std::string cmd = ap.get("cmd", "").asString();
-	Base* base = resolveBase(game, ap.get("baseId", -1).asInt());
-	auto& reg = registry();
-	auto hit = reg.find(cmd);
-	// NOTE: no "!base" early-return here. A creation command (base_new) carries
-	// baseId=-1 (no existing base) and its applier ignores @a base; every OTHER
-	// applier already null-guards @a base itself (if (!base) return;), so passing a
-	// null base straight through is safe and keeps base creation working on replicas.
-	if (hit == reg.end()) return;
-
-	// Mutable copy for the applier signature; the replica only READS the resolved
-	// payload (host already resolved any RNG before broadcasting).
-	Json::Value payload = ap["payload"];
 	int seat = ap.get("seat", 0).asInt();
-	hit->second.apply(game, payload, base, seat);
-	++g_applyN;
+	const Json::Value& cmds = ap["cmds"];
+	if (cmds.isArray())
+	{
+		// A batch: the funds above are already the result of all of it.
+		for (const Json::Value& entry : cmds)
+			applyEntry(game, entry, seat);
+	}
+	else
+	{
+		applyEntry(game, ap, seat);
+	}
+}
 
-	// PRD-J10: tell the open screen its world just moved under it.
-	fireApplyListener(cmd, ap.get("baseId", -1).asInt(), seat);
+// ---- Replica-side outgoing batch (main thread) -------------------------------
+/// Sends the commands collected since the last flush as one envelope.
+void flushOutBatch(Game* game)
+{
+	if (g_outBatch.empty()) return;
+	Json::Value msg;
+	if (g_outBatch.size() == 1)
+	{
+		// A lone command keeps the plain shared_cmd shape.
+		msg = cmdEntry(g_outBatch[0], g_outBatch[0].payload);
+		msg["state"] = "shared_cmd";
+	}
+	else
+	{
+		Json::Value cmds(Json::arrayValue);
+		for (const PendingCmd& pc : g_outBatch)
+			cmds.append(cmdEntry(pc, pc.payload));
+		msg["state"] = "shared_batch";
+		msg["cmds"] = cmds;
+	}
+	msg["seat"] = g_outBatch[0].seat;
+	g_outBatch.clear();
+	++g_sentN;
+	if (game->getCoopMod()) game->getCoopMod()->sendTCPPacketData(msg.toStyledString());
+}
+
+/**
+ * Adds a command to the outgoing batch. If it carries a coalescing key, it
+ * replaces the last waiting command if that one has the same key. Older
+ * commands are left alone: commands queued after them may share a resource
+ * (scientists, craft space) and rely on the older value being applied first.
+ */
+void queueOutCmd(Game* game, PendingCmd&& pc)
+{
+	if (!pc.key.empty() && !g_outBatch.empty() && g_outBatch.back().key == pc.key)
+	{
+		g_outBatch.back().seq = pc.seq;
+		g_outBatch.back().payload = std::move(pc.payload);
+		return;
+	}
+	if (g_outBatch.empty())
+	{
+		g_outBatchStart = std::chrono::steady_clock::now();
+		g_outBatchScreen = game->getStates().empty() ? nullptr : game->getStates().back();
+	}
+	g_outBatch.push_back(std::move(pc));
+	if (g_outBatch.size() >= MaxBatch)
+		flushOutBatch(game);
+}
+
+/**
+ * Sends the outgoing batch if it is done collecting. A batch whose last
+ * command can't be coalesced goes at the end of the frame, nothing later
+ * could merge into it. Otherwise it waits up to BatchHold for repeated
+ * clicks, or until the screen it started on is closed or covered.
+ */
+void updateOutBatch(Game* game)
+{
+	if (g_outBatch.empty()) return;
+	const State* top = game->getStates().empty() ? nullptr : game->getStates().back();
+	if (g_outBatch.back().key.empty()
+		|| top != g_outBatchScreen
+		|| std::chrono::steady_clock::now() - g_outBatchStart >= BatchHold)
+	{
+		flushOutBatch(game);
+	}
 }
 
 } // anonymous namespace
 
 // ---- Public API --------------------------------------------------------------
-void registerCmd(const std::string& cmd, CmdValidator validate, CmdApplier apply)
+void registerCmd(const std::string& cmd, CmdValidator validate, CmdApplier apply,
+                 CmdCoalesceKey coalesce)
 {
-	registry()[cmd] = Handler{ std::move(validate), std::move(apply) };
+	registry()[cmd] = Handler{ std::move(validate), std::move(apply), std::move(coalesce) };
 }
 
 // ---- PRD-J10: apply notification ---------------------------------------------
@@ -2794,10 +3000,10 @@ void init()
 	registerCmd("transfer",    &transferValidate,    &transferApply);
 	// PRD-J06 research + manufacture commands (client -> host mutation requests).
 	registerCmd("res_start",   &resStartValidate,    &resStartApply);
-	registerCmd("res_alloc",   &resAllocValidate,    &resAllocApply);
+	registerCmd("res_alloc",   &resAllocValidate,    &resAllocApply,   &resAllocKey);
 	registerCmd("res_cancel",  &resCancelValidate,   &resCancelApply);
 	registerCmd("man_start",   &manStartValidate,    &manStartApply);
-	registerCmd("man_alloc",   &manAllocValidate,    &manAllocApply);
+	registerCmd("man_alloc",   &manAllocValidate,    &manAllocApply,   &manAllocKey);
 	registerCmd("man_cancel",  &manCancelValidate,   &manCancelApply);
 	// PRD-J07 facilities / bases (client -> host mutation requests).
 	registerCmd("fac_build",     &facBuildValidate,     &facBuildApply);
@@ -2818,11 +3024,11 @@ void init()
 	// PRD-J09: shared-world squad assembly (mixed-owner deployment).
 	registerCmd("craft_assign",   &craftAssignValidate, &craftAssignApply);
 	// PRD-J09 GAP-5: shared-world craft equipment loadout (base-screen equip).
-	registerCmd("craft_equip",    &craftEquipValidate,  &craftEquipApply);
+	registerCmd("craft_equip",    &craftEquipValidate,  &craftEquipApply,  &craftEquipKey);
 	// PRD-J09 GAP-5b: the sibling base-screen store mutators (arm/rearm a craft
 	// weapon; change a soldier's armor - SoldierArmorState + CraftArmorState).
-	registerCmd("craft_rearm",    &craftRearmValidate,  &craftRearmApply);
-	registerCmd("soldier_armor",  &soldierArmorValidate, &soldierArmorApply);
+	registerCmd("craft_rearm",    &craftRearmValidate,  &craftRearmApply,  &craftRearmKey);
+	registerCmd("soldier_armor",  &soldierArmorValidate, &soldierArmorApply, &soldierArmorKey);
 	// PRD-DF01 shared/replicated dogfights: host-originated membership broadcast
 	// (df_open, full set + epoch each change; replica reconciles its render-only
 	// windows). df_state (per-tick render frames) rides the SNAP_DOGFIGHT conflation
@@ -2861,8 +3067,8 @@ void init()
 void broadcast(Game* game, const Json::Value& msg)
 {
 	if (!game || !game->getCoopMod()) return;
-	// Transport is strictly 1:1 today (PRD-J01 audit); "broadcast" is a single
-	// peer send. When N-player TCP lands, only this body iterates the client set.
+	// The host transport fans every outbound message out to all attached clients
+	// (HostFanout), so "broadcast" is a plain send.
 	game->getCoopMod()->sendTCPPacketData(msg.toStyledString());
 }
 
@@ -2893,7 +3099,31 @@ bool onMessage(Game* game, const std::string& state, const Json::Value& obj)
 			pc.payload = obj["payload"];
 			pc.remote = true;
 			std::lock_guard<std::mutex> lk(g_mx);
-			g_cmdQ.push_back(std::move(pc));
+			g_cmdQ.push_back(PendingBatch{ std::move(pc) });
+		}
+		return true;
+	}
+	if (state == "shared_batch")
+	{
+		// Several shared_cmds from one replica frame, validated+applied as a unit.
+		if (isHost())
+		{
+			++g_batchN;
+			PendingBatch batch;
+			int seat = obj.get("seat", 0).asInt();
+			for (const Json::Value& e : obj["cmds"])
+			{
+				PendingCmd pc;
+				pc.cmd = e.get("cmd", "").asString();
+				pc.seq = e.get("seq", 0).asInt();
+				pc.seat = seat;
+				pc.baseId = e.get("baseId", -1).asInt();
+				pc.payload = e["payload"];
+				pc.remote = true;
+				batch.push_back(std::move(pc));
+			}
+			std::lock_guard<std::mutex> lk(g_mx);
+			g_cmdQ.push_back(std::move(batch));
 		}
 		return true;
 	}
@@ -2941,17 +3171,20 @@ void update(Game* game)
 {
 	if (!game) return;
 
+	// 0) Replica: send the waiting commands as one envelope once they are done.
+	updateOutBatch(game);
+
 	// 1) Host: drain queued commands -> validate, debit, apply, broadcast.
 	for (;;)
 	{
-		PendingCmd pc;
+		PendingBatch batch;
 		{
 			std::lock_guard<std::mutex> lk(g_mx);
 			if (g_cmdQ.empty()) break;
-			pc = std::move(g_cmdQ.front());
+			batch = std::move(g_cmdQ.front());
 			g_cmdQ.pop_front();
 		}
-		processHostCmd(game, pc);
+		processHostBatch(game, batch);
 	}
 
 	// 2) Replica: drain queued applies -> setFunds + apply.
@@ -3019,19 +3252,26 @@ void submitLocalCmd(Game* game, const std::string& cmd, int baseId,
 		pc.payload = payload;
 		pc.remote = false;
 		std::lock_guard<std::mutex> lk(g_mx);
-		g_cmdQ.push_back(std::move(pc));
+		g_cmdQ.push_back(PendingBatch{ std::move(pc) });
 	}
 	else
 	{
-		// Replica: send the command to the host; mutate nothing locally.
-		Json::Value msg;
-		msg["state"] = "shared_cmd";
-		msg["cmd"] = cmd;
-		msg["seq"] = seq;
-		msg["seat"] = seat;
-		msg["baseId"] = baseId;
-		msg["payload"] = payload;
-		if (game->getCoopMod()) game->getCoopMod()->sendTCPPacketData(msg.toStyledString());
+		// Replica: batch the command for the host; mutate nothing locally.
+		PendingCmd pc;
+		pc.cmd = cmd;
+		pc.seq = seq;
+		pc.seat = seat;
+		pc.baseId = baseId;
+		pc.payload = payload;
+		auto& reg = registry();
+		auto hit = reg.find(cmd);
+		if (hit != reg.end() && hit->second.coalesce)
+		{
+			std::string key = hit->second.coalesce(payload);
+			if (!key.empty())
+				pc.key = cmd + "|" + std::to_string(baseId) + "|" + key;
+		}
+		queueOutCmd(game, std::move(pc));
 	}
 }
 
@@ -3043,6 +3283,8 @@ Stats stats()
 	s.fail = g_failN.load();
 	s.apply = g_applyN.load();
 	s.unknown = g_unknownN.load();
+	s.sent = g_sentN.load();
+	s.batch = g_batchN.load();
 	return s;
 }
 
@@ -3054,7 +3296,7 @@ std::string lastFailReason()
 
 void resetStats()
 {
-	g_cmdN = 0; g_okN = 0; g_failN = 0; g_applyN = 0; g_unknownN = 0;
+	g_cmdN = 0; g_okN = 0; g_failN = 0; g_applyN = 0; g_unknownN = 0; g_sentN = 0; g_batchN = 0;
 	std::lock_guard<std::mutex> lk(g_failMx);
 	g_lastFail.clear();
 }
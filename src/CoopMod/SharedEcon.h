@@ -50,10 +50,16 @@ class AlienBase;
  *   shared_apply host   -> ALL    "validated + applied; here is the mutation and
  *                                 the new authoritative funds" (replicas apply
  *                                 from this ONLY)
+ *   shared_batch client -> host   several shared_cmds in one envelope; the host
+ *                                 answers with ONE shared_apply ("cmds" array)
  *
  * Flow (client-originated): client submitLocalCmd() -> shared_cmd -> host
  *   validates on the MAIN thread, debits funds, applies, broadcasts shared_apply
  *   to all + shared_ok to the initiator. The client applies from shared_apply.
+ *   Commands submitted together travel as one shared_batch; the host
+ *   runs them in order and broadcasts one shared_apply with the resulting
+ *   funds. It stops at the first rejection: the applied prefix is broadcast,
+ *   the rest is answered with one shared_fail.
  * Flow (host-originated): host submitLocalCmd() -> validate+apply locally +
  *   broadcast shared_apply.
  *
@@ -104,8 +110,20 @@ using CmdValidator = std::function<bool(Game* game, const Json::Value& payload,
 using CmdApplier = std::function<void(Game* game, Json::Value& payload,
                                       Base* base, int seat)>;
 
+/**
+ * Optional coalescing key for commands whose payload is an ABSOLUTE target
+ * (craft_equip count, res_alloc assigned, ...). A replica sends its commands in
+ * batches; a new command whose key (same cmd, same base) matches the last one
+ * waiting replaces that one's payload, so the order of the commands never
+ * changes. A batch ending in such a command is held
+ * for up to 250 ms, or until its screen closes, so a burst of clicks on one row
+ * goes out as one command. Return "" to opt out.
+ */
+using CmdCoalesceKey = std::function<std::string(const Json::Value& payload)>;
+
 /// Register (or overwrite) a command's validate + apply callbacks.
-void registerCmd(const std::string& cmd, CmdValidator validate, CmdApplier apply);
+void registerCmd(const std::string& cmd, CmdValidator validate, CmdApplier apply,
+                 CmdCoalesceKey coalesce = nullptr);
 
 // ---- PRD-J10: apply notification (live screen refresh) -----------------------
 // OXCE Basescape/Geoscape states snapshot the world in their constructors, so a
@@ -178,8 +196,8 @@ bool onMessage(Game* game, const std::string& state, const Json::Value& obj);
 void update(Game* game);
 
 /// UI entry point (main thread). On the HOST: queues the command for local
-/// validate+apply+broadcast. On a REPLICA: emits a shared_cmd to the host and
-/// mutates nothing locally.
+/// validate+apply+broadcast. On a REPLICA: adds it to the outgoing batch that
+/// update() sends to the host, and mutates nothing locally.
 void submitLocalCmd(Game* game, const std::string& cmd, int baseId,
                     const Json::Value& payload);
 
@@ -190,9 +208,8 @@ void submitLocalCmd(Game* game, const std::string& cmd, int baseId,
 /// knows the key and verbatim when it does not. Main thread.
 void showFail(Game* game, const std::string& reason);
 
-/// Send a built protocol message to every connected peer. Transport is 1:1 today
-/// (PRD-J01 audit) so this degenerates to the single-peer send; N-player only
-/// changes this body.
+/// Send a built protocol message to every connected peer. The host transport
+/// fans each send out to all attached clients, so this is a plain send.
 void broadcast(Game* game, const Json::Value& msg);
 
 // ---- PRD-J04: host simulation-result broadcasts ------------------------------
@@ -402,6 +419,8 @@ struct Stats
 	uint64_t fail;    // shared_fail surfaced (initiator) or sent (host)
 	uint64_t apply;   // shared_apply applied by this replica / host
 	uint64_t unknown; // shared_cmd with an unregistered cmd string
+	uint64_t sent;    // shared_cmd/shared_batch envelopes this replica sent
+	uint64_t batch;   // shared_batch envelopes received by this host
 };
 Stats stats();
 std::string lastFailReason();
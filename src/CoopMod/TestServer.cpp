@@ -20,6 +20,7 @@
 #include "TestServer.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <set>
@@ -32,6 +33,7 @@
 #include "../Engine/Game.h"
 #include "../Engine/Logger.h"
 #include "../Engine/Options.h"
+#include "../Engine/Profiler.h"
 #include "../Engine/State.h"
 #include "../Geoscape/GeoscapeState.h"
 #include "../Geoscape/GeoscapeCraftState.h"
@@ -44,6 +46,8 @@
 #include "../Ufopaedia/ArticleState.h"
 #include "../Battlescape/BattlescapeState.h"
 #include "../Battlescape/BattlescapeGame.h"
+#include "../Battlescape/BattleBenchmark.h"
+#include "../Battlescape/BattlePool.h"
 #include "../Battlescape/BriefingState.h"
 #include "../Battlescape/InventoryState.h"
 #include "../Battlescape/Inventory.h"
@@ -117,6 +121,10 @@
 #include "HostMenu.h"
 #include "Profile.h"
 #include "connectionTCP.h"
+#include "HostFanout.h"
+#include "CoopCapture.h"
+#include "CoopReplay.h"
+#include "CoopMessages.h"
 #include "ServerList.h"
 #include "PasswordCheckMenu.h"
 #include "../Engine/Screen.h"
@@ -323,6 +331,16 @@ void TestServer::ioThread(int port)
 	SDLNet_FreeSocketSet(set);
 }
 
+bool TestServer::hasPending()
+{
+	if (!_running.load())
+	{
+		return false;
+	}
+	std::lock_guard<std::mutex> lock(_mutex);
+	return !_inbox.empty();
+}
+
 void TestServer::pump()
 {
 	if (!_running.load())
@@ -1122,6 +1140,548 @@ bool TestServer::executeShared10(const std::string& cmd, const Json::Value& req,
 	return true;
 }
 
+namespace {
+/*
+ * The Json::Value trees the battle messages were sent as before CoopJson,
+ * built key by key like the senders did, as bench_json's reference.
+ */
+Json::Value styledTree(const TileDestroy& m)
+{
+	Json::Value root;
+	root["state"] = "destroy_tile";
+	root["tile_pos_x"] = m.pos.x;
+	root["tile_pos_y"] = m.pos.y;
+	root["tile_pos_z"] = m.pos.z;
+	root["tile_part"] = m.part;
+	root["special_tile_type"] = m.specialType;
+	root["explosive"] = m.explosive;
+	root["explosive_type"] = m.explosiveType;
+	return root;
+}
+
+Json::Value styledTree(const TileSmoke& m)
+{
+	Json::Value root;
+	root["state"] = "set_smoke_tile";
+	root["tile_pos_x"] = m.pos.x;
+	root["tile_pos_y"] = m.pos.y;
+	root["tile_pos_z"] = m.pos.z;
+	root["smoke"] = m.smoke;
+	root["animation_offset"] = m.animationOffset;
+	root["overlaps"] = m.overlaps;
+	return root;
+}
+
+Json::Value styledTree(const UnitMove& m)
+{
+	Json::Value obj;
+	obj["state"] = "BattleScapeMove";
+	obj["id"] = m.id;
+	obj["coords"]["start"]["x"] = m.coords.start.x;
+	obj["coords"]["start"]["y"] = m.coords.start.y;
+	obj["coords"]["start"]["z"] = m.coords.start.z;
+	obj["coords"]["end"]["x"] = m.coords.end.x;
+	obj["coords"]["end"]["y"] = m.coords.end.y;
+	obj["coords"]["end"]["z"] = m.coords.end.z;
+	obj["tu"] = m.tu;
+	obj["energy"] = m.energy;
+	obj["health"] = m.health;
+	obj["morale"] = m.morale;
+	obj["stunlevel"] = m.stunlevel;
+	obj["mana"] = m.mana;
+	obj["strafe"] = m.strafe;
+	obj["run"] = m.run;
+	obj["sneak"] = m.sneak;
+	obj["visible"] = m.visible;
+	obj["hiding"] = m.hiding;
+	obj["setDirection"] = m.direction;
+	obj["setFaceDirection"] = m.faceDirection;
+	obj["strafeMove"] = m.strafeMove;
+	obj["interrupted"] = m.interrupted;
+	int index = 0;
+	for (const UnitStep& step : *m.path)
+	{
+		obj["path"][index]["dir"] = step.dir;
+		obj["path"][index]["tu"] = step.tu;
+		obj["path"][index]["energy"] = step.energy;
+		obj["path"][index]["x"] = step.pos.x;
+		obj["path"][index]["y"] = step.pos.y;
+		obj["path"][index]["z"] = step.pos.z;
+		index++;
+	}
+	return obj;
+}
+
+Json::Value styledTree(const UnitStop& m)
+{
+	Json::Value root;
+	root["state"] = "abortPath";
+	root["unit_id"] = m.unitId;
+	root["x"] = m.pos.x;
+	root["y"] = m.pos.y;
+	root["z"] = m.pos.z;
+	root["setDirection"] = m.direction;
+	root["setFaceDirection"] = m.faceDirection;
+	root["setTurretDirection"] = m.turretDirection;
+	root["setTurretToDirection"] = m.turretToDirection;
+	root["tu"] = m.tu;
+	root["energy"] = m.energy;
+	return root;
+}
+
+Json::Value styledTree(const ProjectileFly& m)
+{
+	Json::Value obj;
+	obj["state"] = "ProjectileFlyBState";
+	obj["actor_id"] = m.actorId;
+	obj["actor_tu"] = m.actorTu;
+	obj["actor_energy"] = m.actorEnergy;
+	obj["actor_morale"] = m.actorMorale;
+	obj["actor_health"] = m.actorHealth;
+	obj["actor_mana"] = m.actorMana;
+	obj["actor_stun"] = m.actorStun;
+	obj["actor_no_line_fire"] = m.actorNoLineFire;
+	obj["actor_unable_to_throw_here"] = m.actorUnableToThrowHere;
+	obj["type"] = m.type;
+	obj["hand"] = std::string(m.hand);
+	obj["fusetimer"] = m.fuseTimer;
+	obj["fuse"] = m.fuse;
+	obj["coords"]["target"]["x"] = m.coords.target.x;
+	obj["coords"]["target"]["y"] = m.coords.target.y;
+	obj["coords"]["target"]["z"] = m.coords.target.z;
+	obj["coords"]["start"]["x"] = m.coords.start.x;
+	obj["coords"]["start"]["y"] = m.coords.start.y;
+	obj["coords"]["start"]["z"] = m.coords.start.z;
+	obj["targeting"] = m.targeting;
+	obj["weapon_type"] = std::string(m.weaponType);
+	obj["projectiles"] = *m.projectiles;
+	obj["ammo_type"] = std::string(m.ammoType);
+	obj["ammo_id"] = m.ammoId;
+	int pos_index = 0;
+	for (const Position& pos : *m.waypoints)
+	{
+		obj["waypoints"][pos_index]["pos_x"] = pos.x;
+		obj["waypoints"][pos_index]["pos_y"] = pos.y;
+		obj["waypoints"][pos_index]["pos_z"] = pos.z;
+		pos_index++;
+	}
+	int trajectory_index = 0;
+	for (const Position& pos : *m.trajectory)
+	{
+		obj["trajectory"][trajectory_index]["pos_x"] = pos.x;
+		obj["trajectory"][trajectory_index]["pos_y"] = pos.y;
+		obj["trajectory"][trajectory_index]["pos_z"] = pos.z;
+		trajectory_index++;
+	}
+	return obj;
+}
+
+Json::Value styledTree(const UnitHit& m)
+{
+	Json::Value root;
+	root["state"] = "hit_unit";
+	root["unit_id"] = m.unitId;
+	root["health"] = m.health;
+	root["stunlevel"] = m.stunlevel;
+	Json::Value fatalArray(Json::arrayValue);
+	for (int wounds : m.fatalWounds)
+		fatalArray.append(wounds);
+	root["fatalWounds"] = fatalArray;
+	return root;
+}
+
+Json::Value styledTree(const TileHit& m)
+{
+	const RuleDamageType* type = m.damageType;
+	Json::Value root;
+	root["state"] = "hit_tile";
+	root["center_x"] = m.center.x;
+	root["center_y"] = m.center.y;
+	root["center_z"] = m.center.z;
+	root["power"] = m.power;
+	root["rangeAtack"] = m.rangeAtack;
+	root["terrainMeleeTilePart"] = m.terrainMeleeTilePart;
+	root["seed"] = (Json::UInt64)m.seed;
+	root["smokeRNG"] = (Json::UInt64)m.smokeRNG;
+	root["ArmorEffectiveness"] = type->ArmorEffectiveness;
+	root["FireBlastCalc"] = type->FireBlastCalc;
+	root["FireThreshold"] = type->FireThreshold;
+	root["FixRadius"] = type->FixRadius;
+	root["IgnoreDirection"] = type->IgnoreDirection;
+	root["IgnoreNormalMoraleLose"] = type->IgnoreNormalMoraleLose;
+	root["IgnoreOverKill"] = type->IgnoreOverKill;
+	root["IgnorePainImmunity"] = type->IgnorePainImmunity;
+	root["IgnoreSelfDestruct"] = type->IgnoreSelfDestruct;
+	root["RadiusEffectiveness"] = type->RadiusEffectiveness;
+	root["RadiusReduction"] = type->RadiusReduction;
+	root["RandomArmor"] = type->RandomArmor;
+	root["RandomArmorPre"] = type->RandomArmorPre;
+	root["RandomEnergy"] = type->RandomEnergy;
+	root["RandomHealth"] = type->RandomHealth;
+	root["RandomItem"] = type->RandomItem;
+	root["RandomMana"] = type->RandomMana;
+	root["RandomMorale"] = type->RandomMorale;
+	root["RandomStun"] = type->RandomStun;
+	root["RandomTile"] = type->RandomTile;
+	root["RandomTime"] = type->RandomTime;
+	root["RandomType"] = m.randomType;
+	root["RandomWound"] = type->RandomWound;
+	root["ResistType"] = m.resistType;
+	root["SmokeThreshold"] = type->SmokeThreshold;
+	root["TileDamageMethod"] = type->TileDamageMethod;
+	root["ToArmor"] = type->ToArmor;
+	root["ToArmorPre"] = type->ToArmorPre;
+	root["ToEnergy"] = type->ToEnergy;
+	root["ToHealth"] = type->ToHealth;
+	root["ToItem"] = type->ToItem;
+	root["ToMana"] = type->ToMana;
+	root["ToMorale"] = type->ToMorale;
+	root["ToStun"] = type->ToStun;
+	root["ToTile"] = type->ToTile;
+	root["ToWound"] = type->ToWound;
+	return root;
+}
+
+Json::Value styledTree(const AIProgress& m)
+{
+	Json::Value root;
+	root["state"] = "update_progress";
+	root["ret"] = m.ret;
+	root["selected_unit_id"] = m.selectedUnitId;
+	root["AISecondMove"] = m.secondMove;
+	return root;
+}
+
+/// Times one message both ways, its hand-built Json::Value tree +
+/// toStyledString() and CoopJson::encode(), and parses both texts back
+/// to check they carry the same values.
+template <class T> Json::Value benchJsonMessage(const T& msg, int iterations)
+{
+	typedef std::chrono::steady_clock Clock;
+	std::string styled = styledTree(msg).toStyledString();
+	std::string streamed = CoopJson::encode(msg);
+	volatile size_t sink = 0;
+	Clock::time_point t0 = Clock::now();
+	for (int i = 0; i < iterations; ++i)
+		sink = sink + styledTree(msg).toStyledString().size();
+	Clock::time_point t1 = Clock::now();
+	for (int i = 0; i < iterations; ++i)
+		sink = sink + CoopJson::encode(msg).size();
+	Clock::time_point t2 = Clock::now();
+
+	Json::CharReaderBuilder rb;
+	std::unique_ptr<Json::CharReader> reader(rb.newCharReader());
+	Json::Value a, b;
+	bool parsed = reader->parse(styled.data(), styled.data() + styled.size(), &a, nullptr)
+		&& reader->parse(streamed.data(), streamed.data() + streamed.size(), &b, nullptr);
+
+	Json::Value j;
+	j["state"] = CoopJson::Schema<T>::state;
+	j["styledBytes"] = (Json::UInt64)styled.size();
+	j["streamedBytes"] = (Json::UInt64)streamed.size();
+	j["styledNs"] = std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+	j["streamedNs"] = std::chrono::duration<double, std::nano>(t2 - t1).count() / iterations;
+	j["same"] = parsed && a == b;
+	return j;
+}
+}
+
+/**
+ * Performance tooling. Benchmarks are meant for a headless run from the main menu
+ * (SDL_VIDEODRIVER=dummy OXC_TEST_PORT=<port>), the report is plain
+ * milliseconds so a script can diff runs. Returns true if @a cmd was
+ * one of ours (and @a resp was filled).
+ */
+bool TestServer::executeBench(const std::string& cmd, const Json::Value& req, Json::Value& resp)
+{
+	if (cmd == "bench_battle")
+	{
+		// Generates a skirmish battle and times generation, a full FOV and
+		// lighting pass, alien reachability and the AI decisions of <turns> alien
+		// turns, carried out without animations between the turns.
+		// Everything but the numbers is deterministic for a given <seed>.
+		BattleBenchmark::Config config;
+		config.mission = req.get("mission", "").asString();
+		config.terrain = req.get("terrain", "").asString();
+		config.craft = req.get("craft", "").asString();
+		config.alienRace = req.get("alienRace", "").asString();
+		config.seed = req.get("seed", 1).asInt();
+		config.turns = req.get("turns", 3).asInt();
+		config.difficulty = req.get("difficulty", 0).asInt();
+		config.darkness = req.get("darkness", 0).asInt();
+		config.alienTech = req.get("alienTech", 0).asInt();
+		config.depth = req.get("depth", 0).asInt();
+		config.ufoLanded = req.get("ufoLanded", true).asBool();
+		if (_game->getSavedGame())
+		{
+			resp["error"] = "bench_battle needs the main menu (no game loaded)";
+		}
+		else
+		{
+			BattleBenchmark::Report report = BattleBenchmark::run(_game, config);
+			resp["mission"] = report.mission;
+			resp["terrain"] = report.terrain;
+			resp["alienRace"] = report.alienRace;
+			resp["craft"] = report.craft;
+			resp["seed"] = config.seed;
+			resp["turns"] = config.turns;
+			Json::Value map(Json::arrayValue);
+			map.append(report.mapX);
+			map.append(report.mapY);
+			map.append(report.mapZ);
+			resp["map"] = map;
+			resp["playerUnits"] = report.playerUnits;
+			resp["hostileUnits"] = report.hostileUnits;
+			Json::Value phases;
+			phases["generation"] = report.generationMs;
+			phases["fov"] = report.fovMs;
+			phases["lighting"] = report.lightingMs;
+			phases["pathfinding"] = report.pathfindingMs;
+			phases["ai"] = report.aiMs;
+			resp["phases"] = phases;
+			Json::Value units(Json::arrayValue);
+			for (const auto& unit : report.units)
+			{
+				Json::Value u;
+				u["id"] = unit.id;
+				u["type"] = unit.type;
+				u["decisions"] = unit.decisions;
+				u["ms"] = unit.ms;
+				u["msPerDecision"] = unit.decisions ? unit.ms / unit.decisions : 0.0;
+				units.append(u);
+			}
+			resp["units"] = units;
+			resp["ok"] = true;
+		}
+	}
+	else if (cmd == "bench_json")
+	{
+		// Encodes typical battle messages <iterations> times each, the old way
+		// (a hand-built Json::Value + toStyledString) and with CoopJson, and
+		// reports the mean nanoseconds and the bytes per message. <same> is
+		// false if the two texts parse to different values.
+		int iterations = std::max(1, req.get("iterations", 20000).asInt());
+		Position from(10, 12, 0), to(24, 30, 1);
+		std::list<Position> waypoints{ Position(400, 480, 12) };
+		std::vector<Position> trajectory;
+		for (int i = 0; i < 24; ++i)
+			trajectory.push_back(Position(168 + i * 15, 200 + i * 17, 12));
+		Json::Value projectiles(Json::arrayValue);
+		for (int i = 0; i < 3; ++i)
+		{
+			Json::Value p(Json::objectValue);
+			p["rng_x"] = 400 + i;
+			p["rng_y"] = 482 - i;
+			p["rng_z"] = 12;
+			p["seed"] = (Json::UInt64)(0x9E3779B97F4A7C15ull * (i + 1));
+			p["origin_x"] = 168;
+			p["origin_y"] = 200;
+			p["origin_z"] = 12;
+			projectiles.append(p);
+		}
+		ProjectileFly fly{ 1000001, 38, 70, 100, 35, 0, 0, false, false, (int)BA_AUTOSHOT, "STR_RIGHT_HAND", 0, false,
+			{ to, from }, true, "STR_RIFLE", &projectiles, "STR_RIFLE_CLIP", 17, &waypoints, &trajectory };
+		TileHit hit{ to, 26, true, 0, 0x2545F4914F6CDD1Dull, 11, _game->getMod()->getDamageType(DT_AP), 0, (int)DT_AP };
+
+		std::vector<UnitStep> path;
+		for (int i = 1; i <= 6; ++i)
+			path.push_back(UnitStep{ 2, 4, 2, Position(from.x + i, from.y, from.z) });
+
+		Json::Value messages(Json::arrayValue);
+		messages.append(benchJsonMessage(TileDestroy{ to, 1, 0, 0, 0 }, iterations));
+		messages.append(benchJsonMessage(TileSmoke{ to, 8, 2, 1 }, iterations));
+		messages.append(benchJsonMessage(UnitMove{ 1000001, { from, to }, 52, 80, 35, 100, 0, 0, false, false, false, true, false, 2, 2, false, false, &path }, iterations));
+		messages.append(benchJsonMessage(UnitStop{ 1000001, to, 3, 3, -1, -1, 28, 68 }, iterations));
+		messages.append(benchJsonMessage(fly, iterations));
+		messages.append(benchJsonMessage(UnitHit{ 1000007, 12, 5, { 0, 1, 0, 0, 2, 0 } }, iterations));
+		messages.append(benchJsonMessage(hit, iterations));
+		messages.append(benchJsonMessage(AIProgress{ 42, 1000007, false }, iterations));
+		resp["iterations"] = iterations;
+		resp["messages"] = messages;
+		resp["ok"] = true;
+	}
+	else if (cmd == "profiler_trace")
+	{
+		// Writes the profiler's ring buffers to <file> as Chrome trace JSON.
+		// Needs a build with ENABLE_PROFILER, otherwise there's nothing to write.
+		std::string file = req.get("file", "").asString();
+		if (!Profiler::Enabled)
+			resp["error"] = "profiler not compiled in";
+		else if (file.empty())
+			resp["error"] = "need file";
+		else if (!Profiler::writeTrace(file))
+			resp["error"] = "can't write " + file;
+		else
+			resp["ok"] = true;
+	}
+	else if (cmd == "battle_pool")
+	{
+		// Battle pool allocation counts: this turn, last turn, whole run and
+		// still alive, per pooled type, plus the chunk memory held.
+		BattlePool::Stats stats = BattlePool::getStats();
+		for (const auto& k : stats.kinds)
+		{
+			Json::Value& j = resp["kinds"][k.name];
+			j["turn"] = (Json::UInt64)k.turnAllocs;
+			j["lastTurn"] = (Json::UInt64)k.lastTurnAllocs;
+			j["total"] = (Json::UInt64)k.totalAllocs;
+			j["live"] = k.live;
+		}
+		resp["chunkBytes"] = (Json::UInt64)stats.chunkBytes;
+		resp["freeBytes"] = (Json::UInt64)stats.freeBytes;
+		resp["ok"] = true;
+	}
+	else if (cmd == "net_peers")
+	{
+		// Host fan-out counters, one entry per attached client (oldest first):
+		// reliable bytes waiting and their peak, bytes/messages written, and
+		// snapshots sent vs skipped because a newer one replaced them.
+		Json::Value peers(Json::arrayValue);
+		for (const auto& p : HostFanout::getStats())
+		{
+			Json::Value j;
+			j["id"] = p.id;
+			j["queuedBytes"] = (Json::UInt64)p.queuedBytes;
+			j["peakQueuedBytes"] = (Json::UInt64)p.peakQueuedBytes;
+			j["sentBytes"] = (Json::UInt64)p.sentBytes;
+			j["sentFrames"] = (Json::UInt64)p.sentFrames;
+			j["snapshotsSent"] = (Json::UInt64)p.snapshotsSent;
+			j["snapshotsSkipped"] = (Json::UInt64)p.snapshotsSkipped;
+			j["overflowed"] = p.overflowed;
+			peers.append(j);
+		}
+		resp["peers"] = peers;
+		resp["ok"] = true;
+	}
+	else if (cmd == "net_soak")
+	{
+		// Load for the fan-out soak: queues up to <count> numbered SOAK messages
+		// of about <size> bytes, starting at <first>, and every <snapEvery>th one
+		// also replaces the dogfight snapshot slot with a SOAK_SNAP. Stops early
+		// when the TX queue is full; <queued> says how far it got, so the driver
+		// resumes from first + queued.
+		int first = req.get("first", 0).asInt();
+		int count = req.get("count", 100).asInt();
+		int size = req.get("size", 256).asInt();
+		int snapEvery = req.get("snapEvery", 0).asInt();
+		Json::StreamWriterBuilder wb;
+		wb["indentation"] = "";
+		std::string pad(std::max(0, size), 'x');
+		int queued = 0;
+		for (; queued < count; ++queued)
+		{
+			int n = first + queued;
+			Json::Value m;
+			m["type"] = "SOAK";
+			m["n"] = n;
+			m["pad"] = pad;
+			if (!enqueueTx(Json::writeString(wb, m)))
+				break;
+			if (snapEvery > 0 && n % snapEvery == 0)
+			{
+				Json::Value snap;
+				snap["type"] = "SOAK_SNAP";
+				snap["n"] = n;
+				enqueueSnapshot(SNAP_DOGFIGHT, Json::writeString(wb, snap));
+			}
+		}
+		resp["queued"] = queued;
+		resp["ok"] = true;
+	}
+	else if (cmd == "net_capture")
+	{
+		// Starts a packet capture into <file> (default: a new file under
+		// captures/ in the user folder). It ends with the session or on
+		// net_capture_stop.
+		std::string file = req.get("file", "").asString();
+		if (file.empty())
+			file = CoopCapture::makePath(connectionTCP::getHost());
+		if (CoopCapture::isRecording())
+			resp["error"] = "already capturing";
+		else if (!CoopCapture::start(file))
+			resp["error"] = "can't write " + file;
+		else
+		{
+			resp["file"] = file;
+			resp["ok"] = true;
+		}
+	}
+	else if (cmd == "net_capture_stop")
+	{
+		CoopCapture::stop();
+		resp["recorded"] = (Json::UInt64)CoopCapture::getRecorded();
+		resp["ok"] = true;
+	}
+	else if (cmd == "net_replay")
+	{
+		// Plays the inbound side of capture <file> into this instance as a
+		// joining client, at <speed> times the recorded pace (0: as fast as
+		// the RX queue takes it). Poll net_replay_stats for the results.
+		std::string file = req.get("file", "").asString();
+		double speed = req.get("speed", 0.0).asDouble();
+		connectionTCP* coop = _game->getCoopMod();
+		if (!coop)
+			resp["error"] = "no coop";
+		else if (file.empty())
+			resp["error"] = "need file";
+		else
+		{
+			try
+			{
+				coop->replayCapture(file, speed);
+				resp["messages"] = (Json::UInt64)CoopReplay::getReport().total;
+				resp["ok"] = true;
+			}
+			catch (const std::exception& e)
+			{
+				resp["error"] = e.what();
+			}
+		}
+	}
+	else if (cmd == "net_replay_stats")
+	{
+		// Replay progress, throughput, main-thread milliseconds per message
+		// type (slowest in total first), and what the game sent back next to
+		// what the captured session sent, per type. <drained> means everything
+		// was fed and nothing waits in the RX or hold queue anymore.
+		CoopReplay::Report report = CoopReplay::getReport();
+		resp["active"] = report.active;
+		resp["total"] = (Json::UInt64)report.total;
+		resp["fed"] = (Json::UInt64)report.fed;
+		resp["handled"] = (Json::UInt64)report.handled;
+		resp["drained"] = report.fedAll && !connectionTCP::hasPendingMessages();
+		resp["wallMs"] = report.wallMs;
+		resp["messagesPerSecond"] = report.wallMs > 0 ? report.handled * 1000.0 / report.wallMs : 0.0;
+		Json::Value handlers(Json::arrayValue);
+		for (const auto& h : report.handlers)
+		{
+			Json::Value j;
+			j["name"] = h.name;
+			j["count"] = (Json::UInt64)h.count;
+			j["totalMs"] = h.totalMs;
+			j["meanMs"] = h.totalMs / h.count;
+			j["maxMs"] = h.maxMs;
+			handlers.append(j);
+		}
+		resp["handlers"] = handlers;
+		for (const auto& i : report.sent)
+			resp["sent"][i.first] = (Json::UInt64)i.second;
+		for (const auto& i : report.capturedSent)
+			resp["capturedSent"][i.first] = (Json::UInt64)i.second;
+		resp["ok"] = true;
+	}
+	else if (cmd == "net_replay_stop")
+	{
+		CoopReplay::stop();
+		resp["ok"] = true;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
 /**
  * PRD-J10/J11 test hooks, second sub-dispatcher. execute()'s command chain hit
  * MSVC's C1061 nested-block limit again after the upstream rebase stacked more
@@ -1201,6 +1761,18 @@ bool TestServer::executeShared11(const std::string& cmd, const Json::Value& req,
 		SharedEcon::submitLocalCmd(_game, jcmd, baseId, payload);
 		resp["ok"] = true;
 	}
+	else if (cmd == "shared_cmds")
+	{
+		// Submits every {jcmd, baseId, payload} of <cmds> in this one call, as
+		// if clicked within a single frame, so a replica queues them into one
+		// outgoing batch (coalescing included).
+		for (const Json::Value& c : req["cmds"])
+		{
+			Json::Value payload = c.get("payload", Json::Value(Json::objectValue));
+			SharedEcon::submitLocalCmd(_game, c.get("jcmd", "").asString(), c.get("baseId", 0).asInt(), payload);
+		}
+		resp["ok"] = true;
+	}
 	else if (cmd == "shared_stats")
 	{
 		// PRD-J03: read this machine's SharedEcon protocol counters + the most
@@ -1211,6 +1783,8 @@ bool TestServer::executeShared11(const std::string& cmd, const Json::Value& req,
 		resp["failCount"] = Json::Value::UInt64(st.fail);
 		resp["applyCount"] = Json::Value::UInt64(st.apply);
 		resp["unknownCount"] = Json::Value::UInt64(st.unknown);
+		resp["sentCount"] = Json::Value::UInt64(st.sent);
+		resp["batchCount"] = Json::Value::UInt64(st.batch);
 		resp["lastFail"] = SharedEcon::lastFailReason();
 		resp["ok"] = true;
 	}
@@ -1263,7 +1837,7 @@ bool TestServer::executeShared11(const std::string& cmd, const Json::Value& req,
 				{
 					RuleResearch* r = _game->getMod()->getResearch(name, false);
 					if (!r || sg->isResearched(r, false)) continue;
-					if (sg->isResearchRuleStatusDisabled(name)) continue;
+					if (sg->isResearchRuleStatusDisabled(r)) continue;
 					bool inProg = false;
 					for (auto* p : base->getResearch())
 						if (p->getRules() == r) { inProg = true; break; }
@@ -2293,6 +2867,11 @@ bool TestServer::executeShared11(const std::string& cmd, const Json::Value& req,
 			Options::oxceAlternateCraftEquipmentManagement = req.get("value", false).asBool();
 			resp["ok"] = true;
 		}
+		else if (name == "geoscapeTimeSkip")
+		{
+			Options::geoscapeTimeSkip = req.get("value", true).asBool();
+			resp["ok"] = true;
+		}
 		else
 		{
 			resp["error"] = "unknown option: " + name;
@@ -2766,6 +3345,36 @@ bool TestServer::executeShared11(const std::string& cmd, const Json::Value& req,
 			resp["error"] = "no GeoscapeState (in popup/battle?)";
 		}
 	}
+	else if (cmd == "geo_advance")
+	{
+		// Frame-independent geoscape time: holds the game clock (hold, default
+		// true) and runs <ticks> timer ticks at <speed> (0..5 idx) right here,
+		// so a seeded run lands on the same game state every time. ticks=0
+		// just holds or releases the clock. Popups queue up but don't block.
+		GeoscapeState* gs = findState<GeoscapeState>(_game);
+		if (!gs || !_game->getSavedGame())
+		{
+			resp["error"] = "no GeoscapeState";
+		}
+		else
+		{
+			gs->harnessHoldClock(req.get("hold", true).asBool());
+			gs->setTimeSpeedIndex(req.get("speed", 5).asInt());
+			int ticks = std::max(0, req.get("ticks", 0).asInt());
+			for (int i = 0; i < ticks; ++i)
+				gs->timeAdvance();
+			GameTime* t = _game->getSavedGame()->getTime();
+			Json::Value time;
+			time["year"] = t->getYear();
+			time["month"] = t->getMonth();
+			time["day"] = t->getDay();
+			time["hour"] = t->getHour();
+			time["minute"] = t->getMinute();
+			time["second"] = t->getSecond();
+			resp["time"] = time;
+			resp["ok"] = true;
+		}
+	}
 	else if (cmd == "geo_craft_buttons")
 	{
 		// Control-guard check: build the geoscape craft dialog for a craft and
@@ -3081,9 +3690,9 @@ std::string TestServer::execute(const std::string& line)
 		std::string cmd = req.get("cmd", "").asString();
 		connectionTCP* coop = _game->getCoopMod();
 
-		if (executeShared10(cmd, req, resp))
+		if (executeBench(cmd, req, resp) || executeShared10(cmd, req, resp))
 		{
-			// handled by the PRD-J10 dispatcher above
+			// handled by the benchmark or PRD-J10 dispatchers above
 		}
 		else if (cmd == "ping")
 		{
@@ -3822,6 +4431,7 @@ std::string TestServer::execute(const std::string& line)
 					ju["isOut"] = u->isOut();
 					ju["health"] = u->getHealth();
 					ju["tu"] = u->getTimeUnits();
+					ju["energy"] = u->getEnergy();
 					ju["stun"] = u->getStunlevel();
 					ju["name"] = u->getName(_game->getLanguage());
 					ju["isPlayerSoldier"] = (u->getGeoscapeSoldier() != nullptr);
@@ -3863,7 +4473,7 @@ std::string TestServer::execute(const std::string& line)
 		else if (cmd == "battle_action")
 		{
 			// Unified battlescape action driver. action = select|move|shoot|
-			// end_turn|abort. Reaches the BattlescapeGame via the top
+			// reserve|end_turn|abort. Reaches the BattlescapeGame via the top
 			// BattlescapeState. All ops are on the main thread (race-free).
 			BattlescapeGame* bg = nullptr;
 			BattlescapeState* bstate = nullptr;
@@ -3881,6 +4491,17 @@ std::string TestServer::execute(const std::string& line)
 				bg->requestEndTurn(false);
 				resp["ok"] = true;
 			}
+			else if (act == "reserve")
+			{
+				// The time unit reserve buttons: mode = none|snap|auto|aimed.
+				std::string mode = req.get("mode", "none").asString();
+				BattleActionType bt = BA_NONE;
+				if (mode == "snap") bt = BA_SNAPSHOT;
+				else if (mode == "auto") bt = BA_AUTOSHOT;
+				else if (mode == "aimed") bt = BA_AIMEDSHOT;
+				bg->setTUReserved(bt);
+				resp["ok"] = true;
+			}
 			else if (act == "abort")
 			{
 				// Proper abort: open the confirm dialog (AbortMissionState). The
@@ -49,6 +49,8 @@ public:
 	void startFromEnvironment(Game* game);
 	// Executes queued commands on the main thread. Called once per frame.
 	void pump();
+	// True if commands are waiting for pump() (lets the main loop wake up early).
+	bool hasPending();
 	// Stops the listener thread (called from shutdown).
 	void stop();
 
@@ -64,6 +66,9 @@ private:
 	/// chain it tipped C1061 again, so the back half of execute()'s chain lives here.
 	/// execute() tries this after executeShared10. True = @a cmd was handled here.
 	bool executeShared11(const std::string& cmd, const Json::Value& req, Json::Value& resp);
+	/// Performance tooling (bench_*, profiler_*). Checked alongside executeShared10 so the
+	/// chain doesn't get deeper. True = @a cmd was handled here.
+	bool executeBench(const std::string& cmd, const Json::Value& req, Json::Value& resp);
 
 	Game* _game = nullptr;
 	std::thread _thread;
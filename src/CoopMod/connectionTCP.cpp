@@ -28,6 +28,7 @@
 #include <unordered_set>
 
 #include "../Engine/Game.h"
+#include "../Engine/Profiler.h"
 #include "../Menu/MainMenuState.h"
 
 #include "../Basescape/CraftSoldiersState.h"
@@ -63,6 +64,9 @@
 #include "ModCheckMenu.h"
 #include "GiftNoticeState.h"
 #include "SharedEcon.h"
+#include "HostFanout.h"
+#include "CoopCapture.h"
+#include "CoopReplay.h"
 #include "connectionUDP/connection_udp_glue.h"
 
 #include "../Savegame/BaseFacility.h"
@@ -431,38 +435,41 @@ std::atomic<uint64_t> g_txDropCount{0};
 // ===== Geoscape sync conflation slot =====
 // One overwrite slot per snapshot channel (see CoopSnapSlot). The main thread
 // (GeoscapeState::think) overwrites; the send drain reads the freshest value and
-// clears the dirty flag. Written/read under g_snapMx so a mid-read frame can't be
-// torn by a concurrent overwrite.
+// clears the dirty flag. Payloads are written/read under g_snapMx so a mid-read
+// frame can't be torn by a concurrent overwrite. The dirty flags are atomics that
+// only change under the mutex, so the send threads' idle checks can read them
+// without taking it.
 static std::mutex g_snapMx;
 static std::array<std::string, SNAP_COUNT> g_snap;
-static std::array<bool, SNAP_COUNT> g_snapDirty{}; // value-init -> all false
+static std::array<std::atomic<bool>, SNAP_COUNT> g_snapDirty{}; // value-init -> all false
 
 void enqueueSnapshot(CoopSnapSlot slot, std::string&& s)
 {
 	if (slot < 0 || slot >= SNAP_COUNT)
 		return;
 	std::lock_guard<std::mutex> lk(g_snapMx);
-	g_snap[slot] = std::move(s); // discards only the stale prior snapshot (LWW-safe)
-	g_snapDirty[slot] = true;
+	g_snap[slot].swap(s); // discards only the stale prior snapshot (LWW-safe)
+	g_snapDirty[slot].store(true, std::memory_order_release);
 }
 
 bool anySnapshotDirty()
 {
-	std::lock_guard<std::mutex> lk(g_snapMx);
 	for (int i = 0; i < SNAP_COUNT; ++i)
-		if (g_snapDirty[i])
+		if (g_snapDirty[i].load(std::memory_order_acquire))
 			return true;
 	return false;
 }
 
 bool popSnapshot(std::string& out)
 {
+	if (!anySnapshotDirty())
+		return false;
 	std::lock_guard<std::mutex> lk(g_snapMx);
 	for (int i = 0; i < SNAP_COUNT; ++i)
 	{
 		if (g_snapDirty[i])
 		{
-			out = g_snap[i]; // raw payload; UDP sends whole messages (no framing)
+			out.swap(g_snap[i]); // raw payload; UDP sends whole messages (no framing)
 			g_snapDirty[i] = false;
 			return true;
 		}
@@ -477,12 +484,15 @@ static inline void appendFramed(std::string& out, const std::string& payload); /
 // sendAll as the reliable batch (freshest value only, at link rate).
 static void drainSnapshotsInto(std::string& out)
 {
+	if (!anySnapshotDirty())
+		return;
 	std::lock_guard<std::mutex> lk(g_snapMx);
 	for (int i = 0; i < SNAP_COUNT; ++i)
 	{
 		if (g_snapDirty[i])
 		{
 			appendFramed(out, g_snap[i]);
+			CoopCapture::record(CoopCapture::OUTBOUND | CoopCapture::SNAPSHOT, g_snap[i]);
 			g_snapDirty[i] = false;
 		}
 	}
@@ -647,6 +657,16 @@ bool connectionTCP::localLoadsAllowed()
 	return !coopSession && !getCoopStatic();
 }
 
+// Game::run sleeps while idle; anything in the RX queue, or held back for a
+// later pass of updateCoopTask, has to wake it up.
+bool connectionTCP::hasPendingMessages()
+{
+	if (!g_rxQ.empty())
+		return true;
+	std::lock_guard<std::mutex> lock(g_rxHoldMutex);
+	return !g_rxHold.empty();
+}
+
 
 std::string connectionTCP::clientBlobKey(const std::string& hostName)
 {
@@ -761,6 +781,7 @@ struct StreamAbort {};
 // in the loop, load the map file data between host and client
 void connectionTCP::loopData()
 {
+	Profiler::setThreadName("coop stream");
 	// Wait for the client's map-chunk ack (isWaitMap), but bail out if the
 	// connection is being torn down so a mid-transfer drop cannot park this
 	// thread. The teardown signal is disconnectTCP forcing BOTH send flags false
@@ -1869,14 +1890,28 @@ void connectionTCP::updateCoopTask()
 
 				// debug mode
 				if (Options::logPacketMessages == true && Options::logInfoToFile == true)
-				{			
+				{
 					std::string str_debug =
+						"[" + CrossPlatform::now() + "]\t[" + Logger::toString(LOG_INFO) + "]\t" +
 						std::string("task completed: ") + (_coop_task_completed ? "true" : "false") +
-						"   connection status: " + std::to_string(onConnect) + 
+						"   connection status: " + std::to_string(onConnect) +
 						"   packet name: " + stateString +
-						"   packet data: " + obj.toStyledString();
+						"   packet data: ";
 
-					DebugLog(str_debug);
+					// styling the whole packet is the expensive part, leave it to the log writer thread
+					auto format = [str_debug, jsonStr]()
+					{
+						Json::CharReaderBuilder rb;
+						std::unique_ptr<Json::CharReader> reader(rb.newCharReader());
+						Json::Value packet;
+						std::string errs;
+						reader->parse(jsonStr.data(), jsonStr.data() + jsonStr.size(), &packet, &errs);
+						return str_debug + packet.toStyledString() + "\n";
+					};
+					if (!LogWriter::postDeferred(std::move(format), LogWriter::TO_FILE | LogWriter::TO_STDERR))
+					{
+						DebugLog(str_debug + obj.toStyledString());
+					}
 				}
 
 				// Make operator precedence explicit:
@@ -1889,6 +1924,7 @@ void connectionTCP::updateCoopTask()
 
 				if (consumeNow)
 				{
+					CoopReplay::HandlerTimer timer(stateString);
 					onTCPMessage(stateString, obj);
 					++consumedThisPass;
 				}
@@ -2292,16 +2328,20 @@ static inline void clientMaybeSendPing()
 	}
 }
 
-// Host: if incoming JSON is PING, enqueue PONG via the same TX queue; do not forward to game.
-static inline bool maybeHandlePingOnHost(const Json::Value& obj)
+// Host: if incoming JSON is PING, answer only the client that sent it; do not forward to game.
+static inline bool maybeHandlePingOnHost(const Json::Value& obj, int peerId)
 {
 	if (obj.isMember("type") && obj["type"].asString() == "PING")
 	{
 		Json::Value pong;
 		pong["type"] = "PONG";
 		pong["ts"] = obj["ts"];
-		sendJSONNoLock(pong); // host -> single client via TX queue
-		return true;          // handled internally
+		Json::StreamWriterBuilder wb;
+		wb["indentation"] = "";
+		std::string payload = Json::writeString(wb, pong);
+		CoopCapture::record(CoopCapture::OUTBOUND, payload);
+		HostFanout::sendTo(peerId, payload);
+		return true; // handled internally
 	}
 	return false;
 }
@@ -2359,6 +2399,7 @@ static inline void clearAllReceivedPackets(TCPsocket sock,
 // ===== Client thread =====
 void connectionTCP::startTCPClient()
 {
+	Profiler::setThreadName("coop client");
 
 	SDL_Delay(1000);
 	DebugLog("startTCPClient\n");
@@ -2402,6 +2443,9 @@ void connectionTCP::startTCPClient()
 	bool initSent = false; // one-time handshake
 	onConnect = 1;
 
+	if (Options::coopCapturePackets)
+		CoopCapture::start(CoopCapture::makePath(false));
+
 	for (;;)
 	{
 
@@ -2419,6 +2463,7 @@ void connectionTCP::startTCPClient()
 
 		// ---- Batch-send: drain up to 64 queued payloads into one write ----
 		{
+			PROFILE_ZONE("connectionTCP::send");
 			std::string out;
 			out.reserve(8192);
 			std::string msg;
@@ -2426,6 +2471,7 @@ void connectionTCP::startTCPClient()
 			while (batched < 64 && g_txQ.pop(msg))
 			{
 				appendFramed(out, msg);
+				CoopCapture::record(CoopCapture::OUTBOUND, msg);
 				++batched;
 			}
 			// Conflated geoscape snapshots ride the same framed write as the
@@ -2448,6 +2494,7 @@ void connectionTCP::startTCPClient()
 		int ready = SDLNet_CheckSockets(socketSet, 0); // 0 ms timeout
 		if (ready > 0 && SDLNet_SocketReady(sock))
 		{
+			PROFILE_ZONE("connectionTCP::receive");
 			for (;;)
 			{
 				char buf[16 * 1024];
@@ -2494,6 +2541,7 @@ void connectionTCP::startTCPClient()
 
 				if (!message.empty())
 				{
+					CoopCapture::record(0, message);
 
 					// Handle PING/PONG internally, push others to RX queue for the game thread
 					Json::CharReaderBuilder rb;
@@ -2544,6 +2592,9 @@ void connectionTCP::startTCPClient()
 		// ---- Client RTT ping ----
 		clientMaybeSendPing();
 
+		// this pass's messages go to the capture file before the next one
+		CoopCapture::flush();
+
 		// ---- Gentle yield only if nothing happened ----
 		if (ready == 0 && g_txQ.empty() && !anySnapshotDirty())
 		{
@@ -2554,18 +2605,48 @@ void connectionTCP::startTCPClient()
 	}
 
 client_cleanup:
+	CoopCapture::stop();
 	SDLNet_FreeSocketSet(socketSet);
 	SDLNet_TCP_Close(sock);
 	SDLNet_Quit();
 	return;
 }
 
-// ===== Host thread (single client) =====
-// Simplified for exactly two players: host + one client.
-// If another client tries to connect, close it silently (no "server_full" message),
-// because we only use sendTCPPacketStaticData for outbound traffic.
+// ===== Host thread =====
+// Accepts up to Options::coopMaxClients clients (default 1: host + one client;
+// the session layer above still runs one remote player, the extra seats are
+// transport only). Further connections are closed silently. Outbound traffic
+// goes through HostFanout: framed once, queued per client, sent from one thread
+// per client, so a slow client never holds up this thread or the others.
+// The first attached client is the session's client: only its connection state
+// drives onConnect.
+struct HostClient
+{
+	int id;
+	TCPsocket sock;
+	std::vector<char> recvBuffer;
+};
+
+// Moves every dirty conflation slot into the fan-out (freshest value only).
+static void publishSnapshots()
+{
+	if (!anySnapshotDirty())
+		return;
+	std::lock_guard<std::mutex> lk(g_snapMx);
+	for (int i = 0; i < SNAP_COUNT; ++i)
+	{
+		if (g_snapDirty[i])
+		{
+			HostFanout::publishSnapshot(i, g_snap[i]);
+			CoopCapture::record(CoopCapture::OUTBOUND | CoopCapture::SNAPSHOT, g_snap[i]);
+			g_snapDirty[i] = false;
+		}
+	}
+}
+
 void connectionTCP::startTCPHost()
 {
+	Profiler::setThreadName("coop host");
 	DebugLog("startTCPHost\n");
 	resetCoopState(true); // host
 
@@ -2594,139 +2675,158 @@ void connectionTCP::startTCPHost()
 		return;
 	}
 
-	SDLNet_SocketSet socketSet = SDLNet_AllocSocketSet(2);
+	const size_t maxClients = (size_t)std::clamp(Options::coopMaxClients, 1, 16);
+	SDLNet_SocketSet socketSet = SDLNet_AllocSocketSet((int)maxClients + 1);
 	SDLNet_TCP_AddSocket(socketSet, listening);
 
-	TCPsocket clientSock = nullptr;
-	std::vector<char> recvBuffer;
-	recvBuffer.reserve(4096);
+	std::vector<HostClient> clients;
+	clients.reserve(maxClients);
+	std::vector<char> noBuffer;
+
+	// Stops serving clients[index]. Only the session's client reports its loss.
+	auto dropClient = [&](size_t index, int state)
+	{
+		if (index == 0)
+			onConnect = state;
+		SDLNet_TCP_DelSocket(socketSet, clients[index].sock);
+		HostFanout::detach(clients[index].id); // its send thread closes the socket
+		clients.erase(clients.begin() + index);
+	};
 
 	onConnect = 1;
 	// thread-side role mirror (pre-struct behavior kept; the main-thread
 	// hosting path also sets this via setServerOwner)
 	session.role = CoopRole::Host;
 
+	if (Options::coopCapturePackets)
+		CoopCapture::start(CoopCapture::makePath(true));
+
 	for (;;)
 	{
 
 		if (clearPackets == true)
 		{
 			clearPackets = false;
-			clearAllReceivedPackets(clientSock, socketSet, recvBuffer);
+			clearAllReceivedPackets(nullptr, socketSet, noBuffer);
+			for (auto& c : clients)
+				clearAllReceivedPackets(c.sock, socketSet, c.recvBuffer);
 		}
 
-		if (onConnect == -1)
-		{
-			clearAllReceivedPackets(clientSock, socketSet, recvBuffer);
-			break;
-		}
-	
-
-		if (_hostStop)
+		if (onConnect == -1 || _hostStop)
 		{
-			clearAllReceivedPackets(clientSock, socketSet, recvBuffer);
+			clearAllReceivedPackets(nullptr, socketSet, noBuffer);
+			for (auto& c : clients)
+				clearAllReceivedPackets(c.sock, socketSet, c.recvBuffer);
 			break;
 		}
 
-		// ---- Accept new client if we don't have one ----
+		// ---- Accept new clients while there is room ----
 		if (TCPsocket newClient = SDLNet_TCP_Accept(listening))
 		{
-			if (!clientSock)
+			if (clients.size() < maxClients)
 			{
-				clientSock = newClient;
-				SDLNet_TCP_AddSocket(socketSet, clientSock);
+				HostClient c;
+				c.id = HostFanout::attach(newClient);
+				c.sock = newClient;
+				c.recvBuffer.reserve(4096);
+				SDLNet_TCP_AddSocket(socketSet, newClient);
+				clients.push_back(std::move(c));
 				DebugLog("Host: client connected\n");
 				onConnect = 1;
 			}
 			else
 			{
-				// Only 1 client supported -> close extra connection silently
 				SDLNet_TCP_Close(newClient);
 			}
 		}
 
-		// ---- Batch-send outbound messages to the single client ----
-		if (clientSock)
+		// ---- Fan outbound messages out to every client ----
+		if (!clients.empty())
 		{
-			std::string out;
-			out.reserve(8192);
+			PROFILE_ZONE("connectionTCP::send");
 			std::string msg;
 			int batched = 0;
 			while (batched < 64 && g_txQ.pop(msg))
 			{
-				appendFramed(out, msg);
+				HostFanout::publish(msg);
+				CoopCapture::record(CoopCapture::OUTBOUND, msg);
 				++batched;
 			}
-			// Conflated geoscape snapshots ride the same framed write as the
-			// reliable batch (freshest value only, at link rate -> no backlog).
-			drainSnapshotsInto(out);
-			if (!out.empty())
+			publishSnapshots();
+		}
+
+		// ---- Drop clients whose send failed or that fell too far behind ----
+		for (int id : HostFanout::takeFailed())
+		{
+			for (size_t i = 0; i < clients.size(); ++i)
 			{
-				if (!sendAll(clientSock, out.data(), (int)out.size()))
+				if (clients[i].id == id)
 				{
 					DebugLog("Host: send failed, drop client\n");
-					onConnect = -3;
-					SDLNet_TCP_DelSocket(socketSet, clientSock);
-					SDLNet_TCP_Close(clientSock);
-					clientSock = nullptr;
-					recvBuffer.clear();
+					dropClient(i, -3);
+					break;
 				}
 			}
 		}
 
-		// ---- Receive from client (drain all available bytes) ----
+		// ---- Receive from clients (drain all available bytes) ----
 		int ready = SDLNet_CheckSockets(socketSet, 0); // 0 ms timeout
-		if (ready > 0 && clientSock && SDLNet_SocketReady(clientSock))
+		for (size_t i = 0; ready > 0 && i < clients.size();)
 		{
+			HostClient& c = clients[i];
+			if (!SDLNet_SocketReady(c.sock))
+			{
+				++i;
+				continue;
+			}
+			PROFILE_ZONE("connectionTCP::receive");
+			bool dropped = false;
 			for (;;)
 			{
 				char buf[16 * 1024];
-				int bytes = SDLNet_TCP_Recv(clientSock, buf, sizeof(buf));
+				int bytes = SDLNet_TCP_Recv(c.sock, buf, sizeof(buf));
 				if (bytes <= 0)
 				{
 					DebugLog("Host: client disconnected\n");
-					onConnect = -2;
-					SDLNet_TCP_DelSocket(socketSet, clientSock);
-					SDLNet_TCP_Close(clientSock);
-					clientSock = nullptr;
-					recvBuffer.clear();
+					dropClient(i, -2);
+					dropped = true;
 					break;
 				}
-				recvBuffer.insert(recvBuffer.end(), buf, buf + bytes);
+				c.recvBuffer.insert(c.recvBuffer.end(), buf, buf + bytes);
 				if (bytes < (int)sizeof(buf))
 					break;
 			}
+			if (dropped)
+				continue;
 
 			// Parse frames
-			while (clientSock && recvBuffer.size() >= 4)
+			while (c.recvBuffer.size() >= 4)
 			{
 				uint32_t msgLenNet = 0;
-				std::memcpy(&msgLenNet, recvBuffer.data(), 4);
+				std::memcpy(&msgLenNet, c.recvBuffer.data(), 4);
 				uint32_t msgLen = SDL_SwapBE32(msgLenNet);
 
 				if (msgLen == 0 || msgLen > kMaxMsgLen)
 				{
 					DebugLog("Host: invalid message size, drop client\n");
-					onConnect = -3;
-					SDLNet_TCP_DelSocket(socketSet, clientSock);
-					SDLNet_TCP_Close(clientSock);
-					clientSock = nullptr;
-					recvBuffer.clear();
+					dropClient(i, -3);
+					dropped = true;
 					break;
 				}
 
 				const size_t need = 4ull + static_cast<size_t>(msgLen);
-				if (recvBuffer.size() < need)
+				if (c.recvBuffer.size() < need)
 					break;
 
 				std::string message(
-					reinterpret_cast<const char*>(recvBuffer.data() + 4),
+					reinterpret_cast<const char*>(c.recvBuffer.data() + 4),
 					static_cast<size_t>(msgLen));
 
-				recvBuffer.erase(recvBuffer.begin(), recvBuffer.begin() + need);
+				c.recvBuffer.erase(c.recvBuffer.begin(), c.recvBuffer.begin() + need);
 
 				if (!message.empty())
 				{
+					CoopCapture::record(0, message);
 					Json::CharReaderBuilder rb;
 					std::unique_ptr<Json::CharReader> reader(rb.newCharReader());
 
@@ -2738,7 +2838,7 @@ void connectionTCP::startTCPHost()
 
 					if (reader->parse(begin, end, &obj, &errs))
 					{
-						if (maybeHandlePingOnHost(obj))
+						if (maybeHandlePingOnHost(obj, c.id))
 							continue;
 
 						if (maybeHandlePongOnHost(obj))
@@ -2754,11 +2854,16 @@ void connectionTCP::startTCPHost()
 						DebugLog("RX queue full, dropping message\n");
 				}
 			}
+			if (!dropped)
+				++i;
 		}
 
-		if (clientSock)
+		if (!clients.empty())
 			hostMaybeSendPing();
 
+		// this pass's messages go to the capture file before the next one
+		CoopCapture::flush();
+
 		// ---- Gentle yield if nothing to do ----
 		if (ready == 0 && OpenXcom::g_txQ.empty() && !OpenXcom::anySnapshotDirty())
 		{
@@ -2769,11 +2874,11 @@ void connectionTCP::startTCPHost()
 	}
 
 	// ---- Cleanup ----
-	if (clientSock)
-	{
-		SDLNet_TCP_DelSocket(socketSet, clientSock);
-		SDLNet_TCP_Close(clientSock);
-	}
+	for (auto& c : clients)
+		SDLNet_TCP_DelSocket(socketSet, c.sock);
+	clients.clear();
+	HostFanout::stop();
+	CoopCapture::stop();
 	SDLNet_TCP_DelSocket(socketSet, listening);
 	SDLNet_TCP_Close(listening);
 	SDLNet_FreeSocketSet(socketSet);
@@ -2895,6 +3000,7 @@ long long connectionTCP::getDateTimeCoop() const
 // TCP
 void connectionTCP::onTCPMessage(std::string stateString, Json::Value obj)
 {
+	PROFILE_ZONE("connectionTCP::onTCPMessage");
 
 	// PRD-J03: single early hook routing the shared_* economy protocol into the
 	// SharedEcon dispatch table (the anti-if-chain requirement). If SharedEcon
@@ -4002,6 +4108,13 @@ void connectionTCP::onTCPMessage(std::string stateString, Json::Value obj)
 
 						_game->getSavedGame()->getSavedBattle()->getBattleGame()->teleport(x, y, z, unit);
 
+						// what the walk really cost, wherever it was cut short
+						if (obj.isMember("tu"))
+						{
+							unit->setTimeUnits(obj["tu"].asInt());
+							unit->setCoopEnergy(obj["energy"].asInt());
+						}
+
 						break;
 					}
 				}
@@ -5173,7 +5286,8 @@ void connectionTCP::onTCPMessage(std::string stateString, Json::Value obj)
 						unit->setRespawn(respawn);
 						unit->setSpawnUnitFaction((UnitFaction)spawnUnitFactionInt);
 
-						auto* spawnType = _game->getSavedGame()->getSavedBattle()->getMod()->getUnit(spawnUnitType);
+						auto* battleMod = _game->getSavedGame()->getSavedBattle()->getMod();
+						auto* spawnType = battleMod->getUnitById(battleMod->getRuleId(spawnUnitType));
 						unit->setSpawnUnit(spawnType);
 
 						_game->getSavedGame()->getSavedBattle()->convertUnit(unit);
@@ -10472,6 +10586,42 @@ void connectionTCP::connectTCPServer(std::string ipaddress, std::string str_port
 
 }
 
+/**
+ * Plays the inbound side of a packet capture into this instance, which acts
+ * as a client that just connected: same setup as connectTCPServer(), but a
+ * CoopReplay thread stands in for startTCPClient(). For benchmarks and
+ * protocol regression runs on a headless instance at the main menu.
+ * @param file Capture written by CoopCapture.
+ * @param speed Multiple of the recorded pace, 0 for as fast as possible.
+ */
+void connectionTCP::replayCapture(const std::string& file, double speed)
+{
+	std::vector<CoopCapture::Record> records = CoopCapture::load(file);
+
+	gamePaused = 0;
+	_waitBC = false;
+	_waitBH = false;
+	_battleWindow = false;
+	_battleInit = false;
+	coopInventory = false;
+	coopMissionEnd = false;
+	inventory_battle_window = true;
+
+	if (_clientThread.joinable())
+	{
+		_clientStop = true;
+		_clientThread.join();
+	}
+	CoopReplay::stop();
+	clearNetworkSessionQueues();
+
+	session.beginJoining();
+	resetCoopState(false);
+	onConnect = 1;
+
+	CoopReplay::start(records, speed);
+}
+
 // coop
 void connectionTCP::setConfirmLandingState(ConfirmLandingState* landing)
 {
@@ -10598,6 +10748,7 @@ void connectionTCP::disconnectTCP(bool isMain)
 		connectionTCP::show_inactive_player_inventory = false;
 
 	    OpenXcom::disconnectRendezvousUdp();
+		CoopReplay::stop();
 
 		// Clear all shared TCP/UDP packet queues after the transport is stopped.
 		// This prevents stale packets from the previous session from affecting
@@ -53,6 +53,8 @@
 #include "ChatMenu.h"
 
 #include "../Engine/Options.h"
+#include "../Engine/Logger.h"
+#include "../Engine/LogWriter.h"
 
 #include "../Savegame/Ufo.h"
 #include "../Mod/RuleInventory.h"
@@ -73,12 +75,20 @@ inline void DebugLog(const std::string& msg)
 #ifdef _WIN32
 	OutputDebugStringA(msg.c_str());
 #else
-	std::fprintf(stderr, "%s\n", msg.c_str());
+	if (!OpenXcom::LogWriter::post(msg + "\n", OpenXcom::LogWriter::TO_STDERR))
+	{
+		std::fprintf(stderr, "%s\n", msg.c_str());
+	}
 #endif
 
+	// into the regular log through its writer thread, the crash log reopens
+	// its file and dumps a stack trace for every line
 	if (OpenXcom::Options::logInfoToFile && OpenXcom::Options::debugMode)
 	{
-		CrashHandler::log(msg);
+		if (OpenXcom::LOG_INFO <= OpenXcom::Logger::reportingLevel())
+		{
+			OpenXcom::Logger().get(OpenXcom::LOG_INFO) << msg;
+		}
 	}
 
 }
@@ -88,52 +98,104 @@ inline void DebugLog(const char* msg)
 	DebugLog(std::string(msg));
 }
 
-// Bounded ring buffer of std::string slots. NOTE: despite the name, this is NOT
-// single-producer/single-consumer in this codebase. g_txQ/g_rxQ each have 3+
+// Bounded lock-free ring of std::string slots. NOTE: despite the name, this is
+// NOT single-producer/single-consumer in this codebase. g_txQ/g_rxQ each have 3+
 // producers and 2+ consumers (main thread, network thread, loopData thread, UDP
-// thread, plus clearNetworkSessionQueues). Concurrent buf[] std::string moves on
-// the same slot double-free the heap (the crash mis-symbolized as SDL_FreeRW). So
-// every operation is serialized by an internal mutex that covers the buf[] move,
-// not just the cursor. The name is kept to avoid churn at ~40 call sites.
+// thread, plus clearNetworkSessionQueues). Every slot carries a sequence number
+// that says whose turn it is (position = free for the producer claiming it,
+// position + 1 = filled for the consumer claiming it), and both sides claim a
+// position with one CAS. A slot's std::string is only touched by the single
+// thread that claimed it, so two threads can't move the same buffer (the old
+// double-free, mis-symbolized as SDL_FreeRW). Messages are moved in and out,
+// which swaps the heap buffer instead of copying it. The name is kept to avoid
+// churn at ~40 call sites.
 template <size_t N>
 struct SPSCQueue
 {
-	std::array<std::string, N> buf{};
-	size_t head{0}; // producer writes (guarded by m)
-	size_t tail{0}; // consumer reads  (guarded by m)
-	mutable std::mutex m;
+	struct Slot
+	{
+		std::atomic<size_t> seq;
+		std::string data;
+	};
+	std::array<Slot, N> buf;
+	alignas(64) std::atomic<size_t> head{0}; // next position to fill
+	alignas(64) std::atomic<size_t> tail{0}; // next position to drain
+
+	SPSCQueue()
+	{
+		for (size_t i = 0; i < N; ++i)
+			buf[i].seq.store(i, std::memory_order_relaxed);
+	}
 
 	bool push(std::string&& s)
 	{
-		std::lock_guard<std::mutex> lk(m);
-		size_t n = (head + 1) % N;
-		if (n == tail)
-			return false; // full
-		buf[head] = std::move(s);
-		head = n;
+		size_t pos = head.load(std::memory_order_relaxed);
+		Slot* slot;
+		for (;;)
+		{
+			slot = &buf[pos % N];
+			size_t seq = slot->seq.load(std::memory_order_acquire);
+			std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+			if (diff == 0)
+			{
+				if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+			{
+				return false; // full
+			}
+			else
+			{
+				pos = head.load(std::memory_order_relaxed);
+			}
+		}
+		slot->data = std::move(s);
+		slot->seq.store(pos + 1, std::memory_order_release);
 		return true;
 	}
 
 	bool pop(std::string& out)
 	{
-		std::lock_guard<std::mutex> lk(m);
-		if (tail == head)
-			return false; // empty
-		out = std::move(buf[tail]);
-		tail = (tail + 1) % N;
+		size_t pos = tail.load(std::memory_order_relaxed);
+		Slot* slot;
+		for (;;)
+		{
+			slot = &buf[pos % N];
+			size_t seq = slot->seq.load(std::memory_order_acquire);
+			std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)(pos + 1);
+			if (diff == 0)
+			{
+				if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+			{
+				return false; // empty
+			}
+			else
+			{
+				pos = tail.load(std::memory_order_relaxed);
+			}
+		}
+		out = std::move(slot->data);
+		slot->data.clear();
+		slot->seq.store(pos + N, std::memory_order_release);
 		return true;
 	}
 
+	// True if nothing is ready to pop. A message whose producer is still
+	// writing it counts as not there yet.
 	bool empty() const
 	{
-		std::lock_guard<std::mutex> lk(m);
-		return tail == head;
+		size_t pos = tail.load(std::memory_order_acquire);
+		return buf[pos % N].seq.load(std::memory_order_acquire) != pos + 1;
 	}
 
 	bool full() const
 	{
-		std::lock_guard<std::mutex> lk(m);
-		return ((head + 1) % N) == tail;
+		size_t pos = head.load(std::memory_order_acquire);
+		return (std::ptrdiff_t)buf[pos % N].seq.load(std::memory_order_acquire) - (std::ptrdiff_t)pos < 0;
 	}
 };
 
@@ -326,6 +388,7 @@ class connectionTCP
 	Craft* getSelectedCraft();
 	void hostTCPServer(std::string servername, std::string port);
 	void connectTCPServer(std::string ipaddress, std::string port);
+	void replayCapture(const std::string& file, double speed); // plays a packet capture in as a joining client
 	void onTCPMessage(std::string data, Json::Value obj);
 	void sendBaseFile();
 	void sendMissionFile();
@@ -335,6 +398,7 @@ class connectionTCP
 	int getCurrentTurn();
 	void loadHostMap();
 	static bool getCoopStatic(); // is the player actually connected?
+	static bool hasPendingMessages(); // received packets not yet consumed by updateCoopTask
 	void sendTCPPacketData(std::string data); // Send TCP packet data
 	// Send a full-state geoscape snapshot via the conflation slot (last-write-wins,
 	// never queued FIFO). slot is a CoopSnapSlot. Used by GeoscapeState::think().
@@ -619,7 +683,7 @@ class connectionTCP
 	static bool moveCoopItems;
 
 	int _selectedItemID = -1;
-	std::string _selectedItemType = "";
+	int _selectedItemRuleId = -1;
 
 	bool _coop_promotions = false;
 
@@ -17,6 +17,7 @@
 #include "connection_udp_glue.h"
 #include "../connectionTCP.h"
 #include "connection_rendezvous_glue.h"
+#include "../CoopCapture.h"
 
 #include <array>
 #include <atomic>
@@ -278,14 +279,26 @@ bool startUdpPeer(const std::string& remoteHost,
 	cfg.popTx = [](std::string& out) -> bool
 	{
 		if (g_txQ.pop(out))
+		{
+			CoopCapture::record(CoopCapture::OUTBOUND | CoopCapture::UDP, out);
 			return true;
-		return popSnapshot(out);
+		}
+		if (!popSnapshot(out))
+		{
+			// end of the batch, get it into the capture file
+			CoopCapture::flush();
+			return false;
+		}
+		CoopCapture::record(CoopCapture::OUTBOUND | CoopCapture::SNAPSHOT | CoopCapture::UDP, out);
+		return true;
 	};
 
 	// RX: write exactly the same queue that connectionTCP::updateCoopTask()
 	// already reads before calling connectionTCP::onTCPMessage(...).
 	cfg.pushRx = [](std::string&& msg) -> bool
 	{
+		CoopCapture::record(CoopCapture::UDP, msg);
+
 		if (handleUdpInternalPingPong(msg))
 			return true;
 
@@ -297,9 +310,13 @@ bool startUdpPeer(const std::string& remoteHost,
 		DebugLog(("connectionUDP: " + s + "\n").c_str());
 	};
 
+	if (Options::coopCapturePackets)
+		CoopCapture::start(CoopCapture::makePath(isHost));
+
 	if (!s_connectionUDP->start(cfg))
 	{
 		DebugLog("connectionUDP: start failed\n");
+		CoopCapture::stop();
 
 		s_connectionUDP.reset();
 		s_udpEnabled = false;
@@ -415,6 +432,7 @@ void stopUdpPeer()
 		s_connectionUDP->stop();
 		s_connectionUDP.reset();
 	}
+	CoopCapture::stop();
 
 	// Drop any queued gameplay packets from the old peer.
 	clearNetworkSessionQueues();
@@ -32,6 +32,7 @@
 #include <sys/stat.h>
 #include <assert.h>
 #include "Logger.h"
+#include "LogWriter.h"
 #include "Exception.h"
 #include "Options.h"
 #include "Unicode.h"
@@ -81,6 +82,8 @@
 #include <cxxabi.h>
 #include <dlfcn.h>
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include "Unicode.h"
 #endif		/* #ifdef _WIN32 */
 #include <SDL.h>
@@ -1006,9 +1009,13 @@ bool moveFile(const std::string &src, const std::string &dest)
 	auto dstW = pathToWindows(dest);
 	return (MoveFileExW(srcW.c_str(), dstW.c_str(), MOVEFILE_REPLACE_EXISTING) != 0);
 #else
-	// TODO In fact all remaining uses of this are renaming files inside a single directory
-	// so we may as well uncomment the rename() and drop the rest.
-	//return (rename(src.c_str(), dest.c_str()) == 0);
+	// all the callers rename files inside one directory, where rename() replaces
+	// the file in one step, so a crash can't leave a half-copied save behind
+	if (rename(src.c_str(), dest.c_str()) == 0)
+	{
+		return true;
+	}
+	// different file systems, copy it over
 	std::ifstream srcStream;
 	std::ofstream destStream;
 	srcStream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
@@ -1599,6 +1606,21 @@ static bool logToFile(const std::string& filename, const std::string& data) {
 	return false;
 }
 
+/**
+ * Opens a file with stdio, for the background log writer and
+ * the packet capture, which need to flush it on their own.
+ * @param filename UTF-8 path.
+ * @param append Append to the file instead of replacing it.
+ * @return File handle, or NULL.
+ */
+FILE *openFile(const std::string& filename, bool append) {
+#ifdef _WIN32
+	return _wfopen(pathToWindows(filename).c_str(), append ? L"ab" : L"wb");
+#else
+	return fopen(filename.c_str(), append ? "ab" : "wb");
+#endif
+}
+
 static const size_t LOG_BUFFER_LIMIT = 1<<10;
 static std::list<std::pair<int, std::string>> logBuffer;
 static std::string logFileName;
@@ -1610,6 +1632,7 @@ const std::string& getLogFileName() { return logFileName; }
  * and turns on writing them to the actual log (and flushes the buffer).
  */
 void setLogFileName(const std::string& name) {
+	LogWriter::stop();
 	deleteFile(name);
 	size_t sz = logBuffer.size();
 	Log(LOG_DEBUG) << "setLogFileName("<<name<<") was '"<<logFileName<<"'; "<<sz<<" in buffer";
@@ -1623,6 +1646,16 @@ void log(int level, const std::ostringstream& baremsgstream) {
 	auto msg = msgstream.str();
 
 	int effectiveLevel = Logger::reportingLevel();
+	if (LogWriter::isRunning()) {
+		int targets = LogWriter::TO_FILE | (effectiveLevel >= LOG_DEBUG ? LogWriter::TO_STDERR : 0);
+		if (level != LOG_FATAL) {
+			LogWriter::post(std::move(msg), targets);
+			return;
+		}
+		if (LogWriter::writeNow(msg, targets)) { // about to die, get it on disk before returning
+			return;
+		}
+	}
 	if (effectiveLevel >= LOG_DEBUG) {
 		fwrite(msg.c_str(), msg.size(), 1, stderr);
 		fflush(stderr);
@@ -1650,6 +1683,13 @@ void log(int level, const std::ostringstream& baremsgstream) {
 	// retain the current message if write fails.
 	if (failed || !logToFile(logFileName, msg)) {
 		logBuffer.push_back(std::make_pair(level, msg));
+		return;
+	}
+	// the backlog is out, from now on a background thread keeps the file open and writes in batches
+	if (Options::asyncLogging) {
+		if (FILE *file = openFile(logFileName, true)) {
+			LogWriter::start(file);
+		}
 	}
 }
 
@@ -2089,7 +2129,87 @@ static auto dummyRawFile = ([]
 })();
 #endif
 
+}
 
+/**
+ * Maps the whole file into memory. Empty files can't be mapped.
+ * @param filename - what to map
+ * @return if the file is mapped.
+ */
+bool MappedFile::open(const std::string& filename)
+{
+	close();
+#ifdef _WIN32
+	auto pathW = CrossPlatform::pathToWindows(filename);
+	auto fh = CreateFileW(pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (fh == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(fh, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(fh);
+		return false;
+	}
+	auto mapping = CreateFileMappingW(fh, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(fh);
+	if (mapping == NULL)
+	{
+		return false;
+	}
+	auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == NULL)
+	{
+		CloseHandle(mapping);
+		return false;
+	}
+	_data = view;
+	_size = (std::size_t)size.QuadPart;
+	_mapping = mapping;
+	return true;
+#else
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size == 0)
+	{
+		::close(fd);
+		return false;
+	}
+	void* view = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (view == MAP_FAILED)
+	{
+		return false;
+	}
+	_data = view;
+	_size = (std::size_t)info.st_size;
+	return true;
+#endif
+}
 
+/**
+ * Unmaps the file, all pointers into it become invalid.
+ */
+void MappedFile::close()
+{
+	if (!_data)
+	{
+		return;
+	}
+#ifdef _WIN32
+	UnmapViewOfFile(_data);
+	CloseHandle((HANDLE)_mapping);
+#else
+	munmap(const_cast<void*>(_data), _size);
+#endif
+	_data = nullptr;
+	_size = 0;
+	_mapping = nullptr;
 }
+
 }
@@ -17,6 +17,7 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <cstdio>
 #include <istream>
 #include <SDL.h>
 #include <string>
@@ -170,6 +171,62 @@ protected:
 	}
 };
 
+/**
+ * Read-only view of a whole file mapped into memory.
+ * Pages are loaded by the OS on first access and shared between processes.
+ */
+class MappedFile
+{
+	const void* _data;
+	std::size_t _size;
+	void* _mapping;
+
+public:
+
+	/// Default constructor.
+	MappedFile() : _data{ }, _size{ }, _mapping{ }
+	{
+
+	}
+
+	/// Move constructor.
+	MappedFile(MappedFile&& m) : MappedFile()
+	{
+		*this = std::move(m);
+	}
+
+	/// Move assignment.
+	MappedFile& operator=(MappedFile&& m)
+	{
+		close();
+		_data = std::exchange(m._data, nullptr);
+		_size = std::exchange(m._size, 0u);
+		_mapping = std::exchange(m._mapping, nullptr);
+
+		return *this;
+	}
+
+	/// Unmaps the file.
+	~MappedFile()
+	{
+		close();
+	}
+
+	/// Maps a file into memory, returns false if it can't be done.
+	bool open(const std::string& filename);
+	/// Unmaps the file.
+	void close();
+
+	/// Size of mapped file.
+	std::size_t size() const { return _size; }
+
+	/// Data of mapped file.
+	const void* data() const { return _data; }
+
+	/// Is any file mapped?
+	explicit operator bool() const { return _data; }
+};
+
 /**
  * Generic purpose functions that need different
  * implementations for different platforms.
@@ -239,6 +296,8 @@ namespace CrossPlatform
 	/// Writes out a file
 	bool writeFile(const std::string& filename, const std::string& data);
 	bool writeFile(const std::string& filename, const std::vector<unsigned char>& data);
+	/// Opens a file with stdio, for writers that flush it themselves.
+	FILE *openFile(const std::string& filename, bool append);
 	/// Reads in a file
 	std::unique_ptr<std::istream> readFile(const std::string& filename);
 	/// Reads in a file
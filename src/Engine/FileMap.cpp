@@ -41,6 +41,10 @@
 #include <istream>
 #include <unordered_map>
 #include <unordered_set>
+#include <list>
+#include <mutex>
+#include <algorithm>
+#include <cstring>
 
 #include "FileMap.h"
 #include "Unicode.h"
@@ -205,13 +209,374 @@ static inline std::string concatOptionalPaths(const std::string& basePath, const
 	}
 }
 
+/**
+ * Zip archive shared between the VFS layers mapped from it.
+ * Archives on disk are memory mapped, so stored entries can be
+ * served straight from the mapping and only deflated entries cost
+ * any memory. Archives that can't be mapped (like embedded assets)
+ * are read through SDL_RWops as before.
+ */
+struct ZipContext
+{
+	mz_zip_archive archive;
+	MappedFile file;
+};
+
+static inline mz_zip_archive *zipArchive(void *zip)
+{
+	return &((ZipContext *)zip)->archive;
+}
+
+/**
+ * Entries up to this size are inflated whole and kept in the LRU,
+ * bigger ones are streamed.
+ */
+static const size_t InflatedEntryLimit = 1024 * 1024;
+/**
+ * Total size of the inflated entries kept around for the next read.
+ */
+static const size_t InflatedCacheLimit = 8 * 1024 * 1024;
+
+/**
+ * Recently inflated zip entry.
+ */
+struct InflatedEntry
+{
+	const ZipContext *ctx;
+	mz_uint findex;
+	std::shared_ptr<const std::vector<Uint8>> data;
+};
+
+static std::list<InflatedEntry> InflatedCache;
+static size_t InflatedCacheSize = 0;
+/**
+ * Guards the LRU; the inflation itself runs under it too, as the
+ * readers share the miniz archive state.
+ */
+static std::mutex InflatedCacheMutex;
+
+/**
+ * Drops all inflated entries of a zip context, or all of them.
+ * @param ctx Context to forget, NULL for all.
+ */
+static void inflatedCacheClear(const ZipContext *ctx)
+{
+	std::lock_guard<std::mutex> lock(InflatedCacheMutex);
+	for (auto i = InflatedCache.begin(); i != InflatedCache.end();)
+	{
+		if (ctx == NULL || i->ctx == ctx)
+		{
+			InflatedCacheSize -= i->data->size();
+			i = InflatedCache.erase(i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+/**
+ * Gets an inflated entry, from the LRU if it's still there.
+ * @param ctx Zip context.
+ * @param findex Entry index.
+ * @param size Uncompressed size of the entry.
+ * @return Inflated data or NULL on error.
+ */
+static std::shared_ptr<const std::vector<Uint8>> inflatedCacheGet(ZipContext *ctx, mz_uint findex, size_t size)
+{
+	std::lock_guard<std::mutex> lock(InflatedCacheMutex);
+	for (auto i = InflatedCache.begin(); i != InflatedCache.end(); ++i)
+	{
+		if (i->ctx == ctx && i->findex == findex)
+		{
+			InflatedCache.splice(InflatedCache.begin(), InflatedCache, i);
+			return InflatedCache.front().data;
+		}
+	}
+	auto data = std::make_shared<std::vector<Uint8>>(size);
+	if (size > 0 && !mz_zip_reader_extract_to_mem(&ctx->archive, findex, data->data(), size, 0))
+	{
+		SDL_SetError("miniz extract: %s", mz_zip_get_error_string(mz_zip_get_last_error(&ctx->archive)));
+		return nullptr;
+	}
+	InflatedCache.push_front(InflatedEntry{ ctx, findex, data });
+	InflatedCacheSize += size;
+	while (InflatedCacheSize > InflatedCacheLimit && InflatedCache.size() > 1)
+	{
+		InflatedCacheSize -= InflatedCache.back().data->size();
+		InflatedCache.pop_back();
+	}
+	return data;
+}
+
+/**
+ * Finds the data of an entry that is stored without compression in a mapped archive.
+ * @param ctx Zip context.
+ * @param stat Entry info.
+ * @return Pointer into the mapping or NULL if the entry can't be used directly.
+ */
+static const Uint8 *zipStoredData(const ZipContext *ctx, const mz_zip_archive_file_stat &stat)
+{
+	const size_t LocalHeaderSize = 30;
+	if (!ctx->file || stat.m_method != 0 || stat.m_is_encrypted || stat.m_comp_size != stat.m_uncomp_size)
+	{
+		return NULL;
+	}
+	const Uint8 *base = (const Uint8 *)ctx->file.data();
+	size_t total = ctx->file.size();
+	size_t header = (size_t)stat.m_local_header_ofs;
+	if (header + LocalHeaderSize > total)
+	{
+		return NULL;
+	}
+	Uint32 signature;
+	Uint16 nameLength, extraLength;
+	memcpy(&signature, base + header, sizeof(signature));
+	memcpy(&nameLength, base + header + 26, sizeof(nameLength));
+	memcpy(&extraLength, base + header + 28, sizeof(extraLength));
+	if (SDL_SwapLE32(signature) != 0x04034b50)
+	{
+		return NULL;
+	}
+	size_t offset = header + LocalHeaderSize + SDL_SwapLE16(nameLength) + SDL_SwapLE16(extraLength);
+	if (offset + stat.m_uncomp_size > total)
+	{
+		return NULL;
+	}
+	return base + offset;
+}
+
+/**
+ * Read-only RWops state over memory that is either borrowed
+ * from the archive mapping or shared with the LRU.
+ */
+struct ZipMemoryState
+{
+	std::shared_ptr<const std::vector<Uint8>> owner;
+	const Uint8 *base;
+	int size;
+	int pos;
+};
+
+static int SDLCALL zipMemorySeek(SDL_RWops *context, int offset, int whence)
+{
+	auto *state = (ZipMemoryState *)context->hidden.unknown.data1;
+	int pos = state->pos;
+	switch (whence)
+	{
+		case RW_SEEK_SET: pos = offset; break;
+		case RW_SEEK_CUR: pos += offset; break;
+		case RW_SEEK_END: pos = state->size + offset; break;
+		default: SDL_SetError("Unknown value for 'whence'"); return -1;
+	}
+	state->pos = std::max(0, std::min(pos, state->size));
+	return state->pos;
+}
+
+static int SDLCALL zipMemoryRead(SDL_RWops *context, void *ptr, int size, int maxnum)
+{
+	auto *state = (ZipMemoryState *)context->hidden.unknown.data1;
+	if (size <= 0)
+	{
+		return 0;
+	}
+	int num = std::min(maxnum, (state->size - state->pos) / size);
+	if (num > 0)
+	{
+		memcpy(ptr, state->base + state->pos, (size_t)num * size);
+		state->pos += num * size;
+	}
+	return num;
+}
+
+static int SDLCALL zipReadOnlyWrite(SDL_RWops *, const void *, int, int)
+{
+	SDL_SetError("Can't write to a zip entry");
+	return -1;
+}
+
+static int SDLCALL zipMemoryClose(SDL_RWops *context)
+{
+	if (context)
+	{
+		delete (ZipMemoryState *)context->hidden.unknown.data1;
+		SDL_FreeRW(context);
+	}
+	return 0;
+}
+
+static SDL_RWops *zipMemoryRWops(const Uint8 *base, size_t size, std::shared_ptr<const std::vector<Uint8>> owner)
+{
+	SDL_RWops *rv = SDL_AllocRW();
+	if (!rv)
+	{
+		return NULL;
+	}
+	rv->seek = zipMemorySeek;
+	rv->read = zipMemoryRead;
+	rv->write = zipReadOnlyWrite;
+	rv->close = zipMemoryClose;
+	rv->hidden.unknown.data1 = new ZipMemoryState{ std::move(owner), base, (int)size, 0 };
+	return rv;
+}
+
+/**
+ * RWops state inflating a big entry on the fly.
+ * Seeking back restarts the decompression.
+ */
+struct ZipStreamState
+{
+	ZipContext *ctx;
+	mz_uint findex;
+	mz_zip_reader_extract_iter_state *iter;
+	int size;
+	int pos;
+	int inflated;
+};
+
+static bool zipStreamRestart(ZipStreamState *state)
+{
+	if (state->iter)
+	{
+		mz_zip_reader_extract_iter_free(state->iter);
+	}
+	state->iter = mz_zip_reader_extract_iter_new(&state->ctx->archive, state->findex, 0);
+	state->inflated = 0;
+	if (!state->iter)
+	{
+		SDL_SetError("miniz extract: %s", mz_zip_get_error_string(mz_zip_get_last_error(&state->ctx->archive)));
+		return false;
+	}
+	return true;
+}
+
+static int SDLCALL zipStreamSeek(SDL_RWops *context, int offset, int whence)
+{
+	auto *state = (ZipStreamState *)context->hidden.unknown.data1;
+	int pos = state->pos;
+	switch (whence)
+	{
+		case RW_SEEK_SET: pos = offset; break;
+		case RW_SEEK_CUR: pos += offset; break;
+		case RW_SEEK_END: pos = state->size + offset; break;
+		default: SDL_SetError("Unknown value for 'whence'"); return -1;
+	}
+	// the actual decompression catches up on the next read
+	state->pos = std::max(0, std::min(pos, state->size));
+	return state->pos;
+}
+
+static int SDLCALL zipStreamRead(SDL_RWops *context, void *ptr, int size, int maxnum)
+{
+	auto *state = (ZipStreamState *)context->hidden.unknown.data1;
+	if (size <= 0)
+	{
+		return 0;
+	}
+	if (state->pos < state->inflated || !state->iter)
+	{
+		if (!zipStreamRestart(state))
+		{
+			return -1;
+		}
+	}
+	Uint8 skip[4096];
+	while (state->inflated < state->pos)
+	{
+		size_t chunk = std::min(sizeof(skip), (size_t)(state->pos - state->inflated));
+		size_t read = mz_zip_reader_extract_iter_read(state->iter, skip, chunk);
+		if (read == 0)
+		{
+			return -1;
+		}
+		state->inflated += (int)read;
+	}
+	int num = std::min(maxnum, (state->size - state->pos) / size);
+	if (num <= 0)
+	{
+		return 0;
+	}
+	size_t read = mz_zip_reader_extract_iter_read(state->iter, ptr, (size_t)num * size);
+	state->inflated += (int)read;
+	state->pos = state->inflated;
+	return (int)(read / size);
+}
+
+static int SDLCALL zipStreamClose(SDL_RWops *context)
+{
+	if (context)
+	{
+		auto *state = (ZipStreamState *)context->hidden.unknown.data1;
+		if (state->iter)
+		{
+			mz_zip_reader_extract_iter_free(state->iter);
+		}
+		delete state;
+		SDL_FreeRW(context);
+	}
+	return 0;
+}
+
+static SDL_RWops *zipStreamRWops(ZipContext *ctx, mz_uint findex, size_t size)
+{
+	SDL_RWops *rv = SDL_AllocRW();
+	if (!rv)
+	{
+		return NULL;
+	}
+	rv->seek = zipStreamSeek;
+	rv->read = zipStreamRead;
+	rv->write = zipReadOnlyWrite;
+	rv->close = zipStreamClose;
+	rv->hidden.unknown.data1 = new ZipStreamState{ ctx, findex, NULL, (int)size, 0, 0 };
+	return rv;
+}
+
+/**
+ * Opens a zip entry for reading, picking the cheapest way:
+ * stored entries come straight from the mapping, small deflated
+ * entries go through the LRU and big ones are streamed.
+ * @param ctx Zip context.
+ * @param findex Entry index.
+ * @param stream Can big entries be streamed instead of inflated whole.
+ * @return RWops or NULL on error.
+ */
+static SDL_RWops *zipEntryRWops(ZipContext *ctx, mz_uint findex, bool stream)
+{
+	mz_zip_archive_file_stat stat;
+	if (!mz_zip_reader_file_stat(&ctx->archive, findex, &stat))
+	{
+		SDL_SetError("miniz stat: %s", mz_zip_get_error_string(mz_zip_get_last_error(&ctx->archive)));
+		return NULL;
+	}
+	if (const Uint8 *stored = zipStoredData(ctx, stat))
+	{
+		return zipMemoryRWops(stored, (size_t)stat.m_uncomp_size, nullptr);
+	}
+	if (stat.m_uncomp_size <= InflatedEntryLimit)
+	{
+		auto data = inflatedCacheGet(ctx, findex, (size_t)stat.m_uncomp_size);
+		if (!data)
+		{
+			return NULL;
+		}
+		return zipMemoryRWops(data->data(), data->size(), data);
+	}
+	if (stream)
+	{
+		return zipStreamRWops(ctx, findex, (size_t)stat.m_uncomp_size);
+	}
+	return SDL_RWFromMZ(&ctx->archive, findex);
+}
+
 FileRecord::FileRecord() : fullpath(""), zip(NULL), findex(0) { }
 
 SDL_RWops *FileRecord::getRWops() const
 {
 	SDL_RWops *rv;
 	if (zip != NULL) {
-		rv = SDL_RWFromMZ((mz_zip_archive *)zip, findex);
+		rv = zipEntryRWops((ZipContext *)zip, findex, true);
 	} else {
 		rv = SDL_RWFromFile(fullpath.c_str(), "rb");
 	}
@@ -224,7 +589,7 @@ SDL_RWops *FileRecord::getRWopsReadAll() const
 	SDL_RWops *rv;
 	if (zip != NULL)
 	{
-		rv = SDL_RWFromMZ((mz_zip_archive *)zip, findex);
+		rv = zipEntryRWops((ZipContext *)zip, findex, false);
 	}
 	else
 	{
@@ -262,6 +627,32 @@ SDL_RWops *FileRecord::getRWopsReadAll() const
 	return rv;
 }
 
+Uint64 FileRecord::getFingerprint() const
+{
+	Uint64 size = 0;
+	Uint64 stamp = 0;
+	if (zip != NULL)
+	{
+		mz_zip_archive_file_stat stat;
+		if (mz_zip_reader_file_stat(zipArchive(zip), (mz_uint)findex, &stat))
+		{
+			size = stat.m_uncomp_size;
+			stamp = stat.m_crc32;
+		}
+	}
+	else
+	{
+		SDL_RWops *rw = SDL_RWFromFile(fullpath.c_str(), "rb");
+		if (rw)
+		{
+			size = SDL_RWsize(rw);
+			SDL_RWclose(rw);
+		}
+		stamp = (Uint64)CrossPlatform::getDateModified(fullpath);
+	}
+	return (size << 32) ^ stamp;
+}
+
 std::unique_ptr<std::istream> FileRecord::getIStream() const
 {
 	if (zip != NULL) {
@@ -273,12 +664,22 @@ std::unique_ptr<std::istream> FileRecord::getIStream() const
 
 RawData FileRecord::getUnzippedData() const
 {
+	auto *ctx = (ZipContext *)zip;
+	mz_zip_archive_file_stat stat;
+	if (mz_zip_reader_file_stat(&ctx->archive, (mz_uint)findex, &stat))
+	{
+		// stored entries are borrowed from the mapping, which lives until FileMap::clear()
+		if (const Uint8 *stored = zipStoredData(ctx, stat))
+		{
+			return RawData(const_cast<Uint8 *>(stored), (size_t)stat.m_uncomp_size, +[](void*){});
+		}
+	}
 	size_t size;
-	void* data = mz_zip_reader_extract_to_heap((mz_zip_archive*)zip, findex, &size, 0);
+	void* data = mz_zip_reader_extract_to_heap(&ctx->archive, findex, &size, 0);
 	if (data == NULL)
 	{
 		auto err = "FileRecord::getIStream(): failed to decompress " + fullpath + ": ";
-		err += mz_zip_get_error_string(mz_zip_get_last_error((mz_zip_archive*)zip));
+		err += mz_zip_get_error_string(mz_zip_get_last_error(&ctx->archive));
 		Log(LOG_FATAL) << err;
 		throw Exception(err);
 	}
@@ -360,7 +761,8 @@ static bool isRuleset(const std::string& fname)
 
 typedef std::unordered_map<std::string, FileRecord> FileSet;
 static const NameSet emptySet;
-static mz_zip_archive *newZipContext(const std::string& log_ctx, SDL_RWops *rwops);
+static ZipContext *newZipContext(const std::string& log_ctx, SDL_RWops *rwops);
+static ZipContext *newZipContextFile(const std::string& log_ctx, const std::string& zippath);
 
 struct VFSLayer {
 	std::string fullpath;				// the origin
@@ -422,12 +824,9 @@ struct VFSLayer {
 	*/
 	bool mapZipFile(const std::string& zippath, const std::string& prefix, bool ignore_ruls = false) {
 		std::string log_ctx = "mapZipFile(" + zippath + ",  '" + prefix + "',  '" + (ignore_ruls ? "true" : "false") + "'): ";
-		SDL_RWops *rwops = SDL_RWFromFile(zippath.c_str(), "r");
-		if (!rwops) {
-			Log(LOG_WARNING) << log_ctx << "Ignoring zip '" << zippath << "': " << SDL_GetError();
-			return false;
-		}
-		return mapZipFileRW(rwops, zippath, prefix, ignore_ruls);
+		ZipContext *zip = newZipContextFile(log_ctx, zippath);
+		if (!zip) { return false; }
+		return mapZip(zip, zippath, prefix, ignore_ruls);
 	}
 	/** maps a zipped moddir from an SDL_RWops
 	* @param rwops - SDL_RWops with the zip data
@@ -438,7 +837,7 @@ struct VFSLayer {
 	*/
 	bool mapZipFileRW(SDL_RWops *rwops, const std::string& zippath, const std::string& prefix, bool ignore_ruls = false) {
 		std::string log_ctx = "mapZipFileRW(rwops, '" + zippath + "', '" + prefix + "',  '" + (ignore_ruls ? "true" : "false") + "'): ";
-		mz_zip_archive *zip = newZipContext(log_ctx, rwops);
+		ZipContext *zip = newZipContext(log_ctx, rwops);
 		if (!zip) { return false; }
 		return mapZip(zip, zippath, prefix, ignore_ruls);
 	}
@@ -449,7 +848,7 @@ struct VFSLayer {
 	* @param ignore_ruls - skip rulesets
 	* @return - did we map anything (false, i.e if failed to unzip)
 	*/
-	bool mapZip(mz_zip_archive *zip, const std::string& zippath, const std::string& prefix, bool ignore_ruls = false) {
+	bool mapZip(ZipContext *zip, const std::string& zippath, const std::string& prefix, bool ignore_ruls = false) {
 		std::string log_ctx = "mapZip(zip, '" + zippath + "', '" + prefix + "',  '" + (ignore_ruls ? "true" : "false") + "'): ";
 		if (mapped) {
 			auto err=  log_ctx + "Fatal: already mapped.";
@@ -464,7 +863,7 @@ struct VFSLayer {
 		}
 		mapped = true;
 		fullpath = zippath;
-		mz_uint filecount = mz_zip_reader_get_num_files(zip);
+		mz_uint filecount = mz_zip_reader_get_num_files(&zip->archive);
 
 		FileRecord frec;
 		frec.zip = zip;
@@ -472,7 +871,7 @@ struct VFSLayer {
 		mz_uint mapped_count = 0;
 		for (mz_uint fi = 0; fi < filecount; ++fi) {
 			mz_zip_archive_file_stat fistat;
-			mz_zip_reader_file_stat(zip, fi, &fistat);
+			mz_zip_reader_file_stat(&zip->archive, fi, &fistat);
 
 			std::string fname = fistat.m_filename;
 			if (!sanitizeZipEntryName(fname)) {
@@ -685,7 +1084,7 @@ struct VFS {
 static std::unordered_map<std::string, ModRecord *> ModsAvailable;
 static std::unordered_set<VFSLayer *> MappedVFSLayers; // owned here so we can have some sense of their lifetime
 													   // only the layers that get dropped on FileMap::clear()
-static std::vector<mz_zip_archive *> ZipContexts;	   // zip decompression contexts shared between layers that came from
+static std::vector<ZipContext *> ZipContexts;	   // zip decompression contexts shared between layers that came from
 													   // the same .zip. this makes the whole thing very thread-unsafe
 static VFS TheVFS;
 
@@ -711,21 +1110,40 @@ static void ModsAvailableAdd(std::unique_ptr<ModRecord>&& mrec)
 
 const RSOrder &getRulesets() { return TheVFS.get_rulesets(); }
 
-static mz_zip_archive *newZipContext(const std::string& log_ctx, SDL_RWops *rwops) {
-	mz_zip_archive *zip = (mz_zip_archive *) SDL_malloc(sizeof(mz_zip_archive));
-	if (!zip) {
-		Log(LOG_FATAL) << log_ctx << ": " << SDL_GetError();
-		throw Exception("Out of memory");
-	}
-	if (!mz_zip_reader_init_rwops(zip, rwops)) {
+static ZipContext *newZipContext(const std::string& log_ctx, SDL_RWops *rwops) {
+	auto zip = std::make_unique<ZipContext>();
+	if (!mz_zip_reader_init_rwops(&zip->archive, rwops)) {
 		// whoa, no opening the file
-		Log(LOG_WARNING) << log_ctx << "Ignoring zip: " << mz_zip_get_error_string(mz_zip_get_last_error(zip));
+		Log(LOG_WARNING) << log_ctx << "Ignoring zip: " << mz_zip_get_error_string(mz_zip_get_last_error(&zip->archive));
 		SDL_RWclose(rwops);
-		SDL_free(zip);
 		return NULL;
 	}
-	ZipContexts.push_back(zip);
-	return zip;
+	ZipContexts.push_back(zip.get());
+	return zip.release();
+}
+/**
+ * Opens a .zip from the filesystem, memory mapped if possible.
+ * @param log_ctx - log prefix
+ * @param zippath - path to the .zip
+ */
+static ZipContext *newZipContextFile(const std::string& log_ctx, const std::string& zippath) {
+	auto zip = std::make_unique<ZipContext>();
+	if (zip->file.open(zippath)) {
+		mz_zip_zero_struct(&zip->archive);
+		if (!mz_zip_reader_init_mem(&zip->archive, zip->file.data(), zip->file.size(), 0)) {
+			Log(LOG_WARNING) << log_ctx << "Ignoring zip: " << mz_zip_get_error_string(mz_zip_get_last_error(&zip->archive));
+			return NULL;
+		}
+		ZipContexts.push_back(zip.get());
+		return zip.release();
+	}
+	// can't be mapped, fall back to plain reads
+	SDL_RWops *rwops = SDL_RWFromFile(zippath.c_str(), "rb");
+	if (!rwops) {
+		Log(LOG_WARNING) << log_ctx << "Ignoring zip '" << zippath << "': " << SDL_GetError();
+		return NULL;
+	}
+	return newZipContext(log_ctx, rwops);
 }
 
 void clear(bool clearOnly, bool embeddedOnly) {
@@ -734,7 +1152,12 @@ void clear(bool clearOnly, bool embeddedOnly) {
 	ModsAvailable.clear();
 	for (auto i : MappedVFSLayers ) { delete i; }
 	MappedVFSLayers.clear();
-	for (auto i : ZipContexts) { mz_zip_reader_end_rwops(i); SDL_free(i); }
+	inflatedCacheClear(NULL);
+	for (auto i : ZipContexts) {
+		if (i->file) { mz_zip_reader_end(&i->archive); }
+		else { mz_zip_reader_end_rwops(&i->archive); }
+		delete i;
+	}
 	ZipContexts.clear();
 	if (!clearOnly)
 	{
@@ -878,7 +1301,7 @@ static bool mapExtResources(ModRecord *mrec, const std::string& basename, bool e
  * @param zipfname  - full path to the .zip_open
  * @param prefix    - prefix (subdir) in the .zip if any
  */
-static void mapZippedMod(mz_zip_archive *zip, const std::string& zipfname, const std::string& prefix) {
+static void mapZippedMod(ZipContext *zip, const std::string& zipfname, const std::string& prefix) {
 	std::string log_ctx = "mapZippedMod(" + zipfname + ", '" + prefix + "'): ";
 	auto layer = std::make_unique<VFSLayer>(concatPaths(zipfname, prefix));
 	if (!layer->mapZip(zip, zipfname, prefix)) {
@@ -909,25 +1332,22 @@ static void mapZippedMod(mz_zip_archive *zip, const std::string& zipfname, const
 	ModsAvailableAdd(std::move(mrec));
 }
 /** now this scans a zip of mods or of a single mod
- * @param rwops - SDL_RWops to the zip data
+ * @param mzip - opened zip context
  * @param fullpath - full path to associate with the .zip.
  */
-void scanModZipRW(SDL_RWops *rwops, const std::string& fullpath) {
-	std::string log_ctx = "scanModZipRW(rwops, " + fullpath + "): ";
-	mz_zip_archive *mzip = newZipContext(log_ctx, rwops);
-
-	if (!mzip) { return; }
+static void scanModZipContext(ZipContext *mzip, const std::string& fullpath) {
+	std::string log_ctx = "scanModZipContext(zip, " + fullpath + "): ";
 	// check if this is maybe a zip of a single mod (metadata.yml at the top level)
-	if (mz_zip_reader_locate_file_v2(mzip, "metadata.yml", NULL, 0, NULL)) {
+	if (mz_zip_reader_locate_file_v2(&mzip->archive, "metadata.yml", NULL, 0, NULL)) {
 		Log(LOG_VERBOSE) << log_ctx << "retrying as a single-mod .zip";
 		// FIXME: this doesn't seem to work at all... do we support this?
 		mapZippedMod(mzip, fullpath, "");
 		return;
 	}
-	mz_uint filecount = mz_zip_reader_get_num_files(mzip);
+	mz_uint filecount = mz_zip_reader_get_num_files(&mzip->archive);
 	for (mz_uint fi = 0; fi < filecount; ++fi) {
 		mz_zip_archive_file_stat fistat;
-		mz_zip_reader_file_stat(mzip, fi, &fistat);
+		mz_zip_reader_file_stat(&mzip->archive, fi, &fistat);
 		if (fistat.m_is_encrypted || !fistat.m_is_supported) { continue; }
 		if (!fistat.m_is_directory) { continue; } // skip files, we're only interested in toplevel dirs.
 		std::string prefix = fistat.m_filename;
@@ -943,17 +1363,24 @@ void scanModZipRW(SDL_RWops *rwops, const std::string& fullpath) {
 		mapZippedMod(mzip, fullpath, prefix);
 	}
 }
-/** Filesystem wrapper for scanModZipRW()
+/** SDL_RWops wrapper for scanModZipContext()
+ * @param rwops - SDL_RWops to the zip data
+ * @param fullpath - full path to associate with the .zip.
+ */
+void scanModZipRW(SDL_RWops *rwops, const std::string& fullpath) {
+	std::string log_ctx = "scanModZipRW(rwops, " + fullpath + "): ";
+	ZipContext *mzip = newZipContext(log_ctx, rwops);
+	if (!mzip) { return; }
+	scanModZipContext(mzip, fullpath);
+}
+/** Filesystem wrapper for scanModZipContext(), maps the .zip into memory
  * @param fullpath - full path to the .zip.
  */
 void scanModZip(const std::string& fullpath) {
 	std::string log_ctx = "scanModZip(" + fullpath + "): ";
-	SDL_RWops *rwops = SDL_RWFromFile(fullpath.c_str(), "r");
-	if (!rwops) {
-		Log(LOG_WARNING) << log_ctx << "Ignoring zip: " << SDL_GetError();
-		return;
-	}
-	scanModZipRW(rwops, fullpath);
+	ZipContext *mzip = newZipContextFile(log_ctx, fullpath);
+	if (!mzip) { return; }
+	scanModZipContext(mzip, fullpath);
 }
 /**
  * Extracts a single file to an ConstMem RWops object
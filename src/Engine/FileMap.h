@@ -46,11 +46,14 @@ namespace FileMap
 
 		FileRecord();
 
-		/// Open file warped in RWops.
+		/// Open file warped in RWops. Big zip entries are streamed, so use it from the main thread only.
 		SDL_RWops *getRWops() const;
 		/// Read the whole file to memory and warp in RWops.
 		SDL_RWops *getRWopsReadAll() const;
 
+		/// Gets a cheap identity of the file content, it changes when the file does.
+		Uint64 getFingerprint() const;
+
 		std::unique_ptr<std::istream> getIStream() const;
 		RawData getUnzippedData() const;
 		YAML::YamlRootNodeReader getYAML() const;
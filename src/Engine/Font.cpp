@@ -21,6 +21,7 @@
 #include "Surface.h"
 #include "FileMap.h"
 #include "Unicode.h"
+#include "../Interface/GlyphRunCache.h"
 
 namespace OpenXcom
 {
@@ -39,6 +40,8 @@ Font::Font() : _monospace(false)
  */
 Font::~Font()
 {
+	// cached layouts point into the font images
+	GlyphRunCache::clear();
 	for (auto& fontImage : _images)
 	{
 		delete fontImage.surface;
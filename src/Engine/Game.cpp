@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <cmath>
 #include <sstream>
+#include <iomanip>
 #include <SDL_mixer.h>
 #include "State.h"
 #include "Screen.h"
@@ -30,14 +31,18 @@
 #include "Logger.h"
 #include "../Interface/Cursor.h"
 #include "../Interface/FpsCounter.h"
+#include "../Interface/ProfilerOverlay.h"
 #include "../Mod/Mod.h"
 #include "../Savegame/SavedGame.h"
 #include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/SaveWriter.h"
 #include "Action.h"
 #include "Exception.h"
 #include "Options.h"
 #include "CrossPlatform.h"
 #include "FileMap.h"
+#include "Profiler.h"
+#include "Timer.h"
 #include "Unicode.h"
 #include "../Ufopaedia/UfopaediaStartState.h"
 #include "../Menu/NotesState.h"
@@ -54,13 +59,15 @@ namespace OpenXcom
 {
 
 const double Game::VOLUME_GRADIENT = 10.0;
+/// Longest time the screen goes without a redraw, for states that change without input or timers.
+const int Game::IDLE_REDRAW_INTERVAL = 250;
 
 /**
  * Starts up all the SDL subsystems,
  * creates the display screen and sets up the cursor.
  * @param title Title of the game window.
  */
-Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0), _mod(0), _quit(false), _init(false), _update(false),  _mouseActive(true), _timeUntilNextFrame(0),
+Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0), _mod(0), _quit(false), _init(false), _update(false), _frameRequested(false), _mouseActive(true), _timeUntilNextFrame(0),
 	_ctrl(false), _alt(false), _shift(false), _rmb(false), _mmb(false), _scrollStep(1)
 {
 	Options::reload = false;
@@ -111,6 +118,9 @@ Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0
 	// Create fps counter
 	_fpsCounter = new FpsCounter(15, 5, 0, 0);
 
+	// Create profiler overlay, below the fps counter
+	_profilerOverlay = new ProfilerOverlay(200, 96, 0, 7);
+
 	// Create blank language
 	_lang = new Language();
 
@@ -124,6 +134,7 @@ Game::~Game()
 {
 	Sound::stop();
 	Music::stop();
+	SaveWriter::shutdown();
 
 	for (auto* state : _states)
 	{
@@ -138,6 +149,7 @@ Game::~Game()
 	delete _mod;
 	delete _screen;
 	delete _fpsCounter;
+	delete _profilerOverlay;
 
 	Mix_CloseAudio();
 
@@ -159,22 +171,34 @@ void Game::run()
 	Uint32 lastMouseMoveEvent = 0;
 	Sint16 xrel = 0;
 	Sint16 yrel = 0;
+	// something changed since the last frame was drawn
+	bool dirty = true;
 
 	// coop test automation (active only with OXC_TEST_PORT set)
 	TestServer::instance().startFromEnvironment(this);
 
 	while (!_quit)
 	{
+		Profiler::frameMark();
+		_profilerOverlay->addFrame();
+		Timer::resetPending();
+		if (!Options::idleFramePacing || TestServer::instance().hasPending() || connectionTCP::hasPendingMessages())
+		{
+			dirty = true;
+		}
 
 		// coop test automation command pump
-		TestServer::instance().pump();
+		{
+			PROFILE_ZONE("TestServer::pump");
+			TestServer::instance().pump();
+		}
 
 		// coop tasks
 		try
 		{
 			if (_tcpConnection)
 			{
-
+				PROFILE_ZONE("updateCoopTask");
 				_tcpConnection->updateCoopTask();
 			}
 		}
@@ -205,6 +229,7 @@ void Game::run()
 		if (!_init)
 		{
 			_init = true;
+			dirty = true;
 			_states.back()->init();
 
 			// Unpress buttons
@@ -224,6 +249,7 @@ void Game::run()
 		// Process events
 		while (SDL_PollEvent(&_event))
 		{
+			dirty = true;
 			if (CrossPlatform::isQuitShortcut(_event))
 				_event.type = SDL_QUIT;
 			switch (_event.type)
@@ -435,6 +461,31 @@ void Game::run()
 									}
 								}
 							}
+							// "ctrl-alt-p" profiler overlay, "ctrl-alt-shift-p" profiler trace
+							else if (Profiler::Enabled && action.getDetails()->key.keysym.sym == SDLK_p && isCtrlPressed() && isAltPressed())
+							{
+								if (isShiftPressed())
+								{
+									std::ostringstream ss;
+									int i = 0;
+									do
+									{
+										ss.str("");
+										ss << Options::getMasterUserFolder() << "profile" << std::setfill('0') << std::setw(3) << i << ".json";
+										i++;
+									}
+									while (CrossPlatform::fileExists(ss.str()));
+									if (Profiler::writeTrace(ss.str()))
+									{
+										Log(LOG_INFO) << "Profiler trace written to " << ss.str();
+									}
+								}
+								else
+								{
+									_profilerOverlay->initText(_mod->getFont("FONT_BIG"), _mod->getFont("FONT_SMALL"), _lang);
+									_profilerOverlay->setVisible(!_profilerOverlay->getVisible());
+								}
+							}
 							else if (Options::debug)
 							{
 								if (action.getDetails()->key.keysym.sym == SDLK_t && isCtrlPressed())
@@ -452,7 +503,10 @@ void Game::run()
 
 					}
 
-					_states.back()->handle(&action);
+					{
+						PROFILE_ZONE("State::handle");
+						_states.back()->handle(&action);
+					}
 					break;
 			}
 			if (!_init)
@@ -467,8 +521,17 @@ void Game::run()
 		if (runningState != PAUSED)
 		{
 			// Process logic
-			_states.back()->think();
+			_frameRequested = false;
+			{
+				PROFILE_ZONE("State::think");
+				_states.back()->think();
+			}
 			_fpsCounter->think();
+			_profilerOverlay->think();
+			if (_frameRequested || Timer::hasFired() || SDL_GetTicks() - _timeOfLastFrame >= (Uint32)IDLE_REDRAW_INTERVAL)
+			{
+				dirty = true;
+			}
 			if (Options::FPS > 0 && !(Options::useOpenGL && Options::vSyncForOpenGL))
 			{
 				// Update our FPS delay time based on the time of the last draw.
@@ -481,10 +544,11 @@ void Game::run()
 				_timeUntilNextFrame = 0;
 			}
 
-			if (_init && _timeUntilNextFrame <= 0)
+			if (_init && dirty && _timeUntilNextFrame <= 0)
 			{
 				// make a note of when this frame update occurred.
 				_timeOfLastFrame = SDL_GetTicks();
+				dirty = false;
 				_fpsCounter->addFrame();
 				_screen->clear();
 				std::list<State*>::iterator i = _states.end();
@@ -494,11 +558,15 @@ void Game::run()
 				}
 				while (i != _states.begin() && !(*i)->isScreen());
 
-				for (; i != _states.end(); ++i)
 				{
-					(*i)->blit();
+					PROFILE_ZONE("State::blit");
+					for (; i != _states.end(); ++i)
+					{
+						(*i)->blit();
+					}
 				}
 				_fpsCounter->blit(_screen->getSurface());
+				_profilerOverlay->blit(_screen->getSurface());
 				_cursor->blit(_screen->getSurface());
 
 				// coop
@@ -512,6 +580,7 @@ void Game::run()
 
 				}
 
+				PROFILE_ZONE("Screen::flip");
 				_screen->flip();
 			}
 		}
@@ -520,7 +589,16 @@ void Game::run()
 		switch (runningState)
 		{
 			case RUNNING:
-				SDL_Delay(1); //Save CPU from going 100%
+				if (Options::idleFramePacing && !_frameRequested)
+				{
+					// wake up for the next frame if there's something to draw, otherwise for the next timer
+					int wait = dirty ? _timeUntilNextFrame : std::min(Timer::getPendingTime(), IDLE_REDRAW_INTERVAL - (int)(SDL_GetTicks() - _timeOfLastFrame));
+					waitForWork(wait);
+				}
+				else
+				{
+					SDL_Delay(1); //Save CPU from going 100%
+				}
 				break;
 			case SLOWED: case PAUSED:
 				SDL_Delay(100); break; //More slowing down.
@@ -530,6 +608,33 @@ void Game::run()
 	Options::save();
 }
 
+/**
+ * Sleeps in short slices until the time runs out or something needs
+ * handling right away: SDL events, co-op packets or test server
+ * commands. Always sleeps at least a millisecond, like the old loop.
+ * @param ms Time to wait in milliseconds.
+ */
+void Game::waitForWork(int ms)
+{
+	const int slice = 4;
+	Uint32 start = SDL_GetTicks();
+	for (;;)
+	{
+		int left = ms - (int)(SDL_GetTicks() - start);
+		SDL_Delay(Clamp(left, 1, slice));
+		if (left <= slice)
+		{
+			break;
+		}
+		SDL_Event event;
+		SDL_PumpEvents();
+		if (SDL_PeepEvents(&event, 1, SDL_PEEKEVENT, SDL_ALLEVENTS) > 0 || connectionTCP::hasPendingMessages() || TestServer::instance().hasPending())
+		{
+			break;
+		}
+	}
+}
+
 /**
  * Stops the state machine and the game is shut down.
  */
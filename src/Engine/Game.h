@@ -43,6 +43,7 @@ class SavedGame;
 class Mod;
 class ModInfo;
 class FpsCounter;
+class ProfilerOverlay;
 class Action;
 class GeoscapeState;
 class Base;
@@ -66,14 +67,18 @@ private:
 	std::list<State*> _states, _deleted;
 	SavedGame *_save;
 	Mod *_mod;
-	bool _quit, _init, _update;
+	bool _quit, _init, _update, _frameRequested;
 	FpsCounter *_fpsCounter;
+	ProfilerOverlay *_profilerOverlay;
 	bool _mouseActive;
 	unsigned int _timeOfLastFrame;
 	int _timeUntilNextFrame;
 	bool _ctrl, _alt, _shift, _rmb, _mmb;
 	int _scrollStep;
 	static const double VOLUME_GRADIENT;
+	static const int IDLE_REDRAW_INTERVAL;
+	/// Sleeps until a deadline or until there's input to handle.
+	void waitForWork(int ms);
   public:
 	/// Creates a new game and initializes SDL.
 	Game(const std::string &title);
@@ -95,6 +100,8 @@ private:
 	Cursor *getCursor() const { return _cursor; }
 	/// Gets the FpsCounter.
 	FpsCounter *getFpsCounter() const { return _fpsCounter; }
+	/// Gets the profiler overlay.
+	ProfilerOverlay *getProfilerOverlay() const { return _profilerOverlay; }
 	/// Resets the state stack to a new state.
 	void setState(State *state);
 	/// Pushes a new state into the state stack.
@@ -113,6 +120,8 @@ private:
 	void loadMods();
 	/// Sets whether the mouse cursor is activated.
 	void setMouseActive(bool active);
+	/// Asks for the next cycle to run right away instead of idling.
+	void requestNextFrame() { _frameRequested = true; }
 	/// Returns whether current state is the param state
 	bool isState(State *state) const;
 	/// Returns whether a UfopaediaStartState is in the background.
@@ -0,0 +1,406 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LogWriter.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace OpenXcom
+{
+
+namespace LogWriter
+{
+
+namespace
+{
+
+const size_t Capacity = 8192;
+/// Posting threads wake the writer early once this many lines wait.
+const size_t WakeThreshold = Capacity / 4;
+/// Tries to find a free slot before a line is dropped.
+const int FullRetries = 200;
+
+struct Entry
+{
+	std::string text;
+	std::function<std::string()> format;
+	int targets = 0;
+};
+
+/**
+ * Ring slot. The sequence number says whose turn it is: equal to the
+ * position means free for that producer, position + 1 means filled
+ * and ready for the writer.
+ */
+struct Slot
+{
+	std::atomic<size_t> seq;
+	Entry entry;
+};
+
+std::unique_ptr<Slot[]> ring;
+std::atomic<size_t> enqueuePos(0);
+/// Only the writer moves it, posting threads just peek at the backlog.
+std::atomic<size_t> dequeuePos(0);
+std::atomic<size_t> writtenPos(0);
+std::atomic<unsigned long long> dropped(0);
+unsigned long long droppedReported = 0;
+
+std::atomic<bool> running(false);
+std::atomic<bool> wakeRequested(false);
+std::mutex wakeMutex;
+std::condition_variable wakeSignal;
+std::thread writer;
+/// Set by the writer thread itself, so it can be told apart from the others.
+std::atomic<std::thread::id> writerId;
+/// Serializes start() and stop().
+std::mutex controlMutex;
+FILE *logFile = nullptr;
+
+void wake()
+{
+	wakeRequested.store(true, std::memory_order_release);
+	wakeSignal.notify_one();
+}
+
+/**
+ * Claims a slot and stores the entry, without locking.
+ * @return False if the ring is full.
+ */
+bool tryPush(Entry &entry)
+{
+	size_t pos = enqueuePos.load(std::memory_order_relaxed);
+	Slot *slot;
+	for (;;)
+	{
+		slot = &ring[pos % Capacity];
+		size_t seq = slot->seq.load(std::memory_order_acquire);
+		std::ptrdiff_t diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+		if (diff == 0)
+		{
+			if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			return false;
+		}
+		else
+		{
+			pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+	slot->entry = std::move(entry);
+	slot->seq.store(pos + 1, std::memory_order_release);
+	if (pos - dequeuePos.load(std::memory_order_relaxed) >= WakeThreshold)
+	{
+		wake();
+	}
+	return true;
+}
+
+bool push(Entry &&entry)
+{
+	if (!running.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+	for (int i = 0; i < FullRetries; ++i)
+	{
+		if (tryPush(entry))
+		{
+			return true;
+		}
+		wake();
+		std::this_thread::yield();
+	}
+	dropped++;
+	return true;
+}
+
+/**
+ * Moves every published line into the batches. Only the writer (or
+ * stop() once the writer is gone) may call this.
+ * @return Number of lines taken.
+ */
+size_t drain(std::string &fileBatch, std::string &errBatch)
+{
+	size_t count = 0;
+	for (;;)
+	{
+		size_t pos = dequeuePos.load(std::memory_order_relaxed);
+		Slot *slot = &ring[pos % Capacity];
+		if (slot->seq.load(std::memory_order_acquire) != pos + 1)
+		{
+			break;
+		}
+		Entry entry = std::move(slot->entry);
+		slot->entry = Entry();
+		slot->seq.store(pos + Capacity, std::memory_order_release);
+		dequeuePos.store(pos + 1, std::memory_order_relaxed);
+		++count;
+
+		if (entry.format)
+		{
+			try
+			{
+				entry.text = entry.format();
+			}
+			catch (const std::exception &e)
+			{
+				entry.text = std::string("[log] deferred line failed: ") + e.what() + "\n";
+			}
+		}
+		const std::string &text = entry.text;
+		if (entry.targets & TO_FILE)
+		{
+			fileBatch += text;
+		}
+		if (entry.targets & TO_STDERR)
+		{
+			errBatch += text;
+		}
+	}
+	unsigned long long lost = dropped.load();
+	if (lost != droppedReported)
+	{
+		fileBatch += "[log] " + std::to_string(lost - droppedReported) + " lines dropped, the log writer fell behind\n";
+		droppedReported = lost;
+	}
+	return count;
+}
+
+void writeBatches(std::string &fileBatch, std::string &errBatch)
+{
+	if (!fileBatch.empty() && logFile)
+	{
+		fwrite(fileBatch.data(), 1, fileBatch.size(), logFile);
+		fflush(logFile);
+	}
+	if (!errBatch.empty())
+	{
+		fwrite(errBatch.data(), 1, errBatch.size(), stderr);
+		fflush(stderr);
+	}
+	fileBatch.clear();
+	errBatch.clear();
+	writtenPos.store(dequeuePos.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+void writerLoop()
+{
+	writerId.store(std::this_thread::get_id());
+	std::string fileBatch, errBatch;
+	for (;;)
+	{
+		bool stopping = !running.load(std::memory_order_acquire);
+		if (drain(fileBatch, errBatch) > 0 || !fileBatch.empty())
+		{
+			writeBatches(fileBatch, errBatch);
+			continue;
+		}
+		if (stopping)
+		{
+			break;
+		}
+		std::unique_lock<std::mutex> lock(wakeMutex);
+		wakeSignal.wait_for(lock, std::chrono::milliseconds(20), [] { return wakeRequested.load(std::memory_order_acquire); });
+		wakeRequested.store(false, std::memory_order_relaxed);
+	}
+}
+
+}
+
+/**
+ * Starts the writer. If it's already running the file is just closed.
+ * @param file Log file opened for appending, closed by stop().
+ */
+void start(FILE *file)
+{
+	std::lock_guard<std::mutex> lock(controlMutex);
+	if (running.load())
+	{
+		fclose(file);
+		return;
+	}
+	static bool stopAtExit = false;
+	if (!stopAtExit)
+	{
+		// a still running std::thread would terminate the program on shutdown
+		std::atexit(stop);
+		stopAtExit = true;
+	}
+	if (!ring)
+	{
+		ring.reset(new Slot[Capacity]);
+		for (size_t i = 0; i < Capacity; ++i)
+		{
+			ring[i].seq.store(i, std::memory_order_relaxed);
+		}
+	}
+	// positions keep counting across restarts, line the slots up again
+	size_t pos = enqueuePos.load();
+	for (size_t i = 0; i < Capacity; ++i)
+	{
+		ring[(pos + i) % Capacity].seq.store(pos + i, std::memory_order_relaxed);
+	}
+	dequeuePos.store(pos);
+	writtenPos.store(pos);
+	logFile = file;
+	running.store(true, std::memory_order_release);
+	writer = std::thread(writerLoop);
+}
+
+/**
+ * Stops the writer after it wrote out everything posted before,
+ * and closes the log file.
+ */
+void stop()
+{
+	std::lock_guard<std::mutex> lock(controlMutex);
+	if (!running.exchange(false))
+	{
+		return;
+	}
+	wake();
+	writer.join();
+	// lines that slipped in while the thread was finishing up
+	std::string fileBatch, errBatch;
+	drain(fileBatch, errBatch);
+	writeBatches(fileBatch, errBatch);
+	if (logFile)
+	{
+		fclose(logFile);
+		logFile = nullptr;
+	}
+}
+
+/**
+ * @return True if post() currently accepts lines.
+ */
+bool isRunning()
+{
+	return running.load(std::memory_order_acquire);
+}
+
+/**
+ * Queues a line, the writer writes it within a few milliseconds.
+ * @param text Finished line, including the line break.
+ * @param targets Combination of Target flags.
+ * @return False if the writer isn't running and the caller has to write it.
+ */
+bool post(std::string &&text, int targets)
+{
+	Entry entry;
+	entry.text = std::move(text);
+	entry.targets = targets;
+	return push(std::move(entry));
+}
+
+/**
+ * Queues a line that's expensive to build. The formatter runs on the
+ * writer thread, so it has to own everything it uses.
+ * @param format Builds the line, including the line break.
+ * @param targets Combination of Target flags.
+ * @return False if the writer isn't running and the caller has to write it.
+ */
+bool postDeferred(std::function<std::string()> &&format, int targets)
+{
+	Entry entry;
+	entry.format = std::move(format);
+	entry.targets = targets;
+	return push(std::move(entry));
+}
+
+/**
+ * Waits for everything posted before the call to reach the file.
+ * @param timeoutMs How long to wait at most.
+ * @return True if it got written in time.
+ */
+bool flush(int timeoutMs)
+{
+	if (!running.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+	size_t target = enqueuePos.load();
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+	while ((std::ptrdiff_t)(writtenPos.load(std::memory_order_acquire) - target) < 0)
+	{
+		if (std::chrono::steady_clock::now() > deadline)
+		{
+			return false;
+		}
+		wake();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return true;
+}
+
+/**
+ * Writes a line straight to the file, for fatal errors. Lines posted
+ * before get a short chance to go first, unless this is the writer
+ * thread itself (a deferred formatter crashing), which can't wait for
+ * its own batch.
+ * @param text Finished line, including the line break.
+ * @param targets Combination of Target flags.
+ * @return False if the writer isn't running and the caller has to write it.
+ */
+bool writeNow(const std::string &text, int targets)
+{
+	if (!running.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+	if (writerId.load() != std::this_thread::get_id())
+	{
+		flush(1000);
+	}
+	// stdio locks the stream per call, so this can't tear a batch line
+	if ((targets & TO_FILE) && logFile)
+	{
+		fwrite(text.data(), 1, text.size(), logFile);
+		fflush(logFile);
+	}
+	if (targets & TO_STDERR)
+	{
+		fwrite(text.data(), 1, text.size(), stderr);
+		fflush(stderr);
+	}
+	return true;
+}
+
+/**
+ * @return Lines lost because the ring was full for too long.
+ */
+unsigned long long getDropped()
+{
+	return dropped.load();
+}
+
+}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstdio>
+#include <functional>
+#include <string>
+
+namespace OpenXcom
+{
+
+/**
+ * Background writer for the log. Any thread can post finished lines
+ * into a fixed ring without taking a lock; one writer thread drains
+ * it, keeps the log file open and writes whole batches at once, then
+ * flushes. Lines can also carry a formatter that only runs on the
+ * writer thread, for expensive dumps like packet bodies.
+ *
+ * While the writer isn't running post() refuses everything, so the
+ * caller can fall back to writing directly. Fatal lines skip the ring
+ * with writeNow(), as the process may not live to see the next batch.
+ */
+namespace LogWriter
+{
+	/// Where a line goes.
+	enum Target { TO_FILE = 1, TO_STDERR = 2 };
+
+	/// Starts the writer thread on an open file, which it takes over.
+	void start(FILE *file);
+	/// Writes out everything posted so far and stops the thread.
+	void stop();
+	/// Checks if lines are currently accepted.
+	bool isRunning();
+	/// Queues a finished line.
+	bool post(std::string &&text, int targets);
+	/// Queues a line built on the writer thread.
+	bool postDeferred(std::function<std::string()> &&format, int targets);
+	/// Waits until everything posted so far is written.
+	bool flush(int timeoutMs);
+	/// Writes a line right away on the calling thread.
+	bool writeNow(const std::string &text, int targets);
+	/// Gets the number of lines dropped because the ring stayed full.
+	unsigned long long getDropped();
+}
+
+}
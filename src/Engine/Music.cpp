@@ -50,12 +50,14 @@ Music::~Music()
 
 /**
  * Loads a music file from a specified filename.
+ * The mixer reads the music from its audio thread, so it gets a copy in
+ * memory instead of a stream sharing the zip archive with the main thread.
  * @param filename Filename of the music file.
  */
 void Music::load(const std::string &filename)
 {
 #ifndef __NO_MUSIC
-	load(FileMap::getRWops(filename));
+	load(FileMap::getRWopsReadAll(filename));
 	Log(LOG_VERBOSE)<<"Music::load('" << filename << "')";
 #endif
 }
@@ -197,6 +197,11 @@ void createOptionsOXC()
 #endif
 	_info.push_back(OptionInfo(OPTION_OXC, "rootWindowedMode", &rootWindowedMode, false));
 	_info.push_back(OptionInfo(OPTION_OXC, "backgroundMute", &backgroundMute, false));
+	_info.push_back(OptionInfo(OPTION_OXC, "spriteCache", &spriteCache, true));
+	_info.push_back(OptionInfo(OPTION_OXC, "asyncAutosave", &asyncAutosave, true));
+	_info.push_back(OptionInfo(OPTION_OXC, "geoscapeTimeSkip", &geoscapeTimeSkip, true));
+	_info.push_back(OptionInfo(OPTION_OXC, "idleFramePacing", &idleFramePacing, true));
+	_info.push_back(OptionInfo(OPTION_OXC, "asyncLogging", &asyncLogging, true));
 	_info.push_back(OptionInfo(OPTION_OXC, "soldierDiaries", &soldierDiaries, true));
 }
 
@@ -563,7 +568,8 @@ void createControlsOXCE()
 
 void createOptionsOTHER()
 {
-
+	// coop
+	_info.push_back(OptionInfo(OPTION_OTHER, "coopMaxClients", &coopMaxClients, 1));
 }
 
 void createAdvancedOptionsOTHER()
@@ -581,6 +587,7 @@ void createAdvancedOptionsOTHER()
 	_info.push_back(OptionInfo(OPTION_OTHER, "debugMode", &debugMode, true, "Enable Debug Mode (requires restart)", "STR_AI"));
 	_info.push_back(OptionInfo(OPTION_OTHER, "logInfoToFile", &logInfoToFile, false, "Write INFO messages to log file", "STR_AI"));
 	_info.push_back(OptionInfo(OPTION_OTHER, "logPacketMessages", &logPacketMessages, false, "Write packet messages to log files (heavy logging)", "STR_AI"));
+	_info.push_back(OptionInfo(OPTION_OTHER, "coopCapturePackets", &coopCapturePackets, false, "Record co-op packets to a capture file", "STR_AI"));
 	_info.push_back(OptionInfo(OPTION_OTHER, "EnableHotseatDebugMode", &EnableHotseatDebugMode, false, "Enable Hotseat Debug Mode", "STR_AI"));
 
 }
@@ -8,7 +8,7 @@ OPT int displayWidth, displayHeight, maxFrameSkip, baseXResolution, baseYResolut
 OPT bool fullscreen, asyncBlit, playIntro, useScaleFilter, useHQXFilter, useXBRZFilter, useOpenGL, checkOpenGLErrors, vSyncForOpenGL, useOpenGLSmoothing,
 	autosave, allowResize, borderless, debug, debugUi, fpsCounter, newSeedOnLoad, keepAspectRatio, nonSquarePixelRatio,
 	cursorInBlackBandsInFullscreen, cursorInBlackBandsInWindow, cursorInBlackBandsInBorderlessWindow, maximizeInfoScreens, musicAlwaysLoop, StereoSound, verboseLogging, soldierDiaries, touchEnabled,
-	rootWindowedMode, lazyLoadResources, backgroundMute;
+	rootWindowedMode, lazyLoadResources, backgroundMute, spriteCache, asyncAutosave, geoscapeTimeSkip, idleFramePacing, asyncLogging;
 OPT std::string language, useOpenGLShader;
 OPT KeyboardType keyboardMode;
 OPT SaveSort saveOrder;
@@ -100,7 +100,9 @@ OPT bool EnableXcomEquipmentAliensPVP;
 OPT bool debugMode;
 OPT bool logInfoToFile;
 OPT bool logPacketMessages;
+OPT bool coopCapturePackets;
 OPT bool EnableHotseatDebugMode;
+OPT int coopMaxClients;
 
 OPT bool oxceAlternateCraftEquipmentManagement;
 OPT bool oxceBaseInfoScaleEnabled;
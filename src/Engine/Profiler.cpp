@@ -0,0 +1,242 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include "CrossPlatform.h"
+
+namespace OpenXcom
+{
+
+namespace Profiler
+{
+
+namespace
+{
+
+/// Events kept per thread, about 1.5MB each.
+const Uint64 RingSize = 64 * 1024;
+
+struct Event
+{
+	const char *name;
+	Uint64 start;
+	Uint64 end;
+};
+
+/**
+ * Ring of finished zones, written only by its own thread.
+ * Readers copy a range and then drop whatever the writer
+ * may have overwritten in the meantime.
+ */
+struct ThreadBuffer
+{
+	std::vector<Event> events;
+	std::atomic<Uint64> head;
+	int id;
+	std::string name;
+
+	ThreadBuffer(int threadId) : events(RingSize), head(0), id(threadId), name("thread " + std::to_string(threadId)) { }
+};
+
+const std::chrono::steady_clock::time_point Origin = std::chrono::steady_clock::now();
+
+std::mutex buffersMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+thread_local ThreadBuffer *currentBuffer = 0;
+
+ThreadBuffer *mainBuffer = 0;
+Uint64 frameStart = 0;
+Uint64 frameHead = 0;
+FrameStats lastFrame;
+
+/**
+ * Gets the calling thread's buffer, creating it on first use.
+ * Buffers are never freed, so events of finished threads can
+ * still be exported.
+ */
+ThreadBuffer *getBuffer()
+{
+	if (!currentBuffer)
+	{
+		std::lock_guard<std::mutex> lock(buffersMutex);
+		buffers.push_back(std::make_unique<ThreadBuffer>((int)buffers.size() + 1));
+		currentBuffer = buffers.back().get();
+	}
+	return currentBuffer;
+}
+
+/**
+ * Copies the events still valid in a buffer.
+ */
+void copyEvents(const ThreadBuffer *buffer, std::vector<Event> &out)
+{
+	Uint64 head = buffer->head.load(std::memory_order_acquire);
+	Uint64 first = head > RingSize ? head - RingSize : 0;
+	size_t offset = out.size();
+	for (Uint64 i = first; i < head; ++i)
+	{
+		out.push_back(buffer->events[i % RingSize]);
+	}
+	// the slot of the event being written and everything already published after head are suspect
+	Uint64 after = buffer->head.load(std::memory_order_acquire);
+	Uint64 valid = after + 1 > RingSize ? after + 1 - RingSize : 0;
+	if (valid > first)
+	{
+		out.erase(out.begin() + offset, out.begin() + offset + (size_t)std::min(valid - first, head - first));
+	}
+}
+
+void appendEscaped(std::string &out, const std::string &text)
+{
+	for (char c : text)
+	{
+		if (c == '"' || c == '\\')
+		{
+			out += '\\';
+		}
+		if ((unsigned char)c >= 0x20)
+		{
+			out += c;
+		}
+	}
+}
+
+} // namespace
+
+/**
+ * Gets a monotonic timestamp.
+ * @return Nanoseconds since the profiler started.
+ */
+Uint64 now()
+{
+	return (Uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Origin).count();
+}
+
+/**
+ * Stores a finished zone in the calling thread's ring.
+ * @param name Zone name, must stay valid.
+ * @param start Start timestamp.
+ * @param end End timestamp.
+ */
+void record(const char *name, Uint64 start, Uint64 end)
+{
+	ThreadBuffer *buffer = getBuffer();
+	Uint64 head = buffer->head.load(std::memory_order_relaxed);
+	buffer->events[head % RingSize] = Event{ name, start, end };
+	buffer->head.store(head + 1, std::memory_order_release);
+}
+
+/**
+ * Names the calling thread, shown as the track name in traces.
+ * @param name Thread name.
+ */
+void setThreadName(const char *name)
+{
+	ThreadBuffer *buffer = getBuffer();
+	std::lock_guard<std::mutex> lock(buffersMutex);
+	buffer->name = name;
+}
+
+/**
+ * Closes the current frame and sums up its zones for the overlay.
+ * The first call makes the calling thread the main thread.
+ */
+void frameMark()
+{
+	if (!mainBuffer)
+	{
+		mainBuffer = getBuffer();
+		setThreadName("main");
+	}
+	Uint64 time = now();
+	Uint64 head = mainBuffer->head.load(std::memory_order_relaxed);
+	Uint64 first = std::max(frameHead, head > RingSize ? head - RingSize : 0);
+
+	lastFrame.ms = (time - frameStart) / 1000000.0;
+	lastFrame.zones.clear();
+	for (Uint64 i = first; i < head; ++i)
+	{
+		const Event &event = mainBuffer->events[i % RingSize];
+		auto zone = std::find_if(lastFrame.zones.begin(), lastFrame.zones.end(), [&](const ZoneTotal &z) { return z.name == event.name || strcmp(z.name, event.name) == 0; });
+		if (zone == lastFrame.zones.end())
+		{
+			lastFrame.zones.push_back(ZoneTotal{ event.name, 0.0, 0 });
+			zone = lastFrame.zones.end() - 1;
+		}
+		zone->ms += (event.end - event.start) / 1000000.0;
+		zone->count++;
+	}
+	std::sort(lastFrame.zones.begin(), lastFrame.zones.end(), [](const ZoneTotal &a, const ZoneTotal &b) { return a.ms > b.ms; });
+
+	frameStart = time;
+	frameHead = head;
+}
+
+/**
+ * Gets the main thread zones of the last frame.
+ * @return Frame totals, empty before the first frameMark().
+ */
+const FrameStats &getLastFrame()
+{
+	return lastFrame;
+}
+
+/**
+ * Exports the buffered zones of every thread.
+ * @param filename Path of the JSON file to write.
+ * @return True if it was written.
+ */
+bool writeTrace(const std::string &filename)
+{
+	std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool firstEvent = true;
+	char number[64];
+	std::vector<Event> events;
+	std::lock_guard<std::mutex> lock(buffersMutex);
+	for (const auto &buffer : buffers)
+	{
+		out += firstEvent ? "" : ",";
+		firstEvent = false;
+		out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(buffer->id) + ",\"args\":{\"name\":\"";
+		appendEscaped(out, buffer->name);
+		out += "\"}}";
+
+		events.clear();
+		copyEvents(buffer.get(), events);
+		for (const auto &event : events)
+		{
+			out += ",{\"name\":\"";
+			appendEscaped(out, event.name);
+			snprintf(number, sizeof(number), "%.3f,\"dur\":%.3f", event.start / 1000.0, (event.end - event.start) / 1000.0);
+			out += "\",\"ph\":\"X\",\"pid\":1,\"tid\":" + std::to_string(buffer->id) + ",\"ts\":" + number + "}";
+		}
+	}
+	out += "]}\n";
+	return CrossPlatform::writeFile(filename, out);
+}
+
+}
+
+}
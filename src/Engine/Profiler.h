@@ -0,0 +1,100 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Scoped timing zones for finding frame hitches.
+ * Each thread records finished zones into its own ring buffer,
+ * so recording never takes a lock and only the latest events
+ * are kept. The buffers can be exported as a Chrome trace
+ * (chrome://tracing, Perfetto) and the main thread totals of
+ * each frame feed the in-game overlay.
+ *
+ * Zones are only compiled in with OXCE_PROFILER defined
+ * (the ENABLE_PROFILER CMake option), otherwise PROFILE_ZONE
+ * expands to nothing and the rest of the interface just
+ * reports empty data.
+ */
+namespace Profiler
+{
+#ifdef OXCE_PROFILER
+	const bool Enabled = true;
+#else
+	const bool Enabled = false;
+#endif
+
+	/// Time spent in one zone during a frame, nested zones included.
+	struct ZoneTotal
+	{
+		const char *name;
+		double ms;
+		int count;
+	};
+
+	/// Main thread zones of one frame, the slowest first.
+	struct FrameStats
+	{
+		double ms = 0;
+		std::vector<ZoneTotal> zones;
+	};
+
+	/// Gets the current time in nanoseconds since startup.
+	Uint64 now();
+	/// Records a finished zone on the calling thread.
+	void record(const char *name, Uint64 start, Uint64 end);
+	/// Names the calling thread in exported traces.
+	void setThreadName(const char *name);
+	/// Marks the start of a new frame on the main thread.
+	void frameMark();
+	/// Gets the zone totals of the last finished frame.
+	const FrameStats &getLastFrame();
+	/// Writes all buffered zones as Chrome trace-event JSON.
+	bool writeTrace(const std::string &filename);
+
+	/**
+	 * Times the enclosing scope. The name must outlive the
+	 * profiler, in practice a string literal.
+	 */
+	class Zone
+	{
+		const char *_name;
+		Uint64 _start;
+	public:
+		explicit Zone(const char *name) : _name(name), _start(now()) { }
+		~Zone() { record(_name, _start, now()); }
+		Zone(const Zone &) = delete;
+		Zone &operator=(const Zone &) = delete;
+	};
+}
+
+}
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#ifdef OXCE_PROFILER
+#define PROFILE_ZONE(name) ::OpenXcom::Profiler::Zone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
@@ -0,0 +1,338 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SpriteCache.h"
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+#include "Surface.h"
+#include "CrossPlatform.h"
+#include "Logger.h"
+
+namespace OpenXcom
+{
+
+namespace SpriteCache
+{
+
+namespace
+{
+
+/*
+ * File layout (host byte order, the cache never leaves the machine):
+ *
+ *   header: magic[8], version (u32), entry count (u32), index offset (u64)
+ *   images: width (u16), height (u16), palette (256 * SDL_Color), pixels (width * height)
+ *   index:  per entry fingerprint (u64), offset (u64), size (u32), key length (u16), key
+ */
+const char CacheMagic[8] = { 'O', 'X', 'S', 'P', 'R', 'I', 'T', 'E' };
+const Uint32 CacheVersion = 1;
+const size_t HeaderSize = sizeof(CacheMagic) + sizeof(Uint32) + sizeof(Uint32) + sizeof(Uint64);
+const size_t PaletteSize = 256 * sizeof(SDL_Color);
+
+/**
+ * Image stored in the mapped file.
+ */
+struct MappedEntry
+{
+	Uint64 fingerprint;
+	size_t offset;
+	size_t size;
+};
+
+/**
+ * Image decoded in this session, not yet written to disk.
+ */
+struct PendingEntry
+{
+	Uint64 fingerprint;
+	std::vector<Uint8> data;
+};
+
+std::string _filename;
+MappedFile _file;
+std::unordered_map<std::string, MappedEntry> _mapped;
+std::unordered_map<std::string, PendingEntry> _pending;
+
+template<typename T>
+bool readValue(const Uint8 *&ptr, const Uint8 *end, T &value)
+{
+	if ((size_t)(end - ptr) < sizeof(T))
+	{
+		return false;
+	}
+	memcpy(&value, ptr, sizeof(T));
+	ptr += sizeof(T);
+	return true;
+}
+
+template<typename T>
+void writeValue(std::vector<Uint8> &buffer, T value)
+{
+	const Uint8 *ptr = (const Uint8 *)&value;
+	buffer.insert(buffer.end(), ptr, ptr + sizeof(T));
+}
+
+/**
+ * Parses the index of the mapped file.
+ * @return False if the file is damaged or from other version.
+ */
+bool readIndex()
+{
+	const Uint8 *begin = (const Uint8 *)_file.data();
+	const Uint8 *end = begin + _file.size();
+	const Uint8 *ptr = begin;
+
+	if (_file.size() < HeaderSize || memcmp(ptr, CacheMagic, sizeof(CacheMagic)) != 0)
+	{
+		return false;
+	}
+	ptr += sizeof(CacheMagic);
+
+	Uint32 version = 0, count = 0;
+	Uint64 indexOffset = 0;
+	readValue(ptr, end, version);
+	readValue(ptr, end, count);
+	readValue(ptr, end, indexOffset);
+	if (version != CacheVersion || indexOffset < HeaderSize || indexOffset > _file.size())
+	{
+		return false;
+	}
+
+	ptr = begin + indexOffset;
+	for (Uint32 i = 0; i < count; ++i)
+	{
+		Uint64 fingerprint = 0, offset = 0;
+		Uint32 size = 0;
+		Uint16 keyLength = 0;
+		if (!readValue(ptr, end, fingerprint) || !readValue(ptr, end, offset) || !readValue(ptr, end, size) || !readValue(ptr, end, keyLength))
+		{
+			return false;
+		}
+		if ((size_t)(end - ptr) < keyLength || offset < HeaderSize || offset + size > indexOffset)
+		{
+			return false;
+		}
+		std::string key((const char *)ptr, keyLength);
+		ptr += keyLength;
+		_mapped[key] = MappedEntry{ fingerprint, (size_t)offset, (size_t)size };
+	}
+	return true;
+}
+
+} // namespace
+
+/**
+ * Maps the cache file and reads its index. Missing or damaged
+ * files are not an error, the cache simply starts empty.
+ * @param filename Full path of the cache file.
+ */
+void open(const std::string &filename)
+{
+	close();
+	_filename = filename;
+	if (!CrossPlatform::fileExists(_filename) || !_file.open(_filename))
+	{
+		return;
+	}
+	if (!readIndex())
+	{
+		Log(LOG_WARNING) << "Sprite cache " << _filename << " is invalid, it will be rebuilt.";
+		_mapped.clear();
+		_file.close();
+	}
+	else
+	{
+		Log(LOG_INFO) << "Sprite cache " << _filename << " mapped with " << _mapped.size() << " images.";
+	}
+}
+
+/**
+ * Rewrites the cache file with all still valid mapped images
+ * and images decoded since the last flush. Does nothing
+ * if no image was decoded.
+ */
+void flush()
+{
+	if (_pending.empty() || _filename.empty())
+	{
+		return;
+	}
+
+	std::vector<Uint8> images;
+	std::vector<Uint8> index;
+	Uint32 count = 0;
+	auto addEntry = [&](const std::string &key, Uint64 fingerprint, const Uint8 *data, size_t size)
+	{
+		writeValue<Uint64>(index, fingerprint);
+		writeValue<Uint64>(index, HeaderSize + images.size());
+		writeValue<Uint32>(index, (Uint32)size);
+		writeValue<Uint16>(index, (Uint16)key.size());
+		index.insert(index.end(), key.begin(), key.end());
+		images.insert(images.end(), data, data + size);
+		++count;
+	};
+
+	for (const auto &pair : _mapped)
+	{
+		if (_pending.find(pair.first) == _pending.end())
+		{
+			addEntry(pair.first, pair.second.fingerprint, (const Uint8 *)_file.data() + pair.second.offset, pair.second.size);
+		}
+	}
+	for (const auto &pair : _pending)
+	{
+		addEntry(pair.first, pair.second.fingerprint, pair.second.data.data(), pair.second.data.size());
+	}
+
+	std::vector<Uint8> header;
+	header.insert(header.end(), CacheMagic, CacheMagic + sizeof(CacheMagic));
+	writeValue<Uint32>(header, CacheVersion);
+	writeValue<Uint32>(header, count);
+	writeValue<Uint64>(header, HeaderSize + images.size());
+
+	// the mapped file has to be released before it can be replaced
+	_mapped.clear();
+	_pending.clear();
+	_file.close();
+
+	std::string temp = _filename + ".tmp";
+	SDL_RWops *rw = SDL_RWFromFile(temp.c_str(), "wb");
+	if (!rw)
+	{
+		Log(LOG_WARNING) << "Failed to write sprite cache " << temp << ": " << SDL_GetError();
+		return;
+	}
+	bool ok = SDL_RWwrite(rw, header.data(), header.size(), 1) == 1;
+	ok = ok && (images.empty() || SDL_RWwrite(rw, images.data(), images.size(), 1) == 1);
+	ok = ok && (index.empty() || SDL_RWwrite(rw, index.data(), index.size(), 1) == 1);
+	SDL_RWclose(rw);
+	if (!ok || !CrossPlatform::moveFile(temp, _filename))
+	{
+		Log(LOG_WARNING) << "Failed to write sprite cache " << _filename;
+		CrossPlatform::deleteFile(temp);
+		return;
+	}
+	Log(LOG_INFO) << "Sprite cache " << _filename << " written with " << count << " images.";
+
+	std::string filename = _filename;
+	open(filename);
+}
+
+/**
+ * Writes pending images and unmaps the cache file.
+ */
+void close()
+{
+	flush();
+	_mapped.clear();
+	_pending.clear();
+	_file.close();
+	_filename.clear();
+}
+
+/**
+ * Checks if the cache was opened, otherwise loaded images are not stored.
+ * @return True if the cache is in use.
+ */
+bool isOpen()
+{
+	return !_filename.empty();
+}
+
+/**
+ * Replaces the surface with a cached image.
+ * @param surface Surface to fill.
+ * @param key Full path of the source image.
+ * @param fingerprint Fingerprint of the source image.
+ * @return True if the cache had an up to date image.
+ */
+bool load(Surface *surface, const std::string &key, Uint64 fingerprint)
+{
+	const Uint8 *data = nullptr;
+	size_t size = 0;
+
+	auto pending = _pending.find(key);
+	if (pending != _pending.end())
+	{
+		if (pending->second.fingerprint != fingerprint)
+		{
+			return false;
+		}
+		data = pending->second.data.data();
+		size = pending->second.data.size();
+	}
+	else
+	{
+		auto mapped = _mapped.find(key);
+		if (mapped == _mapped.end() || mapped->second.fingerprint != fingerprint)
+		{
+			return false;
+		}
+		data = (const Uint8 *)_file.data() + mapped->second.offset;
+		size = mapped->second.size;
+	}
+
+	const Uint8 *end = data + size;
+	Uint16 width = 0, height = 0;
+	if (!readValue(data, end, width) || !readValue(data, end, height) || (size_t)(end - data) != PaletteSize + (size_t)width * height)
+	{
+		return false;
+	}
+
+	*surface = Surface(width, height, 0, 0);
+	surface->setPalette((const SDL_Color *)data, 0, 256);
+	data += PaletteSize;
+	for (int y = 0; y < height; ++y)
+	{
+		memcpy(surface->getRaw(0, y), data, width);
+		data += width;
+	}
+	return true;
+}
+
+/**
+ * Copies a decoded image to be written in the next flush.
+ * @param surface Decoded 8bpp surface.
+ * @param key Full path of the source image.
+ * @param fingerprint Fingerprint of the source image.
+ */
+void store(const Surface *surface, const std::string &key, Uint64 fingerprint)
+{
+	if (!isOpen() || !surface || !*surface)
+	{
+		return;
+	}
+	PendingEntry &entry = _pending[key];
+	entry.fingerprint = fingerprint;
+	entry.data.clear();
+	entry.data.reserve(2 * sizeof(Uint16) + PaletteSize + surface->getWidth() * surface->getHeight());
+	writeValue<Uint16>(entry.data, (Uint16)surface->getWidth());
+	writeValue<Uint16>(entry.data, (Uint16)surface->getHeight());
+	const Uint8 *palette = (const Uint8 *)surface->getPalette();
+	entry.data.insert(entry.data.end(), palette, palette + PaletteSize);
+	for (int y = 0; y < surface->getHeight(); ++y)
+	{
+		const Uint8 *row = surface->getRaw(0, y);
+		entry.data.insert(entry.data.end(), row, row + surface->getWidth());
+	}
+}
+
+}
+
+}
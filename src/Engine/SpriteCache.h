@@ -0,0 +1,52 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <SDL.h>
+
+namespace OpenXcom
+{
+
+class Surface;
+
+/**
+ * On-disk cache of decoded 8bpp images (PNG, GIF, ...).
+ * Decoding thousands of mod images on every start is slow,
+ * so the result of `Surface::loadImage` is stored in a single
+ * file that is memory mapped on the next run. Each entry is keyed
+ * by the full path of the image and invalidated by the fingerprint
+ * of the source file.
+ */
+namespace SpriteCache
+{
+	/// Maps the cache file, dropping whatever was mapped before.
+	void open(const std::string &filename);
+	/// Writes newly decoded images back to the cache file.
+	void flush();
+	/// Flushes and unmaps the cache file.
+	void close();
+	/// Is the cache in use?
+	bool isOpen();
+	/// Copies a cached image into the surface, if the source file did not change.
+	bool load(Surface *surface, const std::string &key, Uint64 fingerprint);
+	/// Remembers a freshly decoded image for the next run.
+	void store(const Surface *surface, const std::string &key, Uint64 fingerprint);
+}
+
+}
@@ -29,6 +29,7 @@
 #include "Logger.h"
 #include "SDL2Helpers.h"
 #include "FileMap.h"
+#include "SpriteCache.h"
 #ifdef _WIN32
 #include <malloc.h>
 #endif
@@ -363,7 +364,17 @@ void Surface::loadImage(const std::string &filename)
 	_surface = nullptr;
 
 	Log(LOG_VERBOSE) << "Loading image: " << filename;
-	auto rw = FileMap::getRWops(filename);
+	const FileMap::FileRecord *record = FileMap::at(filename);
+	Uint64 fingerprint = 0;
+	if (SpriteCache::isOpen())
+	{
+		fingerprint = record->getFingerprint();
+		if (SpriteCache::load(this, record->fullpath, fingerprint))
+		{
+			return;
+		}
+	}
+	auto rw = record->getRWops();
 	if (!rw) { return; } // relevant message gets logged in FileMap.
 
 	// Try loading with LodePNG first
@@ -449,6 +460,10 @@ void Surface::loadImage(const std::string &filename)
 			Log(LOG_WARNING) << "Image " << filename << " (from SDL) has incorrect transparent color index " << surface->format->colorkey << " (instead of 0).";
 		}
 	}
+	if (SpriteCache::isOpen())
+	{
+		SpriteCache::store(this, record->fullpath, fingerprint);
+	}
 }
 
 /**
@@ -17,6 +17,8 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Timer.h"
+#include <algorithm>
+#include <climits>
 #include "Game.h"
 #include "Options.h"
 
@@ -41,6 +43,8 @@ Uint32 slowTick()
 
 Uint32 Timer::gameSlowSpeed = 1;
 int Timer::maxFrameSkip = 8; // this is a pretty good default at 60FPS.
+bool Timer::_fired = false;
+int Timer::_pendingTime = INT_MAX;
 
 
 /**
@@ -133,6 +137,13 @@ void Timer::think(State* state, Surface* surface)
 			}
 			_start = slowTick();
 			if (_start > _frameSkipStart) _frameSkipStart = _start; // don't play animations in ffwd to catch up :P
+			_fired = true;
+			now = _start;
+		}
+		if (_running)
+		{
+			Sint64 remaining = std::max<Sint64>(0, _interval - (now - _frameSkipStart)) * gameSlowSpeed;
+			_pendingTime = (int)std::min<Sint64>(_pendingTime, remaining);
 		}
 	}
 }
@@ -164,4 +175,16 @@ void Timer::onTimer(SurfaceHandler handler)
 	_surface = handler;
 }
 
+/**
+ * Forgets the timers seen so far. The game calls this once per
+ * loop, so afterwards it knows if anything fired (the screen may
+ * have changed) and how long it can sleep before the next timer
+ * of the active state needs to run.
+ */
+void Timer::resetPending()
+{
+	_fired = false;
+	_pendingTime = INT_MAX;
+}
+
 }
@@ -39,6 +39,9 @@ public:
 	static Uint32 gameSlowSpeed;
 
 private:
+	static bool _fired;
+	static int _pendingTime;
+
 	Uint32 _start;
 	Uint32 _frameSkipStart;
 	int _interval;
@@ -67,6 +70,12 @@ public:
 	void onTimer(StateHandler handler);
 	/// Hooks a surface action handler to the timer interval.
 	void onTimer(SurfaceHandler handler);
+	/// Starts tracking timers for a new frame.
+	static void resetPending();
+	/// Gets if any timer called its handlers since the reset.
+	static bool hasFired() { return _fired; }
+	/// Gets the real time until the next timer advanced since the reset is due.
+	static int getPendingTime() { return _pendingTime; }
 };
 
 }
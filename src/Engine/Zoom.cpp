@@ -22,6 +22,7 @@
 #include "Surface.h"
 #include "Logger.h"
 #include "Options.h"
+#include "Profiler.h"
 #include "Screen.h"
 
 #include "OpenGL.h"
@@ -667,6 +668,7 @@ bool Zoom::haveSSE2()
  */
 void Zoom::flipWithZoom(SDL_Surface *src, SDL_Surface *dst, int topBlackBand, int bottomBlackBand, int leftBlackBand, int rightBlackBand, OpenGL *glOut)
 {
+	PROFILE_ZONE("Zoom::flipWithZoom");
 	int dstWidth = dst->w - leftBlackBand - rightBlackBand;
 	int dstHeight = dst->h - topBlackBand - bottomBlackBand;
 	if (Screen::useOpenGL())
@@ -453,7 +453,7 @@ void GeoscapeEventState::eventLogic()
 
 		auto addResearchDiaryEntryForEvent = [&](const RuleResearch* discoveredResearch, DiscoverySourceType sourceType, const RuleEvent* sourceEvent, const RuleResearch* sourceResearch)
 		{
-			if (!save->isResearched(discoveredResearch, false) && !save->isResearchRuleStatusDisabled(discoveredResearch->getName()))
+			if (!save->isResearched(discoveredResearch, false) && !save->isResearchRuleStatusDisabled(discoveredResearch))
 			{
 				ResearchDiaryEntry* entry = new ResearchDiaryEntry(discoveredResearch);
 				entry->setDate(save->getTime());
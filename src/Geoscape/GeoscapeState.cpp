@@ -172,7 +172,7 @@ Ufo* temp_ufo = 0;
  * Initializes all the elements in the Geoscape screen.
  * @param game Pointer to the core game.
  */
-GeoscapeState::GeoscapeState() : _pause(false), _zoomInEffectDone(false), _zoomOutEffectDone(false), _minimizedDogfights(0), _slowdownCounter(0)
+GeoscapeState::GeoscapeState() : _pause(false), _zoomInEffectDone(false), _zoomOutEffectDone(false), _maxCraftRadarRange(0), _maxBaseRadarRange(0), _minimizedDogfights(0), _slowdownCounter(0)
 {
 	int screenWidth = Options::baseXGeoscape;
 	int screenHeight = Options::baseYGeoscape;
@@ -1331,6 +1331,9 @@ void GeoscapeState::think()
 {
 	State::think();
 
+	// autosaves are written in the background, their errors show up here
+	SaveGameState::asyncErrors(OPT_GEOSCAPE, _palette);
+
 	_zoomInEffectTimer->think(this, 0);
 	_zoomOutEffectTimer->think(this, 0);
 	_dogfightStartTimer->think(this, 0);
@@ -2403,6 +2406,18 @@ void GeoscapeState::timeAdvance()
 		case TIME_5SEC:
 			time5Seconds();
 		}
+
+		// jump straight to the step before the next 10 minute trigger if nothing
+		// would move until then, the triggers themselves always run as usual
+		if (Options::geoscapeTimeSkip && i + 1 < timeSpan && !_pause)
+		{
+			int limit = std::min(timeSpan - i - 1, _game->getSavedGame()->getTime()->getStepsToTrigger() - 1);
+			int steps = getIdleSteps(limit);
+			if (steps > 0)
+			{
+				i += skipIdleSteps(steps);
+			}
+		}
 	}
 
 	_pause = !_dogfightsToBeStarted.empty() || _zoomInEffectTimer->isRunning() || _zoomOutEffectTimer->isRunning();
@@ -2418,12 +2433,21 @@ void GeoscapeState::timeAdvance()
 const std::vector<Craft*>* GeoscapeState::updateActiveCrafts()
 {
 	_activeCrafts.clear();
+	_activeCraftIndex.clear();
+	_baseIndex.clear();
+	_maxCraftRadarRange = 0;
+	_maxBaseRadarRange = 0;
+	int baseOrder = 0;
 	for (auto* xbase : *_game->getSavedGame()->getBases())
 	{
+		_baseIndex.insert(xbase, baseOrder++);
+		_maxBaseRadarRange = std::max(_maxBaseRadarRange, xbase->getDetectionRange());
 		for (auto* xcraft : *xbase->getCrafts())
 		{
 			if (xcraft->getStatus() == "STR_OUT" && !xcraft->isDestroyed())
 			{
+				_activeCraftIndex.insert(xcraft, (int)_activeCrafts.size());
+				_maxCraftRadarRange = std::max(_maxCraftRadarRange, xcraft->getCraftStats().radarRange);
 				_activeCrafts.push_back(xcraft);
 			}
 		}
@@ -2431,6 +2455,109 @@ const std::vector<Craft*>* GeoscapeState::updateActiveCrafts()
 	return &_activeCrafts;
 }
 
+/**
+ * Checks how many of the following 5 second steps would have no effect
+ * besides the clock and the countdowns handled by skipIdleSteps():
+ * no UFO in flight, no craft out, no dogfight, nothing that rolls dice.
+ * Only valid right after time5Seconds() ran, as it relies on that step
+ * having settled things like UFO cleanup and shield initialization.
+ * @param limit Maximum number of steps wanted.
+ * @return Number of steps that can be skipped.
+ */
+int GeoscapeState::getIdleSteps(int limit) const
+{
+	if (limit <= 0)
+	{
+		return 0;
+	}
+	// time5Seconds() bails out before doing anything
+	if (connectionTCP::no_bases == true || _game->getCoopMod()->isSharedReplica())
+	{
+		return limit;
+	}
+	if (!_dogfights.empty() || !_dogfightsToBeStarted.empty() || _game->getSavedGame()->getEnding() == END_LOSE)
+	{
+		return 0;
+	}
+	if ((_timeSpeed == _btn5Secs || _timeSpeed == _btn1Min) && _game->getMod()->getHunterKillerFastRetarget())
+	{
+		return 0;
+	}
+	for (auto* way : *_game->getSavedGame()->getWaypoints())
+	{
+		if (way->getFollowers()->empty())
+		{
+			return 0;
+		}
+	}
+
+	int steps = limit;
+	for (auto* ufo : *_game->getSavedGame()->getUfos())
+	{
+		switch (ufo->getStatus())
+		{
+		case Ufo::LANDED:
+			// the step that lifts it off must run for real
+			steps = std::min(steps, (int)(ufo->getSecondsRemaining() / 5) - 1);
+			break;
+		case Ufo::CRASHED:
+			if (ufo->getSecondsRemaining() == 0 || !ufo->getDetected())
+			{
+				return 0;
+			}
+			break;
+		case Ufo::IGNORE_ME:
+			break;
+		default:
+			return 0;
+		}
+	}
+	if (steps <= 0)
+	{
+		return 0;
+	}
+
+	for (auto* xbase : *_game->getSavedGame()->getBases())
+	{
+		for (auto* xcraft : *xbase->getCrafts())
+		{
+			if (!xcraft->isIdle())
+			{
+				return 0;
+			}
+			// shield recharge rolls dice every step
+			if (xcraft->getShield() < xcraft->getCraftStats().shieldCapacity && xcraft->getCraftStats().shieldRechargeInGeoscape != 0)
+			{
+				return 0;
+			}
+		}
+	}
+	return steps;
+}
+
+/**
+ * Advances the game as if time5Seconds() ran for each step,
+ * which getIdleSteps() made sure only counts down landed UFOs.
+ * @param steps Number of 5 second steps.
+ * @return Number of steps skipped, never past the next time trigger.
+ */
+int GeoscapeState::skipIdleSteps(int steps)
+{
+	steps = _game->getSavedGame()->getTime()->skip(steps);
+	if (connectionTCP::no_bases == true || _game->getCoopMod()->isSharedReplica())
+	{
+		return steps;
+	}
+	for (auto* ufo : *_game->getSavedGame()->getUfos())
+	{
+		if (ufo->getStatus() == Ufo::LANDED)
+		{
+			ufo->setSecondsRemaining(ufo->getSecondsRemaining() - 5 * steps);
+		}
+	}
+	return steps;
+}
+
 /**
  * Takes care of any game logic that has to
  * run every game second, like craft movement.
@@ -3236,9 +3363,11 @@ void GeoscapeState::ufoHuntingAndEscorting()
 				}
 			}
 
-			// look for more attractive target
-			for (auto* craft : *activeCrafts)
+			// look for more attractive target, only crafts in radar range qualify
+			_activeCraftIndex.query(ufo->getLongitude(), ufo->getLatitude(), Nautical(ufo->getCraftStats().radarRange + 1), _nearbyTargets);
+			for (int i : _nearbyTargets)
 			{
+				auto* craft = (*activeCrafts)[i];
 				if (!craft->isIgnoredByHK() && !craft->getRules()->isUndetectable())
 				{
 					int tmpAttraction = craft->getHunterKillerAttraction(ufo->getHuntMode());
@@ -3326,8 +3455,10 @@ void GeoscapeState::baseHunting()
 			{
 				// Look for nearby craft
 				bool started = false;
-				for (auto* craft : *activeCrafts)
+				_activeCraftIndex.query(ab->getLongitude(), ab->getLatitude(), Nautical(ab->getDeployment()->getBaseDetectionRange() + 1), _nearbyTargets);
+				for (int i : _nearbyTargets)
 				{
+					auto* craft = (*activeCrafts)[i];
 					// Craft is flying (i.e. not in base)
 					if (craft->getStatus() == "STR_OUT" && !craft->isDestroyed() && !craft->getRules()->isUndetectable() && !craft->isIgnoredByHK())
 					{
@@ -3730,18 +3861,68 @@ void GeoscapeState::ufoDetection(Ufo* ufo, const std::vector<Craft*>* activeCraf
 		return (UfoDetection)(value | mask);
 	};
 
+	// Scripts can detect at any range, otherwise an observer beyond its radar
+	// range always fails. Such observers are not asked, but still use up their
+	// roll, so the random sequence is the same as when asking everyone.
+	auto hasScript = [](const auto& script)
+	{
+		auto events = script.dataEvents();
+		return script.data() != nullptr || (events && (events[0] || events[1]));
+	};
+
 	auto detected = DETECTION_NONE;
 	auto alreadyTracked = ufo->getDetected();
 	auto save = _game->getSavedGame();
+	auto& bases = *_game->getSavedGame()->getBases();
 
-	for (auto* base : *_game->getSavedGame()->getBases())
+	if (hasScript(ufo->getRules()->getScript<ModScript::DetectUfoFromBase>()) || _baseIndex.size() != (int)bases.size())
 	{
-		detected = maskBitOr(detected, base->detect(ufo, save, alreadyTracked));
+		for (auto* base : bases)
+		{
+			detected = maskBitOr(detected, base->detect(ufo, save, alreadyTracked));
+		}
+	}
+	else
+	{
+		_baseIndex.query(ufo->getLongitude(), ufo->getLatitude(), Nautical(_maxBaseRadarRange + 1), _nearbyTargets);
+		auto next = _nearbyTargets.begin();
+		for (int i = 0; i < (int)bases.size(); ++i)
+		{
+			if (next != _nearbyTargets.end() && *next == i)
+			{
+				detected = maskBitOr(detected, bases[i]->detect(ufo, save, alreadyTracked));
+				++next;
+			}
+			else
+			{
+				RNG::percent(0);
+			}
+		}
 	}
 
-	for (auto* craft : *activeCrafts)
+	if (hasScript(ufo->getRules()->getScript<ModScript::DetectUfoFromCraft>()) || _activeCraftIndex.size() != (int)activeCrafts->size())
 	{
-		detected = maskBitOr(detected, craft->detect(ufo, save, alreadyTracked));
+		for (auto* craft : *activeCrafts)
+		{
+			detected = maskBitOr(detected, craft->detect(ufo, save, alreadyTracked));
+		}
+	}
+	else
+	{
+		_activeCraftIndex.query(ufo->getLongitude(), ufo->getLatitude(), Nautical(_maxCraftRadarRange + 1), _nearbyTargets);
+		auto next = _nearbyTargets.begin();
+		for (int i = 0; i < (int)activeCrafts->size(); ++i)
+		{
+			if (next != _nearbyTargets.end() && *next == i)
+			{
+				detected = maskBitOr(detected, (*activeCrafts)[i]->detect(ufo, save, alreadyTracked));
+				++next;
+			}
+			else
+			{
+				RNG::percent(0);
+			}
+		}
 	}
 
 	if (!alreadyTracked)
@@ -4121,7 +4302,7 @@ void GeoscapeState::time1Day()
 
 	auto addResearchDiaryEntryForBase = [&](const RuleResearch* discoveredResearch, DiscoverySourceType sourceType, const Base* sourceBase, const RuleResearch* sourceResearch)
 	{
-		if (!saveGame->isResearched(discoveredResearch) && !saveGame->isResearchRuleStatusDisabled(discoveredResearch->getName()))
+		if (!saveGame->isResearched(discoveredResearch) && !saveGame->isResearchRuleStatusDisabled(discoveredResearch))
 		{
 			ResearchDiaryEntry* entry = new ResearchDiaryEntry(discoveredResearch);
 			entry->setDate(saveGame->getTime());
@@ -4444,7 +4625,7 @@ void GeoscapeState::time1Day()
 		std::vector<ResearchProject*> obsolete;
 		for (auto* proj : xbase->getResearch())
 		{
-			if (_game->getSavedGame()->isResearchRuleStatusDisabled(proj->getRules()->getName()))
+			if (_game->getSavedGame()->isResearchRuleStatusDisabled(proj->getRules()))
 			{
 				obsolete.push_back(proj);
 			}
@@ -7234,6 +7415,20 @@ void GeoscapeState::setTimeSpeedIndex(int idx)
 	btns[idx]->mousePress(&a, this);
 }
 
+/**
+ * Stops or restarts the game clock (test harness). While it is held the
+ * geoscape still thinks and shows popups, but time only moves through
+ * direct timeAdvance() calls, so a run doesn't depend on the frame rate.
+ * @param hold True to stop the clock, false to start it again.
+ */
+void GeoscapeState::harnessHoldClock(bool hold)
+{
+	if (hold)
+		_gameTimer->stop();
+	else
+		_gameTimer->start();
+}
+
 /**
  * Updates the scale.
  * @param dX delta of X;
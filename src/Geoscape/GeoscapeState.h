@@ -22,6 +22,7 @@
 #include <map>
 #include <string>
 #include <vector>
+#include "../Savegame/TargetIndex.h"
 
 namespace Json { class Value; }
 
@@ -75,6 +76,9 @@ private:
 	std::list<State*> _popups;
 	std::list<DogfightState*> _dogfights, _dogfightsToBeStarted;
 	std::vector<Craft*> _activeCrafts;
+	TargetIndex _activeCraftIndex, _baseIndex;
+	int _maxCraftRadarRange, _maxBaseRadarRange;
+	std::vector<int> _nearbyTargets;
 	size_t _minimizedDogfights;
 	int _slowdownCounter;
 
@@ -116,6 +120,10 @@ private:
 
 	/// Update list of active crafts.
 	const std::vector<Craft*>* updateActiveCrafts();
+	/// Gets how many of the next 5 second steps would not change anything.
+	int getIdleSteps(int limit) const;
+	/// Skips 5 second steps that would not change anything.
+	int skipIdleSteps(int steps);
 
 	void cbxRegionChange(Action *action);
 	void cbxZoneChange(Action *action);
@@ -274,6 +282,8 @@ public:
 	void btnTimerClick(Action *action);
 	/// Selects a time-speed button by index (0=5s,1=1min,2=5min,3=30min,4=1hr,5=1day). For the test harness.
 	void setTimeSpeedIndex(int idx);
+	/// Stops or restarts the frame-driven game clock, so only explicit timeAdvance() calls move time. For the test harness.
+	void harnessHoldClock(bool hold);
 	/// Updates the co-op ally markers on the speed/toolbar buttons.
 	void updatePeerSpeedIndicators();
 	/// Tells the other player which geoscape sub-screen this player navigated to (0..5).
@@ -309,6 +309,25 @@ struct CreateShadow
 	}
 };
 
+/**
+ * Copies all pixels of a surface of the same size.
+ */
+void copyRaster(Surface *dest, Surface *src)
+{
+	dest->lock();
+	src->lock();
+	ShaderDrawFunc(
+		[](Uint8& destStuff, const Uint8& srcStuff)
+		{
+			destStuff = srcStuff;
+		},
+		ShaderSurface(dest),
+		ShaderSurface(src)
+	);
+	src->unlock();
+	dest->unlock();
+}
+
 struct CreateShadowWithoutCache
 {
 	static inline void func(Uint8& dest, const helper::Offset& offset, const Cord& sun, const Sint16& noise, const int& radius)
@@ -346,6 +365,8 @@ Globe::Globe(Game* game, int cenX, int cenY, int width, int height, int x, int y
 	_countries = new Surface(width, height, x, y);
 	_markers = new Surface(width, height, x, y);
 	_radars = new Surface(width, height, x, y);
+	_land = new Surface(width, height, x, y);
+	_shadowValid = false;
 	_clipper = new FastLineClip(x, x+width, y, y+height);
 
 	// Animation timers
@@ -377,6 +398,7 @@ Globe::~Globe()
 	delete _markers;
 	delete _texture;
 	delete _radars;
+	delete _land;
 	delete _clipper;
 
 	for (auto* polygon : _cacheLand)
@@ -925,6 +947,7 @@ void Globe::setPalette(const SDL_Color *colors, int firstcolor, int ncolors)
 	_countries->setPalette(colors, firstcolor, ncolors);
 	_markers->setPalette(colors, firstcolor, ncolors);
 	_radars->setPalette(colors, firstcolor, ncolors);
+	_land->setPalette(colors, firstcolor, ncolors);
 }
 
 /**
@@ -961,20 +984,40 @@ void Globe::rotate()
 }
 
 /**
- * Draws the whole globe, part by part.
+ * Draws the whole globe, part by part. The ocean and land only
+ * get drawn again when the globe was moved or zoomed, and the
+ * shadow when the terminator moved by a pixel or more. The
+ * overlays are on their own surfaces and always redrawn.
  */
 void Globe::draw()
 {
-	if (_redraw)
+	bool landChanged = _redraw;
+	if (landChanged)
 	{
 		cachePolygons();
+		Surface::draw();
+		drawOcean();
+		drawLand();
+		copyRaster(_land, this);
+	}
+
+	Cord sun = getSunDirection(_cenLon, _cenLat);
+	Cord sunMoved = sun;
+	sunMoved -= _shadowSun;
+	// the terminator moves across the screen by about the angle times the globe radius
+	if (landChanged || !_shadowValid || sunMoved.norm() * _zoomRadius[_zoom] >= 1.0)
+	{
+		if (!landChanged)
+		{
+			copyRaster(this, _land);
+		}
+		drawShadow(sun);
+		_shadowSun = sun;
+		_shadowValid = true;
 	}
-	Surface::draw();
-	drawOcean();
-	drawLand();
+
 	drawRadars();
 	drawFlights();
-	drawShadow();
 	drawMarkers();
 	drawDetail();
 }
@@ -1072,7 +1115,11 @@ Cord Globe::getSunDirection(double lon, double lat) const
 }
 
 
-void Globe::drawShadow()
+/**
+ * Shades the globe surface for the time of day.
+ * @param sun Direction of the sun, from getSunDirection().
+ */
+void Globe::drawShadow(const Cord &sun)
 {
 	if (Options::globeSurfaceCache)
 	{
@@ -1082,7 +1129,7 @@ void Globe::drawShadow()
 		earth.setMove(_cenX-getWidth()/2, _cenY-getHeight()/2);
 
 		lock();
-		ShaderDraw<CreateShadow>(ShaderSurface(this), earth, ShaderScalar(getSunDirection(_cenLon, _cenLat)), noise);
+		ShaderDraw<CreateShadow>(ShaderSurface(this), earth, ShaderScalar(sun), noise);
 		unlock();
 	}
 	else
@@ -1090,7 +1137,7 @@ void Globe::drawShadow()
 		ShaderRepeat<Sint16> noise = ShaderRepeat<Sint16>(SurfaceRaw<Sint16>(static_data.random_noise, static_data.random_surf_size, static_data.random_surf_size));
 
 		lock();
-		ShaderDraw<CreateShadowWithoutCache>(ShaderSurface(this), helper::Offset(_cenX, _cenY), ShaderScalar(getSunDirection(_cenLon, _cenLat)), noise, ShaderScalar(_zoomRadius[_zoom]));
+		ShaderDraw<CreateShadowWithoutCache>(ShaderSurface(this), helper::Offset(_cenX, _cenY), ShaderScalar(sun), noise, ShaderScalar(_zoomRadius[_zoom]));
 		unlock();
 	}
 
@@ -1337,7 +1384,7 @@ void Globe::drawGlobeCircle(double lat, double lon, double radius, int segments,
 			continue;
 		}
 		if (!pointBack(lon1,lat1) && i % frac == 0)
-			XuLine(_radars, this, x, y, x2, y2, 6);
+			XuLine(_radars, _land, x, y, x2, y2, 6);
 		x2=x; y2=y;
 		i++;
 	}
@@ -1698,7 +1745,7 @@ void Globe::drawPath(Surface *surface, double lon1, double lat1, double lon2, do
 
 		if (!pointBack(p1.lon, p1.lat) && !pointBack(p2.lon, p2.lat))
 		{
-			XuLine(surface, this, x1, y1, x2, y2, 8);
+			XuLine(surface, _land, x1, y1, x2, y2, 8);
 		}
 
 		p1 = p2;
@@ -2168,11 +2215,11 @@ void Globe::toggleRadarLines()
  */
 void Globe::resize()
 {
-	Surface *surfaces[4] = {this, _markers, _countries, _radars};
+	Surface *surfaces[5] = {this, _markers, _countries, _radars, _land};
 	int width = Options::baseXGeoscape - 64;
 	int height = Options::baseYGeoscape;
 
-	for (int i = 0; i < 4; ++i)
+	for (int i = 0; i < 5; ++i)
 	{
 		surfaces[i]->setWidth(width);
 		surfaces[i]->setHeight(height);
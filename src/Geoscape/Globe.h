@@ -61,6 +61,11 @@ private:
 	SurfaceSet *_texture, *_markerSet;
 	Game *_game;
 	Surface *_markers, *_countries, *_radars;
+	/// Ocean and land before shading, redrawn only when the globe moves.
+	Surface *_land;
+	/// Sun direction the shadow on the globe surface was drawn for.
+	Cord _shadowSun;
+	bool _shadowValid;
 	bool _hover, _craft;
 	int _blink;
 	Timer *_blinkTimer, *_rotTimer;
@@ -178,7 +183,7 @@ public:
 	/// Draws the land of the globe.
 	void drawLand();
 	/// Draws the shadow.
-	void drawShadow();
+	void drawShadow(const Cord &sun);
 	/// Draws the radar ranges of the globe.
 	void drawRadars();
 	/// Draws the flight paths of the globe.
@@ -0,0 +1,307 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "GlyphRunCache.h"
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+#include "../Engine/Font.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Compares two layout keys.
+ * @param other Other key.
+ * @return True if both give the same layout.
+ */
+bool GlyphRunKey::operator==(const GlyphRunKey &other) const
+{
+	return font == other.font && small == other.small && width == other.width &&
+		wrap == other.wrap && indent == other.indent && ignoreSeparators == other.ignoreSeparators &&
+		align == other.align && direction == other.direction && wrapping == other.wrapping &&
+		text == other.text;
+}
+
+namespace GlyphRunCache
+{
+
+namespace
+{
+
+/// The whole cache is dropped once it holds this many layouts, widgets keep theirs.
+const size_t MaxEntries = 4096;
+
+struct KeyHash
+{
+	size_t operator()(const GlyphRunKey &key) const
+	{
+		size_t h = std::hash<std::string>()(key.text);
+		auto mix = [&h](size_t v) { h ^= v + 0x9e3779b9 + (h << 6) + (h >> 2); };
+		mix(std::hash<const void*>()(key.font));
+		mix(std::hash<const void*>()(key.small));
+		mix((size_t)key.width);
+		mix((size_t)key.wrap | (size_t)key.indent << 1 | (size_t)key.ignoreSeparators << 2 |
+			(size_t)key.align << 3 | (size_t)key.direction << 5 | (size_t)key.wrapping << 6);
+		return h;
+	}
+};
+
+std::unordered_map<GlyphRunKey, std::shared_ptr<const GlyphRun>, KeyHash> runs;
+
+/**
+ * Converts the text to codepoints and splits it into lines,
+ * wordwrapping if needed.
+ */
+void wrapLines(const GlyphRunKey &key, GlyphRun &run)
+{
+	run.text = Unicode::convUtf8ToUtf32(key.text);
+
+	int width = 0, word = 0;
+	size_t space = 0, textIndentation = 0;
+	bool start = true;
+	Font *font = key.font;
+	UString &str = run.text;
+
+	// Go through the text character by character
+	for (size_t c = 0; c <= str.size(); ++c)
+	{
+		// End of the line
+		if (c == str.size() || Unicode::isLinebreak(str[c]))
+		{
+			// Add line measurements for alignment later
+			run.lineWidth.push_back(width);
+			run.lineHeight.push_back(font->getCharSize('\n').h);
+			start = true;
+			width = 0;
+			word = 0;
+
+			if (c == str.size())
+				break;
+			else if (str[c] == Unicode::TOK_NL_SMALL)
+				font = key.small;
+		}
+		// Keep track of spaces for wordwrapping
+		else if (Unicode::isSpace(str[c]) || (!key.ignoreSeparators && Unicode::isSeparator(str[c])))
+		{
+			// Store existing indentation
+			if (c == textIndentation)
+			{
+				textIndentation++;
+			}
+			space = c;
+			start = start && (word == 0); // consider initial spaces still as start of line until first character is met
+			width += font->getCharSize(str[c]).w;
+			word = 0;
+		}
+		// Keep track of the width of the last line and word
+		else if (str[c] != Unicode::TOK_COLOR_FLIP)
+		{
+			int charWidth = font->getCharSize(str[c]).w;
+
+			width += charWidth;
+			word += charWidth;
+
+			// Wordwrap if the last word doesn't fit the line
+			if (key.wrap && width >= key.width && (!start || key.wrapping == WRAP_LETTERS))
+			{
+				size_t indentLocation = c;
+				if (key.wrapping == WRAP_WORDS || Unicode::isSpace(str[c]))
+				{
+					// Go back to the last space and put a linebreak there
+					width -= word;
+					indentLocation = space;
+					if (Unicode::isSpace(str[space]))
+					{
+						width -= font->getCharSize(str[space]).w;
+						str[space] = '\n';
+					}
+					else
+					{
+						str.insert(space+1, 1, '\n');
+						indentLocation++;
+					}
+				}
+				else if (key.wrapping == WRAP_LETTERS)
+				{
+					// Go back to the last letter and put a linebreak there
+					str.insert(c, 1, '\n');
+					width -= charWidth;
+				}
+
+				// Keep initial indentation of text
+				if (textIndentation > 0)
+				{
+					str.insert(indentLocation+1, textIndentation, '\t');
+					indentLocation += textIndentation;
+				}
+				// Indent due to word wrap.
+				if (key.indent)
+				{
+					str.insert(indentLocation+1, 1, '\t');
+					width += font->getCharSize('\t').w;
+				}
+
+				run.lineWidth.push_back(width);
+				run.lineHeight.push_back(font->getCharSize('\n').h);
+				if (key.wrapping == WRAP_WORDS)
+				{
+					width = word;
+				}
+				else if (key.wrapping == WRAP_LETTERS)
+				{
+					width = 0;
+				}
+				start = true;
+			}
+		}
+	}
+}
+
+/**
+ * Calculates the starting X position for a line of text.
+ */
+int getLineX(const GlyphRunKey &key, const GlyphRun &run, size_t line)
+{
+	int x = 0;
+	switch (key.direction)
+	{
+	case DIRECTION_LTR:
+		switch (key.align)
+		{
+		case ALIGN_LEFT:
+			break;
+		case ALIGN_CENTER:
+			x = (int)ceil((key.width + key.font->getSpacing() - run.lineWidth[line]) / 2.0);
+			break;
+		case ALIGN_RIGHT:
+			x = key.width - 1 - run.lineWidth[line];
+			break;
+		}
+		break;
+	case DIRECTION_RTL:
+		switch (key.align)
+		{
+		case ALIGN_LEFT:
+			x = key.width - 1;
+			break;
+		case ALIGN_CENTER:
+			x = key.width - (int)ceil((key.width + key.font->getSpacing() - run.lineWidth[line]) / 2.0);
+			break;
+		case ALIGN_RIGHT:
+			x = run.lineWidth[line];
+			break;
+		}
+		break;
+	}
+	return x;
+}
+
+/**
+ * Places every glyph of the wrapped lines, the same way
+ * drawing them one by one would.
+ */
+void placeGlyphs(const GlyphRunKey &key, GlyphRun &run)
+{
+	int x = getLineX(key, run, 0), y = 0;
+	size_t line = 0;
+	Font *font = key.font;
+	bool secondary = false;
+	int dir = (key.direction == DIRECTION_RTL) ? -1 : 1;
+
+	for (UCode c : run.text)
+	{
+		if (Unicode::isSpace(c) || c == '\t')
+		{
+			x += dir * font->getCharSize(c).w;
+		}
+		else if (Unicode::isLinebreak(c))
+		{
+			line++;
+			y += font->getCharSize(c).h;
+			x = getLineX(key, run, line);
+			if (c == Unicode::TOK_NL_SMALL)
+			{
+				font = key.small;
+			}
+		}
+		else if (c == Unicode::TOK_COLOR_FLIP)
+		{
+			secondary = !secondary;
+		}
+		else
+		{
+			if (dir < 0)
+				x += dir * font->getCharSize(c).w;
+			GlyphSpan span = { font->getChar(c), secondary };
+			span.glyph.setX(x);
+			span.glyph.setY(y);
+			run.spans.push_back(span);
+			if (dir > 0)
+				x += dir * font->getCharSize(c).w;
+		}
+	}
+}
+
+}
+
+/**
+ * Gets the layout of a text. Identical keys share one layout,
+ * so the pointer also tells if a text changed.
+ * @param key Text and settings.
+ * @return Laid out text.
+ */
+std::shared_ptr<const GlyphRun> get(const GlyphRunKey &key)
+{
+	auto i = runs.find(key);
+	if (i != runs.end())
+	{
+		return i->second;
+	}
+	auto run = std::make_shared<GlyphRun>();
+	run->width = key.width;
+	wrapLines(key, *run);
+	placeGlyphs(key, *run);
+	if (runs.size() >= MaxEntries)
+	{
+		runs.clear();
+	}
+	runs.emplace(key, run);
+	return run;
+}
+
+/**
+ * Forgets all layouts. Widgets keep the ones they hold
+ * until they lay out their text again.
+ */
+void clear()
+{
+	runs.clear();
+}
+
+/**
+ * @return Number of cached layouts.
+ */
+size_t size()
+{
+	return runs.size();
+}
+
+}
+
+}
@@ -0,0 +1,88 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <memory>
+#include <string>
+#include <vector>
+#include "../Engine/Language.h"
+#include "../Engine/Surface.h"
+#include "../Engine/Unicode.h"
+#include "Text.h"
+
+namespace OpenXcom
+{
+
+class Font;
+
+/**
+ * Glyph of a laid out text, cropped from its font and placed
+ * relative to the top left corner of the first line.
+ */
+struct GlyphSpan
+{
+	SurfaceCrop glyph;
+	bool secondary;
+};
+
+/**
+ * Text after wordwrapping: the line metrics the Text getters
+ * report, and the glyphs in drawing order.
+ */
+struct GlyphRun
+{
+	UString text;
+	int width;
+	std::vector<int> lineWidth, lineHeight;
+	std::vector<GlyphSpan> spans;
+};
+
+/**
+ * Everything the layout of a text depends on.
+ */
+struct GlyphRunKey
+{
+	std::string text;
+	Font *font, *small;
+	int width;
+	bool wrap, indent, ignoreSeparators;
+	TextHAlign align;
+	TextDirection direction;
+	TextWrapping wrapping;
+
+	bool operator==(const GlyphRunKey &other) const;
+};
+
+/**
+ * Laid out texts shared by all Text widgets. Labels, readouts and
+ * list cells that show the same string at the same width only get
+ * wrapped and split into glyphs once, and a widget that is handed
+ * the string it already shows gets the same run back, so it knows
+ * it doesn't need to draw again.
+ */
+namespace GlyphRunCache
+{
+	/// Gets the layout of a text, doing it only if it isn't cached.
+	std::shared_ptr<const GlyphRun> get(const GlyphRunKey &key);
+	/// Forgets all layouts, for when fonts go away.
+	void clear();
+	/// Gets the number of cached layouts.
+	size_t size();
+}
+
+}
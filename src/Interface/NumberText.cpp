@@ -199,6 +199,8 @@ NumberText::NumberText(int width, int height, int x, int y) : Surface(width, hei
 		// and finally the number itself
 		_chars[i]->blitNShade(_borderedChars[i], 1, 1, 0);
 	}
+	// setValue() skips values it already has, so draw the initial one
+	_redraw = true;
 }
 
 /**
@@ -219,6 +221,10 @@ NumberText::~NumberText()
  */
 void NumberText::setValue(unsigned int value)
 {
+	if (_value == value)
+	{
+		return;
+	}
 	_value = value;
 	_redraw = true;
 }
@@ -238,6 +244,10 @@ unsigned int NumberText::getValue() const
  */
 void NumberText::setColor(Uint8 color)
 {
+	if (_color == color)
+	{
+		return;
+	}
 	_color = color;
 	_redraw = true;
 }
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ProfilerOverlay.h"
+#include <cstdio>
+#include "../Battlescape/BattlePool.h"
+#include "../Engine/Timer.h"
+#include "Text.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates a hidden profiler overlay.
+ * @param width Width in pixels.
+ * @param height Height in pixels.
+ * @param x X position in pixels.
+ * @param y Y position in pixels.
+ */
+ProfilerOverlay::ProfilerOverlay(int width, int height, int x, int y) : Surface(width, height, x, y)
+{
+	_visible = false;
+
+	_timer = new Timer(500);
+	_timer->onTimer((SurfaceHandler)&ProfilerOverlay::update);
+	_timer->start();
+
+	_text = new Text(width, height, 0, 0);
+}
+
+/**
+ * Deletes overlay content.
+ */
+ProfilerOverlay::~ProfilerOverlay()
+{
+	delete _text;
+	delete _timer;
+}
+
+/**
+ * Uses the small font of the loaded mod.
+ * @param big Pointer to large-size font.
+ * @param small Pointer to small-size font.
+ * @param lang Pointer to current language.
+ */
+void ProfilerOverlay::initText(Font *big, Font *small, Language *lang)
+{
+	_text->initText(big, small, lang);
+	_text->setSmall();
+}
+
+/**
+ * Replaces a certain amount of colors in the overlay palette.
+ * @param colors Pointer to the set of colors.
+ * @param firstcolor Offset of the first color to replace.
+ * @param ncolors Amount of colors to replace.
+ */
+void ProfilerOverlay::setPalette(const SDL_Color *colors, int firstcolor, int ncolors)
+{
+	Surface::setPalette(colors, firstcolor, ncolors);
+	_text->setPalette(colors, firstcolor, ncolors);
+}
+
+/**
+ * Sets the text color of the overlay.
+ * @param color The color to set.
+ */
+void ProfilerOverlay::setColor(Uint8 color)
+{
+	_text->setColor(color);
+}
+
+/**
+ * Advances the refresh timer.
+ */
+void ProfilerOverlay::think()
+{
+	_timer->think(0, this);
+}
+
+/**
+ * Keeps the last frame if it's the slowest so far.
+ */
+void ProfilerOverlay::addFrame()
+{
+	const Profiler::FrameStats &frame = Profiler::getLastFrame();
+	if (frame.ms >= _worst.ms)
+	{
+		_worst = frame;
+	}
+}
+
+/**
+ * Lists the slowest zones of the worst frame and, during a battle,
+ * the battle pool allocations of the last turn.
+ */
+void ProfilerOverlay::update()
+{
+	if (!_visible)
+	{
+		_worst = Profiler::FrameStats();
+		return;
+	}
+	char line[128];
+	snprintf(line, sizeof(line), "worst frame %.1f ms\n", _worst.ms);
+	std::string text = line;
+	for (size_t i = 0; i < _worst.zones.size() && i < 8; ++i)
+	{
+		const Profiler::ZoneTotal &zone = _worst.zones[i];
+		snprintf(line, sizeof(line), "%6.2f %3d %s\n", zone.ms, zone.count, zone.name);
+		text += line;
+	}
+	BattlePool::Stats pool = BattlePool::getStats();
+	if (pool.chunkBytes > 0)
+	{
+		const BattlePool::KindStats *k = pool.kinds;
+		snprintf(line, sizeof(line), "battle pool %dK, %dK free\n", (int)(pool.chunkBytes / 1024), (int)(pool.freeBytes / 1024));
+		text += line;
+		snprintf(line, sizeof(line), "last turn u%d i%d s%d e%d p%d\n",
+			(int)k[BattlePool::POOL_UNITS].lastTurnAllocs, (int)k[BattlePool::POOL_ITEMS].lastTurnAllocs, (int)k[BattlePool::POOL_STATES].lastTurnAllocs,
+			(int)k[BattlePool::POOL_EXPLOSIONS].lastTurnAllocs, (int)k[BattlePool::POOL_PROJECTILES].lastTurnAllocs);
+		text += line;
+	}
+	_text->setText(text);
+	_worst = Profiler::FrameStats();
+	_redraw = true;
+}
+
+/**
+ * Draws the zone list.
+ */
+void ProfilerOverlay::draw()
+{
+	Surface::draw();
+	_text->blit(this->getSurface());
+}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../Engine/Surface.h"
+#include "../Engine/Profiler.h"
+
+namespace OpenXcom
+{
+
+class Text;
+class Timer;
+
+/**
+ * Lists the slowest profiler zones of the worst
+ * frame seen in the last half second, so hitches
+ * stay on screen long enough to be read.
+ */
+class ProfilerOverlay : public Surface
+{
+private:
+	Text *_text;
+	Timer *_timer;
+	Profiler::FrameStats _worst;
+public:
+	/// Creates a new profiler overlay.
+	ProfilerOverlay(int width, int height, int x, int y);
+	/// Cleans up the overlay.
+	~ProfilerOverlay();
+	/// Initializes the overlay's text.
+	void initText(Font *big, Font *small, Language *lang) override;
+	/// Sets the overlay's palette.
+	void setPalette(const SDL_Color *colors, int firstcolor = 0, int ncolors = 256) override;
+	/// Sets the overlay's text color.
+	void setColor(Uint8 color) override;
+	/// Advances the refresh timer.
+	void think() override;
+	/// Takes the last frame from the profiler.
+	void addFrame();
+	/// Shows the worst frame since the last update.
+	void update();
+	/// Draws the overlay.
+	void draw() override;
+};
+
+}
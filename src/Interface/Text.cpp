@@ -25,6 +25,7 @@
 #include "../Engine/ShaderDraw.h"
 #include "../Engine/ShaderMove.h"
 #include "../Engine/Action.h"
+#include "GlyphRunCache.h"
 
 namespace OpenXcom
 {
@@ -175,6 +176,7 @@ void Text::setHighContrast(bool contrast)
 void Text::setAlign(TextHAlign align)
 {
 	_align = align;
+	processText();
 	_redraw = true;
 }
 
@@ -217,6 +219,10 @@ TextVAlign Text::getVerticalAlign() const
  */
 void Text::setColor(Uint8 color)
 {
+	if (_color == color && _color2 == color)
+	{
+		return;
+	}
 	_color = color;
 	_color2 = color;
 	_redraw = true;
@@ -239,6 +245,10 @@ Uint8 Text::getColor() const
  */
 void Text::setSecondaryColor(Uint8 color)
 {
+	if (_color2 == color)
+	{
+		return;
+	}
 	_color2 = color;
 	_redraw = true;
 }
@@ -254,7 +264,11 @@ Uint8 Text::getSecondaryColor() const
 
 int Text::getNumLines() const
 {
-	return _wrap ? _lineHeight.size() : 1;
+	if (!_run)
+	{
+		return _wrap ? 0 : 1;
+	}
+	return _wrap ? _run->lineHeight.size() : 1;
 }
 
 /**
@@ -264,10 +278,14 @@ int Text::getNumLines() const
  */
 int Text::getTextHeight(int line) const
 {
+	if (!_run)
+	{
+		return 0;
+	}
 	if (line == -1)
 	{
 		int height = 0;
-		for (int lh : _lineHeight)
+		for (int lh : _run->lineHeight)
 		{
 			height += lh;
 		}
@@ -275,7 +293,7 @@ int Text::getTextHeight(int line) const
 	}
 	else
 	{
-		return _lineHeight[line];
+		return _run->lineHeight[line];
 	}
 }
 
@@ -286,10 +304,14 @@ int Text::getTextHeight(int line) const
  */
 int Text::getTextWidth(int line) const
 {
+	if (!_run)
+	{
+		return 0;
+	}
 	if (line == -1)
 	{
 		int width = 0;
-		for (int lw : _lineWidth)
+		for (int lw : _run->lineWidth)
 		{
 			if (lw > width)
 			{
@@ -300,7 +322,7 @@ int Text::getTextWidth(int line) const
 	}
 	else
 	{
-		return _lineWidth[line];
+		return _run->lineWidth[line];
 	}
 }
 
@@ -316,112 +338,25 @@ void Text::processText()
 		return;
 	}
 
-	_processedText = Unicode::convUtf8ToUtf32(_text);
-	_lineWidth.clear();
-	_lineHeight.clear();
-	_scrollY = 0;
-
-	int width = 0, word = 0;
-	size_t space = 0, textIndentation = 0;
-	bool start = true;
-	Font *font = _font;
-	UString &str = _processedText;
-
-	// Go through the text character by character
-	for (size_t c = 0; c <= str.size(); ++c)
+	GlyphRunKey key;
+	key.text = _text;
+	key.font = _font;
+	key.small = _small;
+	key.width = getWidth();
+	key.wrap = _wrap;
+	key.indent = _indent;
+	key.ignoreSeparators = _ignoreSeparators;
+	key.align = _align;
+	key.direction = _lang->getTextDirection();
+	key.wrapping = _lang->getTextWrapping();
+	std::shared_ptr<const GlyphRun> run = GlyphRunCache::get(key);
+	// the same text laid out the same way looks the same, keep what's drawn
+	if (run != _run)
 	{
-		// End of the line
-		if (c == str.size() || Unicode::isLinebreak(str[c]))
-		{
-			// Add line measurements for alignment later
-			_lineWidth.push_back(width);
-			_lineHeight.push_back(font->getCharSize('\n').h);
-			start = true;
-			width = 0;
-			word = 0;
-
-			if (c == str.size())
-				break;
-			else if (str[c] == Unicode::TOK_NL_SMALL)
-				font = _small;
-		}
-		// Keep track of spaces for wordwrapping
-		else if (Unicode::isSpace(str[c]) || (!_ignoreSeparators && Unicode::isSeparator(str[c])))
-		{
-			// Store existing indentation
-			if (c == textIndentation)
-			{
-				textIndentation++;
-			}
-			space = c;
-			start = start && (word == 0); // consider initial spaces still as start of line until first character is met
-			width += font->getCharSize(str[c]).w;
-			word = 0;
-		}
-		// Keep track of the width of the last line and word
-		else if (str[c] != Unicode::TOK_COLOR_FLIP)
-		{
-			int charWidth = font->getCharSize(str[c]).w;
-
-			width += charWidth;
-			word += charWidth;
-
-			// Wordwrap if the last word doesn't fit the line
-			if (_wrap && width >= getWidth() && (!start || _lang->getTextWrapping() == WRAP_LETTERS))
-			{
-				size_t indentLocation = c;
-				if (_lang->getTextWrapping() == WRAP_WORDS || Unicode::isSpace(str[c]))
-				{
-					// Go back to the last space and put a linebreak there
-					width -= word;
-					indentLocation = space;
-					if (Unicode::isSpace(str[space]))
-					{
-						width -= font->getCharSize(str[space]).w;
-						str[space] = '\n';
-					}
-					else
-					{
-						str.insert(space+1, 1, '\n');
-						indentLocation++;
-					}
-				}
-				else if (_lang->getTextWrapping() == WRAP_LETTERS)
-				{
-					// Go back to the last letter and put a linebreak there
-					str.insert(c, 1, '\n');
-					width -= charWidth;
-				}
-
-				// Keep initial indentation of text
-				if (textIndentation > 0)
-				{
-					str.insert(indentLocation+1, textIndentation, '\t');
-					indentLocation += textIndentation;
-				}
-				// Indent due to word wrap.
-				if (_indent)
-				{
-					str.insert(indentLocation+1, 1, '\t');
-					width += font->getCharSize('\t').w;
-				}
-
-				_lineWidth.push_back(width);
-				_lineHeight.push_back(font->getCharSize('\n').h);
-				if (_lang->getTextWrapping() == WRAP_WORDS)
-				{
-					width = word;
-				}
-				else if (_lang->getTextWrapping() == WRAP_LETTERS)
-				{
-					width = 0;
-				}
-				start = true;
-			}
-		}
+		_run = std::move(run);
+		_scrollY = 0;
+		_redraw = true;
 	}
-
-	_redraw = true;
 }
 
 namespace
@@ -441,55 +376,19 @@ struct PaletteShift
 
 } //namespace
 
-/**
- * Calculates the starting X position for a line of text.
- * @param line The line number (0 = first, etc).
- * @return The X position in pixels.
- */
-int Text::getLineX(int line) const
-{
-	int x = 0;
-	switch (_lang->getTextDirection())
-	{
-	case DIRECTION_LTR:
-		switch (_align)
-		{
-		case ALIGN_LEFT:
-			break;
-		case ALIGN_CENTER:
-			x = (int)ceil((getWidth() + _font->getSpacing() - _lineWidth[line]) / 2.0);
-			break;
-		case ALIGN_RIGHT:
-			x = getWidth() - 1 - _lineWidth[line];
-			break;
-		}
-		break;
-	case DIRECTION_RTL:
-		switch (_align)
-		{
-		case ALIGN_LEFT:
-			x = getWidth() - 1;
-			break;
-		case ALIGN_CENTER:
-			x = getWidth() - (int)ceil((getWidth() + _font->getSpacing() - _lineWidth[line]) / 2.0);
-			break;
-		case ALIGN_RIGHT:
-			x = _lineWidth[line];
-			break;
-		}
-		break;
-	}
-	return x;
-}
-
 /**
  * Draws all the characters in the text with a really
  * nasty complex gritty text rendering algorithm logic stuff.
  */
 void Text::draw()
 {
+	// the surface may have been resized since the text was laid out
+	if (_run && _run->width != getWidth())
+	{
+		processText();
+	}
 	Surface::draw();
-	if (_text.empty() || _font == 0)
+	if (_text.empty() || _font == 0 || !_run)
 	{
 		return;
 	}
@@ -510,12 +409,7 @@ void Text::draw()
 		this->drawRect(&r, 0);
 	}
 
-	int x = 0, y = 0, line = 0, height = 0;
-	Font *font = _font;
-	int color = _color;
-	const UString &s = _processedText;
-
-	height = getTextHeight();
+	int y = 0, height = getTextHeight();
 
 	if (_scroll && (getHeight() - height < 0))
 	{
@@ -537,8 +431,6 @@ void Text::draw()
 		}
 	}
 
-	x = getLineX(line);
-
 	// Set up text color
 	int mul = 1;
 	if (_contrast)
@@ -546,48 +438,15 @@ void Text::draw()
 		mul = 3;
 	}
 
-	// Set up text direction
-	int dir = 1;
-	if (_lang->getTextDirection() == DIRECTION_RTL)
-	{
-		dir = -1;
-	}
-
 	// Invert text by inverting the font palette on index 3 (font palettes use indices 1-5)
 	int mid = _invert ? 3 : 0;
 
-	// Draw each letter one by one
-	for (UString::const_iterator c = s.begin(); c != s.end(); ++c)
+	// Glyphs were placed when the text was laid out, just copy them over
+	for (const GlyphSpan &span : _run->spans)
 	{
-		if (Unicode::isSpace(*c) || *c == '\t')
-		{
-			x += dir * font->getCharSize(*c).w;
-		}
-		else if (Unicode::isLinebreak(*c))
-		{
-			line++;
-			y += font->getCharSize(*c).h;
-			x = getLineX(line);
-			if (*c == Unicode::TOK_NL_SMALL)
-			{
-				font = _small;
-			}
-		}
-		else if (*c == Unicode::TOK_COLOR_FLIP)
-		{
-			color = (color == _color ? _color2 : _color);
-		}
-		else
-		{
-			if (dir < 0)
-				x += dir * font->getCharSize(*c).w;
-			auto chr = font->getChar(*c);
-			chr.setX(x);
-			chr.setY(y);
-			ShaderDraw<PaletteShift>(ShaderSurface(this, 0, 0), ShaderCrop(chr), ShaderScalar(color), ShaderScalar(mul), ShaderScalar(mid));
-			if (dir > 0)
-				x += dir * font->getCharSize(*c).w;
-		}
+		SurfaceCrop chr = span.glyph;
+		int color = span.secondary ? _color2 : _color;
+		ShaderDraw<PaletteShift>(ShaderSurface(this, 0, 0), ShaderCrop(chr, chr.getX(), chr.getY() + y), ShaderScalar(color), ShaderScalar(mul), ShaderScalar(mid));
 	}
 }
 
@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "../Engine/InteractiveSurface.h"
+#include <memory>
 #include <vector>
 #include <string>
 #include "../Engine/Unicode.h"
@@ -27,6 +28,7 @@ namespace OpenXcom
 
 class Font;
 class Language;
+struct GlyphRun;
 
 enum TextHAlign { ALIGN_LEFT, ALIGN_CENTER, ALIGN_RIGHT };
 enum TextVAlign { ALIGN_TOP, ALIGN_MIDDLE, ALIGN_BOTTOM };
@@ -43,8 +45,7 @@ private:
 	Font *_big, *_small, *_font, *_fontOrig;
 	Language *_lang;
 	std::string _text;
-	UString _processedText;
-	std::vector<int> _lineWidth, _lineHeight;
+	std::shared_ptr<const GlyphRun> _run;
 	bool _wrap, _invert, _contrast, _indent, _scroll, _ignoreSeparators;
 	TextHAlign _align;
 	TextVAlign _valign;
@@ -53,8 +54,6 @@ private:
 
 	/// Processes the contained text.
 	void processText();
-	/// Gets the X position of a text line.
-	int getLineX(int line) const;
 public:
 	/// Creates a new text with the specified size and position.
 	Text(int width, int height, int x = 0, int y = 0);
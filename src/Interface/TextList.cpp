@@ -44,7 +44,7 @@ TextList::TextList(int width, int height, int x, int y) : InteractiveSurface(wid
 	_dot(false), _selectable(false), _condensed(false), _contrast(false), _wrap(false), _flooding(false), _ignoreSeparators(false),
 	_bg(0), _selector(0), _margin(0), _scrolling(true), _arrowPos(-1), _scrollPos(4), _arrowType(ARROW_VERTICAL),
 	_leftClick(0), _leftPress(0), _leftRelease(0), _rightClick(0), _rightPress(0), _rightRelease(0),
-	_arrowsLeftEdge(0), _arrowsRightEdge(0), _noScrollLeftEdge(0), _noScrollRightEdge(0), _comboBox(0)
+	_arrowsLeftEdge(0), _arrowsRightEdge(0), _noScrollLeftEdge(0), _noScrollRightEdge(0), _comboBox(0), _serial(0)
 {
 	_up = new ArrowButton(ARROW_BIG_UP, 13, 14, getX() + getWidth() + _scrollPos, getY());
 	_up->setVisible(false);
@@ -63,13 +63,7 @@ TextList::TextList(int width, int height, int x, int y) : InteractiveSurface(wid
  */
 TextList::~TextList()
 {
-	for (auto& vec : _texts)
-	{
-		for (auto* text : vec)
-		{
-			delete text;
-		}
-	}
+	clearPool();
 	for (auto* ab : _arrowLeft)
 	{
 		delete ab;
@@ -155,7 +149,9 @@ void TextList::unpress(State *state)
  */
 void TextList::setCellColor(size_t row, size_t column, Uint8 color)
 {
-	_texts[row][column]->setColor(color);
+	CellData &cell = _texts[row].cells[column];
+	cell.color = color;
+	cell.serial = ++_serial;
 	_redraw = true;
 }
 
@@ -166,9 +162,10 @@ void TextList::setCellColor(size_t row, size_t column, Uint8 color)
  */
 void TextList::setRowColor(size_t row, Uint8 color)
 {
-	for (auto* text : _texts[row])
+	for (auto& cell : _texts[row].cells)
 	{
-		text->setColor(color);
+		cell.color = color;
+		cell.serial = ++_serial;
 	}
 	_redraw = true;
 }
@@ -181,7 +178,7 @@ void TextList::setRowColor(size_t row, Uint8 color)
  */
 std::string TextList::getCellText(size_t row, size_t column) const
 {
-	return _texts[row][column]->getText();
+	return _texts[row].cells[column].text;
 }
 
 /**
@@ -192,7 +189,16 @@ std::string TextList::getCellText(size_t row, size_t column) const
  */
 void TextList::setCellText(size_t row, size_t column, const std::string &text)
 {
-	_texts[row][column]->setText(text);
+	RowData &data = _texts[row];
+	CellData &cell = data.cells[column];
+	cell.text = text;
+	Text *txt = measureCell(column, cell, data.height);
+	if (column == 0)
+	{
+		data.textHeight = txt->getTextHeight();
+		data.numLines = txt->getNumLines();
+	}
+	cell.serial = ++_serial;
 	_redraw = true;
 }
 
@@ -203,7 +209,7 @@ void TextList::setCellText(size_t row, size_t column, const std::string &text)
  */
 int TextList::getColumnX(size_t column) const
 {
-	return getX() + _texts[0][column]->getX();
+	return getX() + _texts[0].cells[column].x;
 }
 
 /**
@@ -213,7 +219,7 @@ int TextList::getColumnX(size_t column) const
  */
 int TextList::getRowY(size_t row) const
 {
-	return getY() + _texts[row][0]->getY();
+	return getY() + _texts[row].y;
 }
 
 /**
@@ -223,7 +229,7 @@ int TextList::getRowY(size_t row) const
  */
 int TextList::getTextHeight(size_t row) const
 {
-	return _texts[row].front()->getTextHeight();
+	return _texts[row].textHeight;
 }
 
 /**
@@ -233,7 +239,7 @@ int TextList::getTextHeight(size_t row) const
  */
 int TextList::getNumTextLines(size_t row) const
 {
-	return _texts[row].front()->getNumLines();
+	return _texts[row].numLines;
 }
 
 /**
@@ -292,12 +298,12 @@ void TextList::addRow(int cols, ...)
 		ncols = 1;
 	}
 
-	std::vector<Text*> temp;
+	RowData temp;
 	// Positions are relative to list surface.
 	int rowX = 0, rowY = 0, rows = 1, rowHeight = 0;
 	if (!_texts.empty())
 	{
-		rowY = _texts.back().front()->getY() + _texts.back().front()->getHeight() + _font->getSpacing();
+		rowY = _texts.back().y + _texts.back().height + _font->getSpacing();
 	}
 
 	for (int i = 0; i < ncols; ++i)
@@ -312,33 +318,27 @@ void TextList::addRow(int cols, ...)
 		{
 			width = _columns[i];
 		}
-		Text* txt = new Text(width, _font->getHeight(), _margin + rowX, rowY);
-		txt->setPalette(this->getPalette());
-		txt->initText(_big, _small, _lang);
-		txt->setColor(_color);
-		txt->setSecondaryColor(_color2);
-		if (_align[i])
-		{
-			txt->setAlign(_align[i]);
-		}
-		txt->setHighContrast(_contrast);
-		if (_font == _big)
-		{
-			txt->setBig();
-		}
-		else
-		{
-			txt->setSmall();
-		}
+		CellData cell;
+		cell.x = _margin + rowX;
+		cell.width = width;
+		cell.color = _color;
+		cell.color2 = _color2;
+		cell.align = _align[i];
+		cell.big = (_font == _big);
+		cell.wrap = false;
+		cell.ignoreSeparators = _ignoreSeparators;
+		cell.serial = ++_serial;
 		if (cols > 0)
-			txt->setText(va_arg(args, char*));
+			cell.text = va_arg(args, char*);
+		Text *txt = measureCell(i, cell, _font->getHeight());
 		// grab this before we enable word wrapping so we can use it to calculate
 		// the total row height below
 		int vmargin = _font->getHeight() - txt->getTextHeight();
 		// Wordwrap text if necessary
 		if (_wrap && txt->getTextWidth() > txt->getWidth())
 		{
-			txt->setWordWrap(true, true, _ignoreSeparators);
+			cell.wrap = true;
+			txt = measureCell(i, cell, _font->getHeight());
 			rows = std::max(rows, txt->getNumLines());
 		}
 		rowHeight = std::max(rowHeight, txt->getTextHeight() + vmargin);
@@ -361,10 +361,16 @@ void TextList::addRow(int cols, ...)
 					buf.insert(0, 1, '.');
 				}
 			}
-			txt->setText(buf);
+			cell.text = buf;
+			txt = measureCell(i, cell, _font->getHeight());
 		}
 
-		temp.push_back(txt);
+		if (i == 0)
+		{
+			temp.textHeight = txt->getTextHeight();
+			temp.numLines = txt->getNumLines();
+		}
+		temp.cells.push_back(cell);
 		if (_condensed)
 		{
 			rowX += txt->getTextWidth();
@@ -375,13 +381,10 @@ void TextList::addRow(int cols, ...)
 		}
 	}
 
-	// ensure all elements in this row are the same height
-	for (int i = 0; i < cols; ++i)
-	{
-		temp[i]->setHeight(rowHeight);
-	}
-
-	_texts.push_back(temp);
+	// all elements in this row are the same height
+	temp.y = rowY;
+	temp.height = cols > 0 ? rowHeight : _font->getHeight();
+	_texts.push_back(std::move(temp));
 	for (int i = 0; i < rows; ++i)
 	{
 		_rows.push_back(_texts.size() - 1);
@@ -488,11 +491,14 @@ void TextList::setColumns(int cols, ...)
 void TextList::setPalette(const SDL_Color *colors, int firstcolor, int ncolors)
 {
 	Surface::setPalette(colors, firstcolor, ncolors);
-	for (auto& vec : _texts)
+	for (auto& slots : _pool)
 	{
-		for (auto* text : vec)
+		for (auto& slot : slots)
 		{
-			text->setPalette(colors, firstcolor, ncolors);
+			if (slot.text)
+			{
+				slot.text->setPalette(colors, firstcolor, ncolors);
+			}
 		}
 	}
 	for (auto* ab : _arrowLeft)
@@ -525,6 +531,7 @@ void TextList::initText(Font *big, Font *small, Language *lang)
 	_small = small;
 	_font = small;
 	_lang = lang;
+	clearPool();
 
 	delete _selector;
 	_selector = new Surface(getWidth(), _font->getHeight() + _font->getSpacing(), getX(), getY());
@@ -559,11 +566,12 @@ void TextList::setColor(Uint8 color)
 	_up->setColor(color);
 	_down->setColor(color);
 	_scrollbar->setColor(color);
-	for (auto& vec : _texts)
+	for (auto& row : _texts)
 	{
-		for (auto* text : vec)
+		for (auto& cell : row.cells)
 		{
-			text->setColor(color);
+			cell.color = color;
+			cell.serial = ++_serial;
 		}
 	}
 }
@@ -614,11 +622,14 @@ void TextList::setWordWrap(bool wrap)
 void TextList::setHighContrast(bool contrast)
 {
 	_contrast = contrast;
-	for (auto& vec : _texts)
+	for (auto& slots : _pool)
 	{
-		for (auto* text : vec)
+		for (auto& slot : slots)
 		{
-			text->setHighContrast(contrast);
+			if (slot.text)
+			{
+				slot.text->setHighContrast(contrast);
+			}
 		}
 	}
 	_scrollbar->setHighContrast(contrast);
@@ -890,14 +901,6 @@ void TextList::onRightArrowRelease(ActionHandler handler)
  */
 void TextList::clearList()
 {
-	for (auto& vec : _texts)
-	{
-		for (auto* text : vec)
-		{
-			delete text;
-		}
-		vec.clear();
-	}
 	scrollUp(true, false);
 	_texts.clear();
 	_rows.clear();
@@ -989,6 +992,129 @@ void TextList::updateVisible()
 	updateArrows();
 }
 
+/**
+ * Gets the widget that lays out the cells of a column,
+ * sized like the cell.
+ * @param column Column number.
+ * @param width Cell width in pixels.
+ * @param height Cell height in pixels.
+ * @return Text widget, owned by the list.
+ */
+Text *TextList::getMeasureText(size_t column, int width, int height)
+{
+	if (_measure.size() <= column)
+	{
+		_measure.resize(column + 1, nullptr);
+	}
+	Text *txt = _measure[column];
+	if (!txt)
+	{
+		txt = new Text(width, height);
+		txt->initText(_big, _small, _lang);
+		_measure[column] = txt;
+	}
+	if (txt->getWidth() != width)
+	{
+		txt->setWidth(width);
+	}
+	if (txt->getHeight() != height)
+	{
+		txt->setHeight(height);
+	}
+	return txt;
+}
+
+/**
+ * Lays out the text of a cell like a Text widget of
+ * that size would, and stores the font it ended up with.
+ * @param column Column number.
+ * @param cell Cell to lay out.
+ * @param height Cell height in pixels.
+ * @return Widget holding the layout, valid until the next cell.
+ */
+Text *TextList::measureCell(size_t column, CellData &cell, int height)
+{
+	Text *txt = getMeasureText(column, cell.width, height);
+	// empty first, so changing the settings doesn't lay out the old text again
+	txt->setText("");
+	txt->setWordWrap(cell.wrap, true, cell.ignoreSeparators);
+	if (cell.big)
+	{
+		txt->setBig();
+	}
+	else
+	{
+		txt->setSmall();
+	}
+	txt->setText(cell.text);
+	cell.font = txt->getFont();
+	return txt;
+}
+
+/**
+ * Makes a pooled widget show a cell, creating it if needed.
+ * @param slot Pooled widget.
+ * @param cell Cell to show.
+ * @param height Row height in pixels.
+ */
+void TextList::bindCell(PooledText &slot, const CellData &cell, int height)
+{
+	Text *txt = slot.text;
+	if (!txt)
+	{
+		txt = new Text(cell.width, height, cell.x, 0);
+		txt->setPalette(this->getPalette());
+		txt->initText(_big, _small, _lang);
+		txt->setHighContrast(_contrast);
+		slot.text = txt;
+	}
+	if (txt->getWidth() != cell.width)
+	{
+		txt->setWidth(cell.width);
+	}
+	if (txt->getHeight() != height)
+	{
+		txt->setHeight(height);
+	}
+	txt->setX(cell.x);
+	txt->setText("");
+	txt->setWordWrap(cell.wrap, true, cell.ignoreSeparators);
+	if (cell.font == _big)
+	{
+		txt->setBig();
+	}
+	else
+	{
+		txt->setSmall();
+	}
+	txt->setAlign(cell.align);
+	txt->setColor(cell.color);
+	txt->setSecondaryColor(cell.color2);
+	txt->setText(cell.text);
+	slot.serial = cell.serial;
+}
+
+/**
+ * Deletes the pooled and layout widgets, for when
+ * the fonts change or the visible rows don't fit anymore.
+ */
+void TextList::clearPool()
+{
+	for (auto& slots : _pool)
+	{
+		for (auto& slot : slots)
+		{
+			delete slot.text;
+		}
+	}
+	_pool.clear();
+	for (auto* txt : _measure)
+	{
+		delete txt;
+	}
+	_measure.clear();
+}
+
 /**
  * Changes whether the list can be scrolled.
  * @param scrolling True to allow scrolling, false otherwise.
@@ -1021,21 +1147,31 @@ void TextList::draw()
 		{
 			y -= _font->getHeight() + _font->getSpacing();
 		}
+		if (_pool.size() != _visibleRows)
+		{
+			clearPool();
+			_pool.resize(_visibleRows);
+		}
 		for (size_t i = _rows[_scroll]; i < _texts.size() && i < _rows[_scroll] + _visibleRows; ++i)
 		{
-			for (auto* text : _texts[i])
+			RowData &row = _texts[i];
+			row.y = y;
+			// consecutive rows never share widgets, and scrolling keeps most of them bound
+			std::vector<PooledText> &slots = _pool[i % _visibleRows];
+			if (slots.size() < row.cells.size())
 			{
-				text->setY(y);
-				text->blit(this->getSurface());
+				slots.resize(row.cells.size(), PooledText{ nullptr, 0 });
 			}
-			if (!_texts[i].empty())
-			{
-				y += _texts[i].front()->getHeight() + _font->getSpacing();
-			}
-			else
+			for (size_t c = 0; c < row.cells.size(); ++c)
 			{
-				y += _font->getHeight() + _font->getSpacing();
+				if (slots[c].serial != row.cells[c].serial)
+				{
+					bindCell(slots[c], row.cells[c], row.height);
+				}
+				slots[c].text->setY(y);
+				slots[c].text->blit(this->getSurface());
 			}
+			y += row.height + _font->getSpacing();
 		}
 	}
 }
@@ -1073,14 +1209,7 @@ void TextList::blit(SDL_Surface *surface)
 					_arrowRight[i]->blit(surface);
 				}
 
-				if (!_texts[i].empty())
-				{
-					y += _texts[i].front()->getHeight() + _font->getSpacing();
-				}
-				else
-				{
-					y += _font->getHeight() + _font->getSpacing();
-				}
+				y += _texts[i].height + _font->getSpacing();
 			}
 		}
 		_up->blit(surface);
@@ -1262,9 +1391,9 @@ void TextList::mouseOver(Action *action, State *state)
 		_selRow = std::max(0, (int)(_scroll + (int)floor(action->getRelativeYMouse() / (rowHeight * action->getYScale()))));
 		if (_selRow < _rows.size())
 		{
-			Text *selText = _texts[_rows[_selRow]].front();
-			int y = getY() + selText->getY();
-			int actualHeight = selText->getHeight() + _font->getSpacing(); //current line height
+			const RowData &selText = _texts[_rows[_selRow]];
+			int y = getY() + selText.y;
+			int actualHeight = selText.height + _font->getSpacing(); //current line height
 			if (y < getY() || y + actualHeight > getY() + getHeight())
 			{
 				actualHeight /= 2;
@@ -36,11 +36,44 @@ class ScrollBar;
  * Contains a set of Text's that are automatically lined up by
  * rows and columns, like a big table, making it easy to manage
  * them together.
+ * Only the row data is stored, the Text widgets come from a small
+ * pool that covers the visible rows. A widget keeps its rendered
+ * glyphs until it gets bound to a different or changed cell, so
+ * scrolling and redrawing don't lay out the text again.
  */
 class TextList : public InteractiveSurface
 {
 private:
-	std::vector< std::vector<Text*> > _texts;
+	/// Contents and layout of one cell.
+	struct CellData
+	{
+		std::string text;
+		Font *font;
+		int x, width;
+		Uint8 color, color2;
+		TextHAlign align;
+		bool big, wrap, ignoreSeparators;
+		/// Changes whenever the cell does, tells pooled widgets to lay it out again.
+		Uint32 serial;
+	};
+	/// Cells of one list row, which can span several lines.
+	struct RowData
+	{
+		std::vector<CellData> cells;
+		int y, height, textHeight, numLines;
+	};
+	/// Widget drawing a visible cell and the cell it shows now.
+	struct PooledText
+	{
+		Text *text;
+		Uint32 serial;
+	};
+
+	std::vector<RowData> _texts;
+	/// Widgets of the visible rows, by row modulo the visible row count, then column.
+	std::vector< std::vector<PooledText> > _pool;
+	/// Widgets used to lay out new cells, by column.
+	std::vector<Text*> _measure;
 	std::vector<size_t> _columns, _rows;
 	Font *_big, *_small, *_font;
 	Language *_lang;
@@ -60,11 +93,20 @@ private:
 	int _arrowsLeftEdge, _arrowsRightEdge;
 	int _noScrollLeftEdge, _noScrollRightEdge;
 	ComboBox *_comboBox;
+	Uint32 _serial;
 
 	/// Updates the arrow buttons.
 	void updateArrows();
 	/// Updates the visible rows.
 	void updateVisible();
+	/// Gets a widget to lay out a cell of a column.
+	Text *getMeasureText(size_t column, int width, int height);
+	/// Lays out the text of a cell.
+	Text *measureCell(size_t column, CellData &cell, int height);
+	/// Points a pooled widget at a cell.
+	void bindCell(PooledText &slot, const CellData &cell, int height);
+	/// Deletes the pooled widgets.
+	void clearPool();
 public:
 	/// Creates a text list with the specified size and position.
 	TextList(int width, int height, int x = 0, int y = 0);
@@ -207,6 +207,7 @@ void LoadGameState::think()
 	if (_firstRun < 10)
 	{
 		_firstRun++;
+		_game->requestNextFrame();
 	}
 	else
 	{
@@ -544,9 +544,24 @@ void NewBattleState::save(const std::string &filename)
 void NewBattleState::initSave()
 {
 	const Mod *mod = _game->getMod();
+	SavedGame *save = createSave(mod, mod->getCraft(_crafts[_cbxCraft->getSelected()]), &_craft);
+	_game->setSavedGame(save);
+	cbxMissionChange(0);
+}
+
+/**
+ * Creates a savegame with a single base holding a craft, random
+ * soldiers and every recoverable item, with all research done.
+ * @param mod Pointer to the mod.
+ * @param craftRule Type of the craft to create.
+ * @param craft Receives the created craft.
+ * @return New savegame, owned by the caller.
+ */
+SavedGame *NewBattleState::createSave(const Mod *mod, const RuleCraft *craftRule, Craft **craft)
+{
 	SavedGame *save = new SavedGame();
 	Base *base = new Base(mod);
-	YAML::YamlRootNodeReader startingBaseReader(_game->getMod()->getDefaultStartingBase(), "(starting base template)");
+	YAML::YamlRootNodeReader startingBaseReader(mod->getDefaultStartingBase(), "(starting base template)");
 	base->load(startingBaseReader, save, true, true);
 	save->getBases()->push_back(base);
 
@@ -563,8 +578,8 @@ void NewBattleState::initSave()
 	base->getCrafts()->clear();
 	base->getStorageItems()->clear();
 
-	_craft = new Craft(mod->getCraft(_crafts[_cbxCraft->getSelected()]), base, 1);
-	base->getCrafts()->push_back(_craft);
+	*craft = new Craft(craftRule, base, 1);
+	base->getCrafts()->push_back(*craft);
 
 	// Generate soldiers
 	bool psiStrengthEval = (Options::psiStrengthEval && save->isResearched(mod->getPsiRequirements()));
@@ -603,24 +618,24 @@ void NewBattleState::initSave()
 
 		base->getSoldiers()->push_back(soldier);
 
-		int space = _craft->getSpaceAvailable();
-		if (_craft->validateAddingSoldier(space, soldier) == CPE_None)
+		int space = (*craft)->getSpaceAvailable();
+		if ((*craft)->validateAddingSoldier(space, soldier) == CPE_None)
 		{
-			soldier->setCraft(_craft);
+			soldier->setCraft(*craft);
 		}
 	}
 
 	// Generate items
 	for (auto& itemType : mod->getItemsList())
 	{
-		const RuleItem *rule = _game->getMod()->getItem(itemType);
+		const RuleItem *rule = mod->getItem(itemType);
 		if (rule->getBattleType() != BT_CORPSE && rule->isRecoverable())
 		{
 			int howMany = rule->getBattleType() == BT_AMMO ? 2 : 1;
 			base->getStorageItems()->addItem(rule, howMany);
 			if (rule->getBattleType() != BT_NONE && rule->isInventoryItem())
 			{
-				_craft->getItems()->addItem(rule, howMany);
+				(*craft)->getItems()->addItem(rule, howMany);
 			}
 		}
 	}
@@ -628,8 +643,7 @@ void NewBattleState::initSave()
 	// Add research
 	save->makeAllResearchDiscovered(mod);
 
-	_game->setSavedGame(save);
-	cbxMissionChange(0);
+	return save;
 }
 
 /**
@@ -38,6 +38,8 @@ class Slider;
 class Frame;
 class Craft;
 class SavedGame;
+class Mod;
+class RuleCraft;
 
 /**
  * New Battle that displays a list
@@ -90,6 +92,8 @@ public:
 	void save(const std::string &filename = "battle");
 	/// Initializes a blank savegame.
 	void initSave();
+	/// Creates a savegame with everything available and a single craft.
+	static SavedGame *createSave(const Mod *mod, const RuleCraft *craftRule, Craft **craft);
 	/// Handler for clicking the OK button.
 	void btnOkClick(Action *action);
 	// coop
@@ -26,10 +26,12 @@
 #include "../Engine/CrossPlatform.h"
 #include "../Engine/LocalizedText.h"
 #include "../Engine/Unicode.h"
+#include "../Engine/Language.h"
 #include "../Interface/Text.h"
 #include "ErrorMessageState.h"
 #include "MainMenuState.h"
 #include "../Savegame/SavedGame.h"
+#include "../Savegame/SaveWriter.h"
 #include "../Mod/Mod.h"
 #include "../Mod/RuleInterface.h"
 #include "../CoopMod/CoopState.h"
@@ -154,6 +156,7 @@ void SaveGameState::think()
 	if (_firstRun < 10)
 	{
 		_firstRun++;
+		_game->requestNextFrame();
 	}
 	else
 	{
@@ -253,6 +256,21 @@ void SaveGameState::think()
 				return;
 			}
 
+			// autosaves happen mid-game, don't make the player wait for the disk
+			// (write errors come back through asyncErrors)
+			if (Options::asyncAutosave && (_type == SAVE_AUTO_GEOSCAPE || _type == SAVE_AUTO_BATTLESCAPE))
+			{
+				_game->getSavedGame()->saveAsync(_filename, _game->getMod());
+
+				// Clear the SDL event queue (i.e. ignore input from impatient users)
+				SDL_Event e;
+				while (SDL_PollEvent(&e))
+				{
+					// do nothing
+				}
+				return;
+			}
+
 			std::string backup = _filename + ".bak";
 			_game->getSavedGame()->save(backup, _game->getMod());
 			std::string fullPath = Options::getMasterUserFolder() + _filename;
@@ -298,12 +316,39 @@ void SaveGameState::think()
 void SaveGameState::error(const std::string &msg)
 {
 	Log(LOG_ERROR) << msg;
+	showError(_origin, msg, _palette);
+}
+
+/**
+ * Pops up a window with an error message if a save written
+ * in the background failed. Called by the screens that
+ * autosave, as the save screen is gone by then.
+ * @param origin Game section the error shows up in.
+ * @param palette Palette of the calling screen.
+ */
+void SaveGameState::asyncErrors(OptionsOrigin origin, SDL_Color *palette)
+{
+	std::vector<std::string> errors = SaveWriter::takeErrors();
+	if (!errors.empty())
+	{
+		showError(origin, errors.back(), palette);
+	}
+}
+
+/**
+ * Pushes the save error window.
+ * @param origin Game section the error shows up in.
+ * @param msg Error message.
+ * @param palette Palette of the calling screen.
+ */
+void SaveGameState::showError(OptionsOrigin origin, const std::string &msg, SDL_Color *palette)
+{
 	std::ostringstream error;
-	error << tr("STR_SAVE_UNSUCCESSFUL") << Unicode::TOK_NL_SMALL << msg;
-	if (_origin != OPT_BATTLESCAPE)
-		_game->pushState(new ErrorMessageState(error.str(), _palette, _game->getMod()->getInterface("errorMessages")->getElement("geoscapeColor")->color, "BACK01.SCR", _game->getMod()->getInterface("errorMessages")->getElement("geoscapePalette")->color));
+	error << _game->getLanguage()->getString("STR_SAVE_UNSUCCESSFUL") << Unicode::TOK_NL_SMALL << msg;
+	if (origin != OPT_BATTLESCAPE)
+		_game->pushState(new ErrorMessageState(error.str(), palette, _game->getMod()->getInterface("errorMessages")->getElement("geoscapeColor")->color, "BACK01.SCR", _game->getMod()->getInterface("errorMessages")->getElement("geoscapePalette")->color));
 	else
-		_game->pushState(new ErrorMessageState(error.str(), _palette, _game->getMod()->getInterface("errorMessages")->getElement("battlescapeColor")->color, "TAC00.SCR", _game->getMod()->getInterface("errorMessages")->getElement("battlescapePalette")->color));
+		_game->pushState(new ErrorMessageState(error.str(), palette, _game->getMod()->getInterface("errorMessages")->getElement("battlescapeColor")->color, "TAC00.SCR", _game->getMod()->getInterface("errorMessages")->getElement("battlescapePalette")->color));
 }
 
 }
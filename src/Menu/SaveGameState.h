@@ -39,6 +39,8 @@ private:
 	Text *_txtStatus;
 	std::string _filename;
 	SaveType _type;
+	/// Pushes the save error window.
+	static void showError(OptionsOrigin origin, const std::string &msg, SDL_Color *palette);
 public:
 	/// Creates the Save Game state.
 	SaveGameState(OptionsOrigin origin, const std::string &filename, SDL_Color *palette);
@@ -52,6 +54,8 @@ public:
 	void think() override;
 	/// Shows an error message.
 	void error(const std::string &msg);
+	/// Shows an error message for saves written in the background, if any failed.
+	static void asyncErrors(OptionsOrigin origin, SDL_Color *palette);
 };
 
 }
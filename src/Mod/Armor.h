@@ -196,6 +196,7 @@ private:
 	int _meleeOriginVoxelVerticalOffset;
 	int _group;
 	int _listOrder;
+	int _ruleId = -1;
 public:
 	/// Creates a blank armor ruleset.
 	Armor(const std::string &type, int listOrder);
@@ -214,6 +215,10 @@ public:
 
 	/// Gets the armor's type.
 	const std::string& getType() const;
+	/// Gets the rule ID handed out by Mod, -1 before that.
+	int getRuleId() const { return _ruleId; }
+	/// Sets the rule ID, only Mod does this.
+	void setRuleId(int id) { _ruleId = id; }
 	/// Gets the unit's sprite sheet.
 	std::string getSpriteSheet() const;
 	/// Gets the unit's inventory sprite.
@@ -0,0 +1,244 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "DependencyGraph.h"
+#include "Mod.h"
+#include "RuleBaseFacility.h"
+#include "RuleCraft.h"
+#include "RuleItem.h"
+#include "RuleManufacture.h"
+#include "RuleResearch.h"
+#include "RuleSoldierTransformation.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Adds a link unless the same rule was the last one added. Sources are
+ * visited one at a time, so this drops repeated links from one rule.
+ */
+template<typename T>
+void addLink(std::vector<T*> &list, T *rule)
+{
+	if (list.empty() || list.back() != rule)
+	{
+		list.push_back(rule);
+	}
+}
+
+const DependencyGraph::ResearchLinks EmptyResearch;
+const DependencyGraph::ItemLinks EmptyItem;
+const DependencyGraph::CraftLinks EmptyCraft;
+
+}
+
+/**
+ * Walks every rule list once and stores the reverse of each reference.
+ * Needs research indexes, so RuleResearch::afterLoadGraph() has to run
+ * first, and the sorted Mod lists, so list order matches the game's.
+ * @param mod Pointer to the mod.
+ */
+void DependencyGraph::build(const Mod *mod)
+{
+	_research.clear();
+	_items.clear();
+	_crafts.clear();
+
+	std::vector<RuleResearch*> research;
+	research.reserve(mod->getResearchList().size());
+	for (auto& type : mod->getResearchList())
+	{
+		RuleResearch *rule = mod->getResearch(type);
+		if ((int)_research.size() <= rule->getIndex())
+		{
+			_research.resize(rule->getIndex() + 1);
+		}
+		research.push_back(rule);
+	}
+	auto links = [&](const RuleResearch *rule) -> ResearchLinks& { return _research[rule->getIndex()]; };
+	auto linksByName = [&](const std::string &name) -> ResearchLinks* { RuleResearch *rule = mod->getResearch(name); return rule ? &links(rule) : nullptr; };
+
+	for (auto* rule : research)
+	{
+		for (auto* i : rule->getUnlocked())
+		{
+			addLink(links(i).unlockedBy, rule);
+		}
+		for (auto* i : rule->getDisabled())
+		{
+			addLink(links(i).disabledBy, rule);
+		}
+		for (auto* i : rule->getReenabled())
+		{
+			addLink(links(i).reenabledBy, rule);
+		}
+		for (auto* i : rule->getGetOneFree())
+		{
+			addLink(links(i).getOneFreeFrom, rule);
+		}
+		for (auto& protectedFree : rule->getGetOneFreeProtected())
+		{
+			for (auto* i : protectedFree.second)
+			{
+				addLink(links(i).getOneFreeFrom, rule);
+			}
+		}
+		if (!Mod::isEmptyRuleName(rule->getLookup()))
+		{
+			if (ResearchLinks *lookup = linksByName(rule->getLookup()))
+			{
+				addLink(lookup->lookupOf, rule);
+			}
+		}
+		for (auto* i : rule->getRequirements())
+		{
+			addLink(links(i).requiredBy, rule);
+		}
+		for (auto* i : rule->getDependencies())
+		{
+			addLink(links(i).leadsTo, rule);
+		}
+
+		if (RuleItem *item = mod->getItem(rule->getSpawnedItem()))
+		{
+			addLink(_items[item].spawnedBy, rule);
+		}
+		for (auto& type : rule->getSpawnedItemList())
+		{
+			if (RuleItem *item = mod->getItem(type))
+			{
+				addLink(_items[item].spawnedBy, rule);
+			}
+		}
+	}
+
+	for (auto& type : mod->getManufactureList())
+	{
+		RuleManufacture *rule = mod->getManufacture(type);
+		for (auto* i : rule->getRequirements())
+		{
+			addLink(links(i).manufacture, rule);
+		}
+		for (auto& i : rule->getProducedItems())
+		{
+			addLink(_items[i.first].producedBy, rule);
+		}
+		for (auto& randomOutput : rule->getRandomProducedItems())
+		{
+			for (auto& i : randomOutput.second)
+			{
+				addLink(_items[i.first].producedBy, rule);
+			}
+		}
+		if (rule->getProducedCraft())
+		{
+			addLink(_crafts[rule->getProducedCraft()].producedBy, rule);
+		}
+	}
+
+	for (auto& type : mod->getBaseFacilitiesList())
+	{
+		RuleBaseFacility *rule = mod->getBaseFacility(type);
+		for (auto& name : rule->getRequirements())
+		{
+			if (ResearchLinks *i = linksByName(name))
+			{
+				addLink(i->facilities, rule);
+			}
+		}
+	}
+
+	for (auto& type : mod->getItemsList())
+	{
+		RuleItem *rule = mod->getItem(type);
+		for (auto* i : rule->getRequirements())
+		{
+			addLink(links(i).items, rule);
+		}
+		for (auto* i : rule->getBuyRequirements())
+		{
+			addLink(links(i).items, rule);
+		}
+	}
+
+	for (auto& type : mod->getSoldierTransformationList())
+	{
+		RuleSoldierTransformation *rule = mod->getSoldierTransformation(type);
+		for (auto& name : rule->getRequiredResearch())
+		{
+			if (ResearchLinks *i = linksByName(name))
+			{
+				addLink(i->transformations, rule);
+			}
+		}
+	}
+
+	for (auto& type : mod->getCraftsList())
+	{
+		RuleCraft *rule = mod->getCraft(type);
+		for (auto& name : rule->getRequirements())
+		{
+			if (ResearchLinks *i = linksByName(name))
+			{
+				addLink(i->crafts, rule);
+			}
+		}
+	}
+}
+
+/**
+ * Gets the rules that reference a research topic.
+ * @param research Research rule.
+ * @return Reverse links, empty for unknown rules.
+ */
+const DependencyGraph::ResearchLinks &DependencyGraph::getResearch(const RuleResearch *research) const
+{
+	int index = research->getIndex();
+	if (index < 0 || index >= (int)_research.size())
+	{
+		return EmptyResearch;
+	}
+	return _research[index];
+}
+
+/**
+ * Gets the rules that produce or spawn an item.
+ * @param item Item rule.
+ * @return Reverse links, empty if nothing gives it out.
+ */
+const DependencyGraph::ItemLinks &DependencyGraph::getItem(const RuleItem *item) const
+{
+	auto i = _items.find(item);
+	return i != _items.end() ? i->second : EmptyItem;
+}
+
+/**
+ * Gets the rules that produce a craft.
+ * @param craft Craft rule.
+ * @return Reverse links, empty if nothing gives it out.
+ */
+const DependencyGraph::CraftLinks &DependencyGraph::getCraft(const RuleCraft *craft) const
+{
+	auto i = _crafts.find(craft);
+	return i != _crafts.end() ? i->second : EmptyCraft;
+}
+
+}
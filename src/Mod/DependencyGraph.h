@@ -0,0 +1,81 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <unordered_map>
+#include <vector>
+
+namespace OpenXcom
+{
+
+class Mod;
+class RuleResearch;
+class RuleManufacture;
+class RuleBaseFacility;
+class RuleItem;
+class RuleSoldierTransformation;
+class RuleCraft;
+
+/**
+ * Reverse links between research, manufacture, items, crafts and
+ * facilities, so "what needs this topic" questions don't have to scan
+ * every ruleset. Built once after all rules are loaded and sorted and
+ * never changed afterwards. Every list follows the order of the
+ * matching Mod list and names each rule at most once.
+ */
+class DependencyGraph
+{
+public:
+	/// Rules that point at one research topic.
+	struct ResearchLinks
+	{
+		std::vector<RuleResearch*> unlockedBy, disabledBy, reenabledBy, getOneFreeFrom, lookupOf, requiredBy, leadsTo;
+		std::vector<RuleManufacture*> manufacture;
+		std::vector<RuleBaseFacility*> facilities;
+		/// Items needing it to be used or bought.
+		std::vector<RuleItem*> items;
+		std::vector<RuleSoldierTransformation*> transformations;
+		std::vector<RuleCraft*> crafts;
+	};
+	/// Rules that give out one item.
+	struct ItemLinks
+	{
+		std::vector<RuleManufacture*> producedBy;
+		std::vector<RuleResearch*> spawnedBy;
+	};
+	/// Rules that give out one craft.
+	struct CraftLinks
+	{
+		std::vector<RuleManufacture*> producedBy;
+	};
+private:
+	std::vector<ResearchLinks> _research;
+	std::unordered_map<const RuleItem*, ItemLinks> _items;
+	std::unordered_map<const RuleCraft*, CraftLinks> _crafts;
+public:
+	/// Builds the graph from fully loaded rules.
+	void build(const Mod *mod);
+	/// Gets what depends on a research topic.
+	const ResearchLinks &getResearch(const RuleResearch *research) const;
+	/// Gets what gives out an item.
+	const ItemLinks &getItem(const RuleItem *item) const;
+	/// Gets what gives out a craft.
+	const CraftLinks &getCraft(const RuleCraft *craft) const;
+};
+
+}
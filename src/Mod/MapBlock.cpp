@@ -18,9 +18,11 @@
  */
 #include <sstream>
 #include <algorithm>
+#include <iterator>
 #include "MapBlock.h"
 #include "../Battlescape/Position.h"
 #include "../Engine/Exception.h"
+#include "../Engine/FileMap.h"
 
 namespace OpenXcom
 {
@@ -28,7 +30,7 @@ namespace OpenXcom
 /**
  * MapBlock construction.
  */
-MapBlock::MapBlock(const std::string &name): _name(name), _size_x(10), _size_y(10), _size_z(4)
+MapBlock::MapBlock(const std::string &name): _name(name), _size_x(10), _size_y(10), _size_z(4), _mapFileLoaded(false), _routeFileLoaded(false)
 {
 	_groups.push_back(0);
 }
@@ -149,6 +151,53 @@ bool MapBlock::isFloorRevealed(int floor)
 	return std::find(_revealedFloors.begin(), _revealedFloors.end(), floor) != _revealedFloors.end();
 }
 
+/**
+ * Reads a whole resource file into memory.
+ * @param filename Relative path of the file.
+ * @return File contents.
+ */
+static std::vector<unsigned char> readBlockFile(const std::string &filename)
+{
+	auto file = FileMap::getIStream(filename);
+	std::vector<unsigned char> data((std::istreambuf_iterator<char>(*file)), std::istreambuf_iterator<char>());
+	if (file->bad())
+	{
+		throw Exception("Failed to read " + filename);
+	}
+	return data;
+}
+
+/**
+ * Gets the contents of the MAP file of this block. The file is read
+ * the first time it's needed and kept for as long as the mod is loaded,
+ * as the same blocks are placed over and over across missions.
+ * @return Raw MAP data.
+ */
+const std::vector<unsigned char>& MapBlock::getMapFile()
+{
+	if (!_mapFileLoaded)
+	{
+		_mapFile = readBlockFile("MAPS/" + _name + ".MAP");
+		_mapFileLoaded = true;
+	}
+	return _mapFile;
+}
+
+/**
+ * Gets the contents of the RMP file of this block, read on first use
+ * and kept for as long as the mod is loaded.
+ * @return Raw RMP data.
+ */
+const std::vector<unsigned char>& MapBlock::getRouteFile()
+{
+	if (!_routeFileLoaded)
+	{
+		_routeFile = readBlockFile("ROUTES/" + _name + ".RMP");
+		_routeFileLoaded = true;
+	}
+	return _routeFile;
+}
+
 // helper overloads for deserialization-only
 bool read(ryml::ConstNodeRef const& n, RandomizedItems* val)
 {
@@ -66,6 +66,8 @@ private:
 	std::map<std::string, std::pair<int, int> > _itemsFuseTimer;
 	std::vector<RandomizedItems> _randomizedItems;
 	std::vector<ExtendedItems> _extendedItems;
+	std::vector<unsigned char> _mapFile, _routeFile;
+	bool _mapFileLoaded, _routeFileLoaded;
 public:
 	MapBlock(const std::string &name);
 	~MapBlock();
@@ -95,6 +97,10 @@ public:
 	const std::vector<ExtendedItems> *getExtendedItems() const { return &_extendedItems; }
 	/// Gets the craft inventory tile position.
 	const std::vector<int>& getCraftInventoryTile() const { return _craftInventoryTile; };
+	/// Gets the contents of the block's MAP file.
+	const std::vector<unsigned char>& getMapFile();
+	/// Gets the contents of the block's RMP file.
+	const std::vector<unsigned char>& getRouteFile();
 
 };
 
@@ -30,6 +30,7 @@
 #include "../Engine/Font.h"
 #include "../Engine/Surface.h"
 #include "../Engine/SurfaceSet.h"
+#include "../Engine/SpriteCache.h"
 #include "../Engine/Music.h"
 #include "../Engine/GMCat.h"
 #include "../Engine/SoundSet.h"
@@ -107,6 +108,7 @@
 #include "RuleGlobe.h"
 #include "RuleVideo.h"
 #include "RuleConverter.h"
+#include "DependencyGraph.h"
 #include "RuleSoldierTransformation.h"
 #include "RuleSoldierBonus.h"
 
@@ -569,6 +571,7 @@ Mod::Mod() :
 	}
 
 	_converter = new RuleConverter();
+	_dependencyGraph = new DependencyGraph();
 	_statAdjustment.resize(MaxDifficultyLevels);
 	_statAdjustment[0].aimMultiplier = 0.5;
 	_statAdjustment[0].armorMultiplier = 0.5;
@@ -599,10 +602,12 @@ Mod::Mod() :
  */
 Mod::~Mod()
 {
+	SpriteCache::close();
 	delete _muteMusic;
 	delete _muteSound;
 	delete _globe;
 	delete _converter;
+	delete _dependencyGraph;
 	delete _scriptGlobal;
 	for (auto& pair : _fonts)
 	{
@@ -854,6 +859,34 @@ T *Mod::getRule(const std::string &id, const std::string &name, const std::map<s
 	}
 }
 
+/**
+ * Gets a rule element from an array indexed by interned ID.
+ * Only valid once buildRuleIds() has run.
+ * @param id String ID of the rule element.
+ * @param name Human-readable name of the rule type.
+ * @param byId Rules of that type indexed by ID.
+ * @param error Throw an error if not found.
+ * @return Pointer to the rule element, or NULL if not found.
+ */
+template <typename T>
+T *Mod::getRule(const std::string &id, const std::string &name, const std::vector<T*> &byId, bool error) const
+{
+	if (isEmptyRuleName(id))
+	{
+		return 0;
+	}
+	int index = _ruleIds.find(id);
+	if (index != RuleIdTable::None && byId[index] != 0)
+	{
+		return byId[index];
+	}
+	if (error)
+	{
+		throw Exception(name + " " + id + " not found");
+	}
+	return 0;
+}
+
 /**
  * Returns a specific font from the mod.
  * @param name Name of the font.
@@ -2223,6 +2256,11 @@ void Mod::loadAll()
 		}
 	}
 
+	if (Options::spriteCache)
+	{
+		SpriteCache::open(Options::getMasterUserFolder() + "sprites.cache");
+	}
+
 	Log(LOG_INFO) << "Loading vanilla resources...";
 	// vanilla resources load
 	_modCurrent = &_modData.at(0);
@@ -2298,12 +2336,14 @@ void Mod::loadAll()
 	}
 
 	loadExtraResources();
+	SpriteCache::flush();
 
 
 	Log(LOG_INFO) << "After load.";
 	// cross link rule objects
 
 	afterLoadHelper("research", this, _research, &RuleResearch::afterLoad);
+	RuleResearch::afterLoadGraph(_research);
 	afterLoadHelper("items", this, _items, &RuleItem::afterLoad);
 	afterLoadHelper("weaponSets", this, _weaponSets, &RuleWeaponSet::afterLoad);
 	afterLoadHelper("manufacture", this, _manufacture, &RuleManufacture::afterLoad);
@@ -2468,6 +2508,8 @@ void Mod::loadAll()
 	Log(LOG_INFO) << "Loading ended.";
 
 	sortLists();
+	buildRuleIds();
+	_dependencyGraph->build(this);
 	modResources();
 }
 
@@ -4137,6 +4179,10 @@ RuleItem *Mod::getItem(const std::string &id, bool error) const
 	{
 		return 0;
 	}
+	if (!_itemsById.empty())
+	{
+		return getRule(id, "Item", _itemsById, error);
+	}
 	return getRule(id, "Item", _items, error);
 }
 
@@ -4276,6 +4322,10 @@ const std::map<std::string, RuleCommendations *> &Mod::getCommendationsList() co
  */
 Unit *Mod::getUnit(const std::string &name, bool error) const
 {
+	if (!_unitsById.empty())
+	{
+		return getRule(name, "Unit", _unitsById, error);
+	}
 	return getRule(name, "Unit", _units, error);
 }
 
@@ -4369,6 +4419,10 @@ const std::vector<std::string> &Mod::getDeploymentsList() const
  */
 Armor *Mod::getArmor(const std::string &name, bool error) const
 {
+	if (!_armorsById.empty())
+	{
+		return getRule(name, "Armor", _armorsById, error);
+	}
 	return getRule(name, "Armor", _armors, error);
 }
 
@@ -4559,6 +4613,10 @@ const std::vector<std::string> &Mod::getInvsList() const
  */
 RuleResearch *Mod::getResearch(const std::string &id, bool error) const
 {
+	if (!_researchById.empty())
+	{
+		return getRule(id, "Research", _researchById, error);
+	}
 	return getRule(id, "Research", _research, error);
 }
 
@@ -4979,6 +5037,47 @@ void sortIndex(std::vector<std::string>& index, std::map<std::string, RuleType*>
 		index[i].assign(tempVector[i]->first);
 }
 
+/**
+ * Interns the types of the rules most often looked up by name, gives
+ * each of those rules its ID and fills the ID indexed arrays. From then
+ * on the string getters of those rules go through the arrays instead
+ * of the maps.
+ */
+void Mod::buildRuleIds()
+{
+	_ruleIds.clear();
+	for (auto& pair : _items)
+	{
+		_ruleIds.intern(pair.first);
+	}
+	for (auto& pair : _research)
+	{
+		_ruleIds.intern(pair.first);
+	}
+	for (auto& pair : _units)
+	{
+		_ruleIds.intern(pair.first);
+	}
+	for (auto& pair : _armors)
+	{
+		_ruleIds.intern(pair.first);
+	}
+	auto fill = [&](auto &byId, auto &map)
+	{
+		byId.assign(_ruleIds.size(), nullptr);
+		for (auto& pair : map)
+		{
+			int id = _ruleIds.find(pair.first);
+			byId[id] = pair.second;
+			pair.second->setRuleId(id);
+		}
+	};
+	fill(_itemsById, _items);
+	fill(_researchById, _research);
+	fill(_unitsById, _units);
+	fill(_armorsById, _armors);
+}
+
 /**
  * Sorts all our lists according to their weight.
  */
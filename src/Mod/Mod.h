@@ -34,6 +34,7 @@
 #include "RuleAlienMission.h"
 #include "RuleBaseFacilityFunctions.h"
 #include "RuleItem.h"
+#include "RuleIdTable.h"
 
 namespace OpenXcom
 {
@@ -102,6 +103,7 @@ class RuleEvent;
 class RuleMissionScript;
 class ModScript;
 class ModScriptGlobal;
+class DependencyGraph;
 class ScriptParserBase;
 class ScriptGlobal;
 struct StatAdjustment;
@@ -217,6 +219,12 @@ private:
 
 	RuleGlobe *_globe;
 	RuleConverter *_converter;
+	DependencyGraph *_dependencyGraph;
+	RuleIdTable _ruleIds;
+	std::vector<RuleItem*> _itemsById;
+	std::vector<RuleResearch*> _researchById;
+	std::vector<Unit*> _unitsById;
+	std::vector<Armor*> _armorsById;
 	ModScriptGlobal *_scriptGlobal;
 
 	int _maxViewDistance, _maxDarknessToSeeUnits;
@@ -368,6 +376,11 @@ private:
 	/// Gets a ruleset element.
 	template <typename T>
 	T *getRule(const std::string &id, const std::string &name, const std::map<std::string, T*> &map, bool error) const;
+	/// Gets a ruleset element through its interned ID.
+	template <typename T>
+	T *getRule(const std::string &id, const std::string &name, const std::vector<T*> &byId, bool error) const;
+	/// Numbers the rule types looked up on hot paths.
+	void buildRuleIds();
 	/// Gets a random music. This is private to prevent access, use playMusic(name, true) instead.
 	Music *getRandomMusic(const std::string &name) const;
 	/// Gets a particular sound set. This is private to prevent access, use getSound(name, id) instead.
@@ -697,6 +710,8 @@ public:
 	const std::vector<std::string> &getItemCategoriesList() const;
 	/// Gets the ruleset for an item type.
 	RuleItem *getItem(const std::string &id, bool error = false) const;
+	/// Gets the ruleset for an item ID.
+	RuleItem *getItemById(int id) const { return id >= 0 && id < (int)_itemsById.size() ? _itemsById[id] : nullptr; }
 	/// Gets the available items.
 	const std::vector<std::string> &getItemsList() const;
 	/// Gets the ruleset for a weapon set type.
@@ -723,6 +738,8 @@ public:
 	const std::map<std::string, RuleCommendations *> &getCommendationsList() const;
 	/// Gets generated unit rules.
 	Unit *getUnit(const std::string &name, bool error = false) const;
+	/// Gets generated unit rules by ID.
+	Unit *getUnitById(int id) const { return id >= 0 && id < (int)_unitsById.size() ? _unitsById[id] : nullptr; }
 	/// Gets alien race rules.
 	AlienRace *getAlienRace(const std::string &name, bool error = false) const;
 	/// Gets the available alien races.
@@ -742,6 +759,8 @@ public:
 
 	/// Gets armor rules.
 	Armor *getArmor(const std::string &name, bool error = false) const;
+	/// Gets armor rules by ID.
+	Armor *getArmorById(int id) const { return id >= 0 && id < (int)_armorsById.size() ? _armorsById[id] : nullptr; }
 	/// Gets the all armors.
 	const std::vector<std::string> &getArmorsList() const;
 	/// Gets the available armors for soldiers.
@@ -1010,6 +1029,8 @@ public:
 
 	/// Gets the ruleset for a specific research project.
 	RuleResearch *getResearch(const std::string &id, bool error = false) const;
+	/// Gets the ruleset for a research project ID.
+	RuleResearch *getResearchById(int id) const { return id >= 0 && id < (int)_researchById.size() ? _researchById[id] : nullptr; }
 	/// Gets the ruleset for a specific research project.
 	std::vector<const RuleResearch*> getResearch(const std::vector<std::string> &id) const;
 	/// Gets the ruleset for a specific research project.
@@ -1083,6 +1104,10 @@ public:
 	RuleGlobe *getGlobe() const;
 	/// Gets the ruleset for the converter.
 	RuleConverter *getConverter() const;
+	/// Gets the interned ID of a rule type, RuleIdTable::None if no item, research, unit or armor has it.
+	int getRuleId(const std::string &type) const { return _ruleIds.find(type); }
+	/// Gets the reverse links between research and what it unlocks.
+	const DependencyGraph *getDependencyGraph() const { return _dependencyGraph; }
 	/// Gets the list of selective files for insertion into our cat files.
 	const std::map<std::string, SoundDefinition *> *getSoundDefinitions() const;
 	const std::vector<MapScript*> *getMapScript(const std::string& id) const;
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "RuleIdTable.h"
+#include "../Engine/Exception.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Gets the ID of a name. New names get the next free ID.
+ * @param name Rule type name.
+ * @return Its ID.
+ */
+int RuleIdTable::intern(const std::string &name)
+{
+	auto result = _ids.emplace(name, (int)_names.size());
+	if (result.second)
+	{
+		// keys of an unordered_map never move, so this stays valid
+		_names.push_back(&result.first->first);
+	}
+	return result.first->second;
+}
+
+/**
+ * Gets the ID of a name without adding it.
+ * @param name Rule type name.
+ * @return Its ID, or None if it was never interned.
+ */
+int RuleIdTable::find(const std::string &name) const
+{
+	auto i = _ids.find(name);
+	return i != _ids.end() ? i->second : None;
+}
+
+/**
+ * Gets the name an ID was given for.
+ * @param id Rule ID.
+ * @return Rule type name.
+ */
+const std::string &RuleIdTable::getName(int id) const
+{
+	if (id < 0 || id >= (int)_names.size())
+	{
+		throw Exception("Rule ID " + std::to_string(id) + " not found");
+	}
+	return *_names[id];
+}
+
+/**
+ * Forgets all names, the next one gets ID 0 again.
+ */
+void RuleIdTable::clear()
+{
+	_ids.clear();
+	_names.clear();
+}
+
+}
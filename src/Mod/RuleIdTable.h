@@ -0,0 +1,54 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenXcom
+{
+
+/**
+ * Interned rule type names. Every name gets a small dense number the
+ * first time it is added, shared by all rule kinds, so an item and a
+ * research topic called the same have the same ID. Rules can then be
+ * kept in plain arrays indexed by ID and a string only needs one hash
+ * lookup to reach them. IDs are only valid for the Mod that made them.
+ */
+class RuleIdTable
+{
+	std::unordered_map<std::string, int> _ids;
+	std::vector<const std::string*> _names;
+public:
+	/// ID of names that were never interned.
+	static const int None = -1;
+
+	/// Gets the ID of a name, adding it if needed.
+	int intern(const std::string &name);
+	/// Gets the ID of a name, or None.
+	int find(const std::string &name) const;
+	/// Gets the name of an ID.
+	const std::string &getName(int id) const;
+	/// Gets the number of IDs handed out.
+	int size() const { return (int)_names.size(); }
+	/// Forgets all names.
+	void clear();
+};
+
+}
@@ -465,6 +465,7 @@ private:
 	UnitFaction _zombieUnitFaction;
 	int _spawnUnitChance = -1;
 	int _zombieUnitChance = -1;
+	int _ruleId = -1;
 	int _spawnItemChance = -1;
 
 	int _targetMatrix;
@@ -513,6 +514,10 @@ public:
 
 	/// Gets the item's type.
 	const std::string &getType() const;
+	/// Gets the rule ID handed out by Mod, -1 before that.
+	int getRuleId() const { return _ruleId; }
+	/// Sets the rule ID, only Mod does this.
+	void setRuleId(int id) { _ruleId = id; }
 	/// Gets the item's name.
 	const std::string &getName() const;
 	/// Gets the item's name when loaded in weapon.
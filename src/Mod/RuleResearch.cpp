@@ -28,7 +28,7 @@ namespace OpenXcom
 RuleResearch::RuleResearch(const std::string &name, int listOrder) :
 	_name(name), _spawnedItemCount(1), _cost(0), _points(0),
 	_sequentialGetOneFree(false), _needItem(false), _destroyItem(false), _unlockFinalMission(false), _repeatable(false),
-	_listOrder(listOrder)
+	_listOrder(listOrder), _index(-1)
 {
 }
 
@@ -137,6 +137,38 @@ void RuleResearch::afterLoad(const Mod* mod)
 	Collections::removeAll(_getOneFreeProtectedName);
 }
 
+/**
+ * Gives every research a dense index and links each one back to the
+ * topics that depend on it or require it, so saved games can track
+ * research state in bitsets and update it per discovered topic.
+ * Needs afterLoad() to have run on all of them.
+ * @param research All research rules.
+ */
+void RuleResearch::afterLoadGraph(const std::map<std::string, RuleResearch*> &research)
+{
+	std::vector<RuleResearch*> byIndex;
+	byIndex.reserve(research.size());
+	for (auto& pair : research)
+	{
+		pair.second->_index = (int)byIndex.size();
+		pair.second->_dependents.clear();
+		pair.second->_requiredBy.clear();
+		byIndex.push_back(pair.second);
+	}
+	for (auto* rule : byIndex)
+	{
+		// duplicates are kept, SavedGame counts them the same way
+		for (auto* dep : rule->_dependencies)
+		{
+			byIndex[dep->_index]->_dependents.push_back(rule);
+		}
+		for (auto* req : rule->_requires)
+		{
+			byIndex[req->_index]->_requiredBy.push_back(rule);
+		}
+	}
+}
+
 /**
  * Gets the cost of this ResearchProject.
  * @return The cost of this ResearchProject (in man/day).
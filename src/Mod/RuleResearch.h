@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string>
+#include <map>
 #include <vector>
 #include "../Engine/Yaml.h"
 #include "RuleBaseFacilityFunctions.h"
@@ -59,6 +60,9 @@ class RuleResearch
 	bool _needItem, _destroyItem, _unlockFinalMission;
 	bool _repeatable;
 	int _listOrder;
+	int _index;
+	int _ruleId = -1;
+	std::vector<const RuleResearch*> _dependents, _requiredBy;
 
 	ScriptValues<RuleResearch> _scriptValues;
 public:
@@ -77,6 +81,8 @@ public:
 	void load(const YAML::YamlNodeReader& reader, Mod* mod, const ModScript& parsers);
 	/// Cross link with other rules.
 	void afterLoad(const Mod* mod);
+	/// Numbers all research and links the reverse dependency graph.
+	static void afterLoadGraph(const std::map<std::string, RuleResearch*> &research);
 
 	/// Gets time needed to discover this ResearchProject.
 	int getCost() const;
@@ -116,6 +122,16 @@ public:
 	RuleBaseFacilityFunctions getRequireBaseFunc() const { return _requiresBaseFunc; }
 	/// Gets the list weight for this research item.
 	int getListOrder() const;
+	/// Gets the position of this research in the research map, for research bitsets.
+	int getIndex() const { return _index; }
+	/// Gets the rule ID handed out by Mod, -1 before that.
+	int getRuleId() const { return _ruleId; }
+	/// Sets the rule ID, only Mod does this.
+	void setRuleId(int id) { _ruleId = id; }
+	/// Gets the list of ResearchProjects having this research as a dependency.
+	const std::vector<const RuleResearch*> &getDependents() const { return _dependents; }
+	/// Gets the list of ResearchProjects having this research as a requirement.
+	const std::vector<const RuleResearch*> &getRequiredBy() const { return _requiredBy; }
 	/// Gets the cutscene to play when this item is researched
 	const std::string & getCutscene() const;
 	/// Gets the item to spawn in the base stores when this topic is researched.
@@ -444,6 +444,7 @@ class Unit
 {
 private:
 	std::string _type;
+	int _ruleId = -1;
 	std::string _civilianRecoveryTypeName, _spawnedPersonName, _liveAlienName;
 	const RuleSoldier* _civilianRecoverySoldierType = nullptr;
 	const RuleItem* _civilianRecoveryItemType = nullptr;
@@ -492,6 +493,10 @@ public:
 
 	/// Gets the unit's type.
 	const std::string& getType() const;
+	/// Gets the rule ID handed out by Mod, -1 before that.
+	int getRuleId() const { return _ruleId; }
+	/// Sets the rule ID, only Mod does this.
+	void setRuleId(int id) { _ruleId = id; }
 
 	/// Gets if unit can be recovered as civilian.
 	bool isRecoverableAsCivilian() const { return _civilianRecoveryTypeName.empty() == false || _civilianRecoverySoldierType || _civilianRecoveryItemType; }
@@ -757,6 +757,34 @@ UfoDetection Base::detect(const Ufo *target, const SavedGame *save, bool already
 	return RNG::percent(args.getSecond()) ? (UfoDetection)args.getFirst() : DETECTION_NONE;
 }
 
+/**
+ * Gets the longest radar range among the facilities detect() looks at.
+ * Beyond it no facility contributes any detection chance.
+ * @return Range in nautical miles, 0 if the base has no radar.
+ */
+int Base::getDetectionRange() const
+{
+	int range = 0;
+	if (_coopBase == false)
+	{
+		for (const auto* fac : _facilities)
+		{
+			if (fac->getBuildTime() == 0)
+			{
+				range = std::max(range, fac->getRules()->getRadarRange());
+			}
+		}
+	}
+	else
+	{
+		for (int f = 0; f < (int)_facilitiesCoop.size(); f++)
+		{
+			range = std::max(range, _facilitiesCoop[f]["radar_range_coop"].asInt());
+		}
+	}
+	return range;
+}
+
 /**
  * Returns the amount of soldiers contained
  * in the base without any assignments.
@@ -1742,14 +1770,7 @@ int Base::getUsedContainment(int prisonType, bool onlyExternal) const
 		return total;
 	}
 
-	for (const auto& pair : *_items->getContents())
-	{
-		rule = pair.first;
-		if (rule->isAlien() && rule->getPrisonType() == prisonType)
-		{
-			total += pair.second;
-		}
-	}
+	total += _items->getTotalPrisoners(prisonType);
 	return total;
 }
 
@@ -202,6 +202,8 @@ public:
 	void setEngineers(int engineers);
 	/// Checks if a target is detected by the base's radar.
 	UfoDetection detect(const Ufo *target, const SavedGame *save, bool alreadyTracked) const;
+	/// Gets the longest range at which the base's radars can see anything.
+	int getDetectionRange() const;
 	/// Gets the base's available soldiers.
 	int getAvailableSoldiers(bool checkCombatReadiness = false, bool includeWounded = false) const;
 	/// Gets the base's total soldiers.
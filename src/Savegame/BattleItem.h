@@ -20,6 +20,7 @@
 #include "../Engine/Yaml.h"
 #include "../Mod/RuleItem.h"
 #include "../Engine/Script.h"
+#include "../Battlescape/BattlePool.h"
 
 namespace OpenXcom
 {
@@ -69,6 +70,7 @@ private:
 	ScriptValues<BattleItem> _scriptValues;
 
 public:
+	BATTLE_POOL_ALLOCATED(POOL_ITEMS)
 
 	/// Name of class used in script.
 	static constexpr const char *ScriptName = "BattleItem";
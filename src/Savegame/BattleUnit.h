@@ -28,6 +28,7 @@
 
 #include "../Engine/Game.h"
 #include "../Battlescape/BattlescapeGame.h"
+#include "../Battlescape/BattlePool.h"
 
 namespace OpenXcom
 {
@@ -209,6 +210,8 @@ private:
 	/// Applies percentual and/or flat adjustments to the use costs.
 	void applyPercentages(RuleItemUseCost &cost, const RuleItemUseFlat &flat) const;
 public:
+	BATTLE_POOL_ALLOCATED(POOL_UNITS)
+
 	// coop
 	void setDestinationCoop(Position pos);
 	void setLastPosCoop(Position pos);
@@ -1336,6 +1336,16 @@ bool Craft::isTakingOff() const
 	return _takeoff == 60;
 }
 
+/**
+ * Checks if think() would leave the craft as it is:
+ * no destination, no takeoff under way and still in one piece.
+ * @return True if the craft is idle.
+ */
+bool Craft::isIdle() const
+{
+	return _dest == 0 && _takeoff == 0 && !isDestroyed();
+}
+
 /**
  * Checks the condition of all the craft's systems
  * to define its new status (eg. when arriving at base).
@@ -277,6 +277,8 @@ public:
 	bool think();
 	/// Is the craft about to take off?
 	bool isTakingOff() const;
+	/// Is the craft standing still with nothing to do on the geoscape?
+	bool isIdle() const;
 	/// Does a craft full checkup.
 	void checkup();
 	/// Consumes the craft's fuel.
@@ -18,6 +18,7 @@
  */
 #include "GameTime.h"
 #include "../Engine/Language.h"
+#include <algorithm>
 #include <iomanip>
 
 namespace OpenXcom
@@ -146,6 +147,42 @@ TimeTrigger GameTime::advance()
 	return trigger;
 }
 
+/**
+ * Gets how many calls to advance() it takes to reach a
+ * trigger other than TIME_5SEC, counting the one that does.
+ * @return Number of 5 second steps, at least 1.
+ */
+int GameTime::getStepsToTrigger() const
+{
+	return (60 - _second + 4) / 5 + 12 * (9 - _minute % 10);
+}
+
+/**
+ * Advances the time the same way as calling advance() the given
+ * number of times. Stops one step short of the next trigger, so
+ * the step that reaches it still goes through advance().
+ * @param steps Number of 5 second steps.
+ * @return Number of steps actually skipped.
+ */
+int GameTime::skip(int steps)
+{
+	steps = std::max(0, std::min(steps, getStepsToTrigger() - 1));
+	int skipped = steps;
+	while (steps > 0)
+	{
+		int stepsToMinute = (60 - _second + 4) / 5;
+		if (steps < stepsToMinute)
+		{
+			_second += 5 * steps;
+			break;
+		}
+		steps -= stepsToMinute;
+		_minute++;
+		_second = 0;
+	}
+	return skipped;
+}
+
 /**
  * Returns the current ingame second.
  * @return Second (0-59).
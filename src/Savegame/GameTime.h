@@ -52,6 +52,10 @@ public:
 	bool isLastDayOfMonth();
 	/// Advances the time by 5 seconds.
 	TimeTrigger advance();
+	/// Gets the number of 5 second steps up to the next 10 minute trigger.
+	int getStepsToTrigger() const;
+	/// Advances the time by several 5 second steps without a trigger.
+	int skip(int steps);
 	/// Gets the ingame second.
 	int getSecond() const;
 	/// Gets the ingame minute.
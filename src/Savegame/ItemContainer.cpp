@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "ItemContainer.h"
+#include <cassert>
 #include "../Mod/Mod.h"
 #include "../Mod/RuleItem.h"
 
@@ -26,7 +27,7 @@ namespace OpenXcom
 /**
  * Initializes an item container with no contents.
  */
-ItemContainer::ItemContainer()
+ItemContainer::ItemContainer() : _cacheValid(false), _totalQuantity(0), _totalSize(0)
 {
 }
 
@@ -46,6 +47,7 @@ void ItemContainer::load(const YAML::YamlNodeReader& reader, const Mod* mod)
 	if (!reader || !reader.isMap())
 		return;
 	_qty.clear();
+	_cacheValid = false;
 	for (const auto& item : reader.children())
 	{
 		std::string name = item.readKey<std::string>();
@@ -88,6 +90,7 @@ void ItemContainer::addItem(const RuleItem* item, int qty)
 	if (item)
 	{
 		_qty[item] += qty;
+		_cacheValid = false;
 	}
 }
 
@@ -116,6 +119,7 @@ void ItemContainer::removeItem(const std::string &id, int qty)
 	{
 		_qty.erase(it);
 	}
+	_cacheValid = false;
 }
 
 /**
@@ -141,6 +145,7 @@ void ItemContainer::removeItem(const RuleItem* item, int qty)
 		{
 			_qty.erase(it);
 		}
+		_cacheValid = false;
 	}
 }
 
@@ -198,12 +203,8 @@ int ItemContainer::getItem(const RuleItem* item) const
  */
 int ItemContainer::getTotalQuantity() const
 {
-	int total = 0;
-	for (const auto& pair : _qty)
-	{
-		total += pair.second;
-	}
-	return total;
+	updateCache();
+	return _totalQuantity;
 }
 
 /**
@@ -212,12 +213,71 @@ int ItemContainer::getTotalQuantity() const
  */
 double ItemContainer::getTotalSize() const
 {
-	double total = 0;
+	updateCache();
+	return _totalSize;
+}
+
+/**
+ * Returns the total quantity of live aliens kept in
+ * a given type of containment.
+ * @param prisonType Prison type.
+ * @return Total alien quantity.
+ */
+int ItemContainer::getTotalPrisoners(int prisonType) const
+{
+	updateCache();
+	auto it = _totalPrisoners.find(prisonType);
+	return it != _totalPrisoners.end() ? it->second : 0;
+}
+
+/**
+ * Recomputes all the totals in one pass over the contents,
+ * only if something was added or removed since the last time.
+ */
+void ItemContainer::updateCache() const
+{
+	if (_cacheValid)
+	{
+		checkCache();
+		return;
+	}
+	_totalQuantity = 0;
+	_totalSize = 0;
+	_totalPrisoners.clear();
+	for (const auto& pair : _qty)
+	{
+		_totalQuantity += pair.second;
+		_totalSize += pair.first->getSize() * pair.second;
+		if (pair.first->isAlien())
+		{
+			_totalPrisoners[pair.first->getPrisonType()] += pair.second;
+		}
+	}
+	_cacheValid = true;
+}
+
+/**
+ * Recomputes the totals the slow way and compares them with the
+ * cached ones, catching any change to the contents that bypassed
+ * the invalidation. Does nothing in release builds.
+ */
+void ItemContainer::checkCache() const
+{
+#ifndef NDEBUG
+	int quantity = 0;
+	double size = 0;
+	std::map<int, int> prisoners;
 	for (const auto& pair : _qty)
 	{
-		total += pair.first->getSize() * pair.second;
+		quantity += pair.second;
+		size += pair.first->getSize() * pair.second;
+		if (pair.first->isAlien())
+		{
+			prisoners[pair.first->getPrisonType()] += pair.second;
+		}
 	}
-	return total;
+	assert(quantity == _totalQuantity && size == _totalSize && prisoners == _totalPrisoners && "Stale item container totals.");
+#endif
 }
 
 /**
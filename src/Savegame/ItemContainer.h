@@ -36,6 +36,17 @@ class ItemContainer
 {
 private:
 	std::map<const RuleItem*, int> _qty;
+	// totals are recomputed on first use after a change, as the
+	// base screens ask for them on every redraw
+	mutable bool _cacheValid;
+	mutable int _totalQuantity;
+	mutable double _totalSize;
+	mutable std::map<int, int> _totalPrisoners;
+
+	/// Recomputes the cached totals if the contents changed.
+	void updateCache() const;
+	/// Checks the cached totals against the contents (debug builds only).
+	void checkCache() const;
 public:
 	/// Creates an empty item container.
 	ItemContainer();
@@ -61,10 +72,12 @@ public:
 	int getTotalQuantity() const;
 	/// Gets the total size of items in the container.
 	double getTotalSize() const;
+	/// Gets the total quantity of live aliens of a prison type in the container.
+	int getTotalPrisoners(int prisonType) const;
 	/// Check if have any item
 	bool empty() const { return _qty.empty(); }
 	/// Clear all content.
-	void clear() { _qty.clear(); }
+	void clear() { _qty.clear(); _cacheValid = false; }
 	/// Gets all the items in the container.
 	const std::map<const RuleItem*, int> *getContents() const;
 };
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ResearchFrontier.h"
+#include "../Mod/RuleResearch.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Makes room for a research index, the
+ * tables only grow as far as they are used.
+ * @param index Research index.
+ */
+void ResearchFrontier::grow(int index)
+{
+	if (index >= (int)_discovered.size())
+	{
+		_discovered.resize(index + 1, false);
+		_unlocked.resize(index + 1, 0);
+		_dependencies.resize(index + 1, 0);
+		_requirements.resize(index + 1, 0);
+	}
+}
+
+/**
+ * Updates the counts of every topic linked to a discovered one.
+ * @param research Discovered topic.
+ * @param delta 1 when discovered, -1 when forgotten.
+ */
+void ResearchFrontier::link(const RuleResearch *research, int delta)
+{
+	for (const auto* unl : research->getUnlocked())
+	{
+		grow(unl->getIndex());
+		_unlocked[unl->getIndex()] += delta;
+	}
+	for (const auto* dep : research->getDependents())
+	{
+		grow(dep->getIndex());
+		_dependencies[dep->getIndex()] += delta;
+	}
+	for (const auto* req : research->getRequiredBy())
+	{
+		grow(req->getIndex());
+		_requirements[req->getIndex()] += delta;
+	}
+}
+
+/**
+ * Forgets all research.
+ */
+void ResearchFrontier::clear()
+{
+	_discovered.clear();
+	_unlocked.clear();
+	_dependencies.clear();
+	_requirements.clear();
+}
+
+/**
+ * Recomputes everything from a list of discovered research.
+ * @param discovered Discovered research, duplicates allowed.
+ */
+void ResearchFrontier::rebuild(const std::vector<const RuleResearch*> &discovered)
+{
+	clear();
+	for (const auto* research : discovered)
+	{
+		add(research);
+	}
+}
+
+/**
+ * Marks a topic as discovered, does nothing if it already was.
+ * @param research Research topic.
+ */
+void ResearchFrontier::add(const RuleResearch *research)
+{
+	if (isDiscovered(research))
+	{
+		return;
+	}
+	grow(research->getIndex());
+	_discovered[research->getIndex()] = true;
+	link(research, 1);
+}
+
+/**
+ * Marks a topic as not discovered, does nothing if it wasn't.
+ * @param research Research topic.
+ */
+void ResearchFrontier::remove(const RuleResearch *research)
+{
+	if (!isDiscovered(research))
+	{
+		return;
+	}
+	_discovered[research->getIndex()] = false;
+	link(research, -1);
+}
+
+/**
+ * Checks if a topic is discovered.
+ * @param research Research topic.
+ * @return True if discovered.
+ */
+bool ResearchFrontier::isDiscovered(const RuleResearch *research) const
+{
+	int index = research->getIndex();
+	return index < (int)_discovered.size() && _discovered[index];
+}
+
+/**
+ * Checks if any discovered topic lists this one in its unlocks.
+ * @param research Research topic.
+ * @return True if unlocked.
+ */
+bool ResearchFrontier::isUnlocked(const RuleResearch *research) const
+{
+	int index = research->getIndex();
+	return index < (int)_unlocked.size() && _unlocked[index] > 0;
+}
+
+/**
+ * Checks if all dependencies of a topic are discovered.
+ * @param research Research topic.
+ * @return True if there are no dependencies left.
+ */
+bool ResearchFrontier::hasDependencies(const RuleResearch *research) const
+{
+	int index = research->getIndex();
+	int count = index < (int)_dependencies.size() ? _dependencies[index] : 0;
+	return count == (int)research->getDependencies().size();
+}
+
+/**
+ * Checks if all requirements of a topic are discovered.
+ * @param research Research topic.
+ * @return True if there are no requirements left.
+ */
+bool ResearchFrontier::hasRequirements(const RuleResearch *research) const
+{
+	int index = research->getIndex();
+	int count = index < (int)_requirements.size() ? _requirements[index] : 0;
+	return count == (int)research->getRequirements().size();
+}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+
+namespace OpenXcom
+{
+
+class RuleResearch;
+
+/**
+ * Discovered research kept as a bitset indexed by RuleResearch::getIndex(),
+ * together with per topic counts of discovered dependencies, requirements
+ * and unlocking topics. Discovering a topic only touches the topics linked
+ * to it, after that every availability check is a couple of lookups
+ * instead of searching the discovered list for each dependency.
+ */
+class ResearchFrontier
+{
+	std::vector<bool> _discovered;
+	std::vector<int> _unlocked, _dependencies, _requirements;
+
+	/// Makes room for a research index.
+	void grow(int index);
+	/// Adds or removes the counts contributed by a discovered topic.
+	void link(const RuleResearch *research, int delta);
+public:
+	/// Forgets all research.
+	void clear();
+	/// Recomputes everything from a list of discovered research.
+	void rebuild(const std::vector<const RuleResearch*> &discovered);
+	/// Marks a topic as discovered.
+	void add(const RuleResearch *research);
+	/// Marks a topic as not discovered.
+	void remove(const RuleResearch *research);
+	/// Checks if a topic is discovered.
+	bool isDiscovered(const RuleResearch *research) const;
+	/// Checks if a discovered topic unlocks this one.
+	bool isUnlocked(const RuleResearch *research) const;
+	/// Checks if all dependencies of a topic are discovered.
+	bool hasDependencies(const RuleResearch *research) const;
+	/// Checks if all requirements of a topic are discovered.
+	bool hasRequirements(const RuleResearch *research) const;
+};
+
+}
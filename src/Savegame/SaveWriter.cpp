@@ -0,0 +1,198 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SaveWriter.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <SDL.h>
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Logger.h"
+
+namespace OpenXcom
+{
+
+namespace SaveWriter
+{
+
+namespace
+{
+
+struct Job
+{
+	std::string filepath;
+	std::string data;
+};
+
+std::mutex _mutex;
+std::condition_variable _wake;
+std::condition_variable _idle;
+std::deque<Job> _jobs;
+std::vector<std::string> _errors;
+std::thread _thread;
+bool _busy = false;
+bool _quit = false;
+
+/**
+ * Writes a file through a backup and rename.
+ * Runs on the writer thread, so it doesn't log, errors are returned
+ * to the caller.
+ * @param job File to write.
+ * @return Error message, empty on success.
+ */
+std::string writeJob(const Job &job)
+{
+	std::string backup = job.filepath + ".bak";
+	// same mode as CrossPlatform::writeFile, so the bytes match a synchronous save
+	SDL_RWops *rwops = SDL_RWFromFile(backup.c_str(), "w");
+	if (!rwops)
+	{
+		return "Failed to write " + backup + ": " + SDL_GetError();
+	}
+	bool ok = job.data.empty() || SDL_RWwrite(rwops, job.data.c_str(), job.data.size(), 1) == 1;
+	if (SDL_RWclose(rwops) != 0)
+	{
+		ok = false;
+	}
+	if (!ok)
+	{
+		return "Failed to write " + backup;
+	}
+	if (!CrossPlatform::moveFile(backup, job.filepath))
+	{
+		return "Save backed up in " + backup;
+	}
+	return std::string();
+}
+
+/**
+ * Writer thread loop, runs until shutdown.
+ */
+void run()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (true)
+	{
+		_wake.wait(lock, [] { return _quit || !_jobs.empty(); });
+		if (_jobs.empty())
+		{
+			break;
+		}
+		Job job = std::move(_jobs.front());
+		_jobs.pop_front();
+		_busy = true;
+
+		lock.unlock();
+		std::string error = writeJob(job);
+		lock.lock();
+
+		_busy = false;
+		if (!error.empty())
+		{
+			_errors.push_back(std::move(error));
+		}
+		if (_jobs.empty())
+		{
+			_idle.notify_all();
+		}
+	}
+}
+
+} // namespace
+
+/**
+ * Queues a file to be written by the writer thread, starting it if needed.
+ * A pending write of the same file is dropped, as it is already out of date.
+ * @param filepath Full path of the file.
+ * @param data Whole file contents.
+ */
+void queue(const std::string &filepath, std::string data)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	bool replaced = false;
+	for (auto &job : _jobs)
+	{
+		if (job.filepath == filepath)
+		{
+			job.data = std::move(data);
+			replaced = true;
+			break;
+		}
+	}
+	if (!replaced)
+	{
+		_jobs.push_back(Job{ filepath, std::move(data) });
+	}
+	if (!_thread.joinable())
+	{
+		_quit = false;
+		_thread = std::thread(run);
+	}
+	_wake.notify_one();
+}
+
+/**
+ * Blocks until every queued file is written, needed
+ * before the files are read back or listed.
+ */
+void wait()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_idle.wait(lock, [] { return _jobs.empty() && !_busy; });
+}
+
+/**
+ * Takes the errors the writer thread ran into, so the main
+ * thread can log them and tell the player.
+ * @return Error messages, oldest first.
+ */
+std::vector<std::string> takeErrors()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::vector<std::string> errors;
+	errors.swap(_errors);
+	for (const auto &error : errors)
+	{
+		Log(LOG_ERROR) << error;
+	}
+	return errors;
+}
+
+/**
+ * Finishes the queue and joins the writer thread.
+ */
+void shutdown()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_quit = true;
+	}
+	_wake.notify_one();
+	if (_thread.joinable())
+	{
+		_thread.join();
+	}
+	takeErrors();
+}
+
+}
+
+}
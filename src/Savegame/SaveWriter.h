@@ -0,0 +1,48 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+
+namespace OpenXcom
+{
+
+/**
+ * Background writer for serialized saves.
+ * Serializing a save is fast enough to do on the main thread,
+ * but writing several megabytes to disk is not.
+ * Each queued file is written to a ".bak" file next to it and
+ * then renamed over the old one, so a crash mid-write leaves the
+ * previous save in place. There is no fsync, so a power cut right
+ * after the rename can still lose the new one.
+ * Errors are kept until the main thread takes them to show them.
+ */
+namespace SaveWriter
+{
+	/// Queues a file to be written, replacing a pending write of the same file.
+	void queue(const std::string &filepath, std::string data);
+	/// Blocks until every queued file is on disk.
+	void wait();
+	/// Takes the errors of finished writes.
+	std::vector<std::string> takeErrors();
+	/// Waits for the queue and stops the writer thread.
+	void shutdown();
+}
+
+}
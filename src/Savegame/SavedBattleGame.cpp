@@ -32,6 +32,7 @@
 #include "../Battlescape/TileEngine.h"
 #include "../Battlescape/BattlescapeState.h"
 #include "../Battlescape/BattlescapeGame.h"
+#include "../Battlescape/BattlePool.h"
 #include "../Battlescape/Position.h"
 #include "../Battlescape/Inventory.h"
 #include "../Mod/Mod.h"
@@ -54,6 +55,7 @@
 #include "../fallthrough.h"
 #include "../fmath.h"
 #include "../Engine/Language.h"
+#include "../CoopMod/CoopMessages.h"
 
 namespace OpenXcom
 {
@@ -99,30 +101,17 @@ SavedBattleGame::~SavedBattleGame()
 	{
 		delete node;
 	}
-	for (auto* bu : _units)
-	{
-		delete bu;
-	}
-	for (auto bi : _items)
-	{
-		delete bi;
-	}
-	for (auto* bi : _recoverGuaranteed)
-	{
-		delete bi;
-	}
-	for (auto* bi : _recoverConditional)
-	{
-		delete bi;
-	}
-	for (auto* bi : _deleted)
-	{
-		delete bi;
-	}
+	// units and items live in the battle pool, their memory goes in one piece
+	BattlePool::destroyAll(_units, BattlePool::POOL_UNITS);
+	BattlePool::destroyAll(_items, BattlePool::POOL_ITEMS);
+	BattlePool::destroyAll(_recoverGuaranteed, BattlePool::POOL_ITEMS);
+	BattlePool::destroyAll(_recoverConditional, BattlePool::POOL_ITEMS);
+	BattlePool::destroyAll(_deleted, BattlePool::POOL_ITEMS);
 	delete _pathfinding;
 	delete _tileEngine;
 	delete _baseItems;
 	delete _hitLog;
+	BattlePool::endBattle();
 }
 
 /**
@@ -1533,6 +1522,7 @@ void SavedBattleGame::endTurn()
 	{
 		prepareNewTurn();
 		_turn++;
+		BattlePool::newTurn();
 		_side = FACTION_PLAYER;
 		if (_lastSelectedUnit && _lastSelectedUnit->isSelectable(FACTION_PLAYER, false, false))
 			_selectedUnit = _lastSelectedUnit;
@@ -2281,15 +2271,7 @@ BattleUnit *SavedBattleGame::convertUnit(BattleUnit *unit)
 	if (connectionTCP::getCoopStatic() == true && connectionTCP::getHost() == true)
 	{
 
-		Json::Value root;
-		root["state"] = "convertUnit";
-
-		root["unit_id"] = unit->getId();
-		root["respawn"] = unit->getRespawn();
-		root["spawn_unit_faction"] = (int)unit->getSpawnUnitFaction();
-		root["spawn_unit_type"] = unit->getSpawnUnit()->getType();
-
-		connectionTCP::sendTCPPacketStaticData2(root.toStyledString());
+		CoopJson::send(UnitConvert{ unit->getId(), unit->getRespawn(), (int)unit->getSpawnUnitFaction(), unit->getSpawnUnit()->getType() });
 
 		// PVP
 		if (connectionTCP::getCoopGamemode() == 2)
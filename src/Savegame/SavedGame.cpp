@@ -28,6 +28,7 @@
 #include "../version.h"
 #include "../Engine/Logger.h"
 #include "../Mod/Mod.h"
+#include "../Mod/DependencyGraph.h"
 #include "../Engine/RNG.h"
 #include "../Engine/Exception.h"
 #include "../Engine/Options.h"
@@ -69,6 +70,7 @@
 #include "ResearchDiary.h"
 #include "../Mod/AlienRace.h"
 #include "RankCount.h"
+#include "SaveWriter.h"
 
 #include "../CoopMod/CoopMenu.h"
 #include "../CoopMod/connectionTCP.h"
@@ -96,6 +98,11 @@ void sortReserchVector(std::vector<T> &vec)
 	std::sort(vec.begin(), vec.end(), researchLess);
 }
 
+void insertReserchVector(std::vector<const RuleResearch*> &vec, const RuleResearch *res)
+{
+	vec.insert(std::upper_bound(vec.begin(), vec.end(), res, researchLess), res);
+}
+
 bool haveReserchVector(const std::vector<const RuleResearch*> &vec, const RuleResearch *res)
 {
 	auto find = std::lower_bound(vec.begin(), vec.end(), res, researchLess);
@@ -263,6 +270,7 @@ std::vector<SaveInfo> SavedGame::getList(Language *lang, bool autoquick)
 {
 	std::vector<SaveInfo> info;
 	std::string curMaster = Options::getActiveMaster();
+	SaveWriter::wait();
 	auto saves = CrossPlatform::getFolderContents(Options::getMasterUserFolder(), "sav");
 
 	if (autoquick)
@@ -540,6 +548,7 @@ void SavedGame::loadCoopSaveFromMemory(const std::string& filename, Mod* mod, La
 		}
 	}
 	sortReserchVector(_discovered);
+	_researchFrontier.rebuild(_discovered);
 
 	// Research Diary
 	{
@@ -561,6 +570,7 @@ void SavedGame::loadCoopSaveFromMemory(const std::string& filename, Mod* mod, La
 	loadUfopediaRuleStatus(reader["ufopediaRuleStatus"]);
 	reader.tryRead("manufactureRuleStatus", _manufactureRuleStatus);
 	reader.tryRead("researchRuleStatus", _researchRuleStatus);
+	_researchRuleStatusCache.clear();
 	reader.tryRead("monthlyPurchaseLimitLog", _monthlyPurchaseLimitLog);
 	reader.tryRead("hiddenPurchaseItems", _hiddenPurchaseItemsMap);
 	reader.tryRead("customRuleCraftDeployments", _customRuleCraftDeployments);
@@ -762,8 +772,8 @@ void SavedGame::setDaysPassed(int days)
  */
 void SavedGame::addFinishedResearchSimple(const RuleResearch* research)
 {
-	_discovered.push_back(research);
-	sortReserchVector(_discovered);
+	insertReserchVector(_discovered, research);
+	_researchFrontier.add(research);
 }
 
 /**
@@ -802,6 +812,7 @@ void SavedGame::migrateSharedSoldierOwnership()
 void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 {
 
+	SaveWriter::wait();
 	std::string filepath = Options::getMasterUserFolder() + filename;
 	YAML::YamlRootNodeReader documents(filepath, false, false);
 
@@ -1078,6 +1089,7 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 		}
 	}
 	sortReserchVector(_discovered);
+	_researchFrontier.rebuild(_discovered);
 
 	// Research Diary
 	{
@@ -1099,6 +1111,7 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 	loadUfopediaRuleStatus(reader["ufopediaRuleStatus"]);
 	reader.tryRead("manufactureRuleStatus", _manufactureRuleStatus);
 	reader.tryRead("researchRuleStatus", _researchRuleStatus);
+	_researchRuleStatusCache.clear();
 	reader.tryRead("monthlyPurchaseLimitLog", _monthlyPurchaseLimitLog);
 	reader.tryRead("hiddenPurchaseItems", _hiddenPurchaseItemsMap);
 	reader.tryRead("customRuleCraftDeployments", _customRuleCraftDeployments);
@@ -1264,8 +1277,42 @@ void saveVectorIf(YAML::YamlNodeWriter& writer,
 	}
 }
 
-void SavedGame::saveCoopToMemory(const std::string& filename, Mod* mod, const std::string& key) const
+/**
+ * Checks if the bases are complete enough to be sent to a co-op peer.
+ * @return True if the world can be stored in memory.
+ */
+bool SavedGame::validateCoopBases() const
 {
+	bool error = false;
+	bool found = false;
+
+	for (auto& base : _bases)
+	{
+
+		if (base->_coopBase == false)
+		{
+			found = true;
+		}
+
+		if (base->getName().empty() || (base->getLongitude() == 0 && base->getLatitude() == 0))
+		{
+			error = true;
+			break;
+		}
+	}
+
+	return !((error == true || found == false) && connectionTCP::no_bases == false && connectionTCP::_coopCampaign == true);
+}
+
+/**
+ * Serializes the saved game into the header and body YAML documents.
+ * Client worlds embedded in host saves are not included, see serializeClientSaves().
+ * @param mod Mod for the script values.
+ * @return Whole save file contents.
+ */
+std::string SavedGame::serialize(Mod *mod) const
+{
+
 	YAML::YamlRootNodeWriter headerWriter;
 	headerWriter.setAsMap();
 	// Saves the brief game info used in the saves list
@@ -1300,8 +1347,9 @@ void SavedGame::saveCoopToMemory(const std::string& filename, Mod* mod, const st
 	if (_ironman)
 		headerWriter.write("ironman", _ironman);
 
-	// coop campaign markers (kept in blob headers too, so client worlds
-	// loaded from memory carry the same campaign identity)
+	// coop campaign markers live in the header so the save list and load
+	// routing can read them without parsing the body (kept in blob headers
+	// too, so client worlds loaded from memory carry the same campaign identity)
 	if (_coop)
 	{
 		headerWriter.write("coop", _coop);
@@ -1325,7 +1373,6 @@ void SavedGame::saveCoopToMemory(const std::string& filename, Mod* mod, const st
 	writer.write("coop_gamemode", connectionTCP::_coopGamemode);
 	writer.write("coop_save_owner_player_id", connectionTCP::coop_save_owner_player_id);
 	writer.write("no_bases", connectionTCP::no_bases);
-
 	writer.write("monthsPassed", _monthsPassed);
 	writer.write("daysPassed", _daysPassed);
 	writer.write("vehiclesLost", _vehiclesLost);
@@ -1360,41 +1407,17 @@ void SavedGame::saveCoopToMemory(const std::string& filename, Mod* mod, const st
 	saveVector(writer, _countries, "countries", mod->getScriptGlobal());
 	saveVector(writer, _regions, "regions");
 
-	bool error = false;
-	bool found = false;
-
-	for (auto& base : _bases)
-	{
-
-		if (base->_coopBase == false)
-		{
-			found = true;
-		}
-
-		if (base->getName().empty() || (base->getLongitude() == 0 && base->getLatitude() == 0))
-		{
-			error = true;
-			break;
-		}
-	}
-
-	if ((error == true || found == false) && connectionTCP::no_bases == false && connectionTCP::_coopCampaign == true)
-	{
-		connectionTCP::saveError = true;
-		return;
-	}
-
 	// coop
 	saveVectorIf(writer, _bases, "bases",
 				 [](const Base* b)
 				 { return !b->_coopIcon; });
-
+	
 	saveVector(writer, _waypoints, "waypoints");
 
 	// coop
 	saveVectorIf(writer, _missionSites, "missionSites",
-				 [](const MissionSite* ms)
-				 { return !ms->_coop; });
+				[](const MissionSite* ms)
+				{ return !ms->_coop; });
 
 	// Alien bases must be saved before alien missions.
 	// coop
@@ -1434,8 +1457,8 @@ void SavedGame::saveCoopToMemory(const std::string& filename, Mod* mod, const st
 	}
 	saveVector(writer, _researchDiary, "researchDiary");
 	writer.write("poppedResearch", _poppedResearch,
-				 [](YAML::YamlNodeWriter& w, const RuleResearch* r)
-				 { w.write(r->getName()); });
+		[](YAML::YamlNodeWriter& w, const RuleResearch* r)
+		{ w.write(r->getName()); });
 	writer.write("generatedEvents", _generatedEvents);
 	writer.write("ufopediaRuleStatus", _ufopediaRuleStatus);
 	writer.write("manufactureRuleStatus", _manufactureRuleStatus);
@@ -1472,7 +1495,7 @@ void SavedGame::saveCoopToMemory(const std::string& filename, Mod* mod, const st
 		{
 			std::vector<const RuleItem*> autosalesVector(_autosales.begin(), _autosales.end());
 			std::sort(autosalesVector.begin(), autosalesVector.end(), [&](const RuleItem* a, const RuleItem* b)
-					  { return a->getType().compare(b->getType()) < 0; });
+				{ return a->getType().compare(b->getType()) < 0; });
 			for (const auto* sale : autosalesVector)
 			{
 				autoSales.write(sale->getType());
@@ -1500,87 +1523,19 @@ void SavedGame::saveCoopToMemory(const std::string& filename, Mod* mod, const st
 	finalString += directivesEndMarker;
 	finalString += bodyString.yaml;
 
-	// Save to memory
-	{
-		std::lock_guard<std::mutex> lock(connectionTCP::coopFilesMutex);
-		if (connectionTCP::getServerOwner() == true)
-		{
-			connectionTCP::coopFilesHost[key] = std::move(finalString);
-		}
-		else
-		{
-			connectionTCP::coopFilesClient[key] = std::move(finalString);
-		}
-	}
-
+	return finalString;
 }
 
 /**
- * Saves a saved game's contents to a YAML file.
- * @param filename YAML filename.
+ * Serializes the client worlds a host save carries next to its own world.
+ * The result is a top-level YAML mapping entry, appended to the body
+ * produced by serialize(), so the host world is serialized the same way
+ * for the save file and the co-op blob (each still serializes it anew).
+ * @param filename Target filename, used to skip client sidecars.
+ * @return YAML text, or empty if there is nothing to embed.
  */
-void SavedGame::save(const std::string &filename, Mod *mod) const
+std::string SavedGame::serializeClientSaves(const std::string &filename) const
 {
-
-	YAML::YamlRootNodeWriter headerWriter;
-	headerWriter.setAsMap();
-	// Saves the brief game info used in the saves list
-
-	headerWriter.write("name", _name);
-	headerWriter.write("version", OPENXCOM_VERSION_SHORT);
-	headerWriter.write("engine", OPENXCOM_VERSION_ENGINE);
-	std::string git_sha = OPENXCOM_VERSION_GIT;
-	if (!git_sha.empty() && git_sha[0] == '.')
-		git_sha.erase(0, 1);
-	headerWriter.write("build", git_sha);
-	// Schema stamp: every save (the host .sav AND every embedded client blob, which
-	// are full 2-doc saves) carries the current co-op save schema so the load gate
-	// can classify old saves. Unstamped schema-2 saves gain this on their next save.
-	// See src/Savegame/Upgrade/ and PRD save-upgrader.md.
-	headerWriter.write("saveSchema", (int)SAVE_SCHEMA_CURRENT);
-	_time->save(headerWriter["time"]);
-	if (_battleGame != 0)
-	{
-		headerWriter.write("mission", _battleGame->getMissionType());
-		headerWriter.write("target", _battleGame->getMissionTarget());
-		headerWriter.write("craftOrBase", _battleGame->getMissionCraftOrBase()).setAsQuotedAndEscaped();
-		headerWriter.write("turn", _battleGame->getTurn());
-	}
-
-	// only save mods that work with the current master
-	std::vector<std::string> modsList;
-	for (const auto* modInfo : Options::getActiveMods())
-		modsList.push_back(modInfo->getId() + " ver: " + modInfo->getVersion());
-	headerWriter.write("mods", modsList);
-
-	if (_ironman)
-		headerWriter.write("ironman", _ironman);
-
-	// coop campaign markers live in the header so the save list and load
-	// routing can read them without parsing the body
-	if (_coop)
-	{
-		headerWriter.write("coop", _coop);
-		headerWriter.write("coopPlayers", _coopPlayers);
-		// PRD-J01: economy model beside coop (int); mirror of the load read.
-		headerWriter.write("coopCampaignType", static_cast<int>(_campaignType));
-	}
-
-	// Saves the full game data to the save
-	YAML::YamlRootNodeWriter writer(1000000); //1MB starting buffer
-	writer.setAsMap();
-	writer.write("difficulty", _difficulty);
-	writer.write("end", _end);
-
-	// coop
-	// Only a coop save carries a saveID; a solo save must not (the load gate
-	// throws on !_coop && saveID != 0). Same condition as the "coop" header
-	// marker above, so the two can never disagree (fixes C1).
-	if (_coop)
-		writer.write("saveID", connectionTCP::saveID);
-	writer.write("coop_gamemode", connectionTCP::_coopGamemode);
-	writer.write("coop_save_owner_player_id", connectionTCP::coop_save_owner_player_id);
-	writer.write("no_bases", connectionTCP::no_bases);
 	// Single-authority: embed the freshest client-world blob of EVERY client
 	// so this save captures all players' rosters atomically. Skip when this
 	// call is itself writing a client sidecar (.data) to avoid recursion, and
@@ -1591,196 +1546,116 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 	// player - there are no separate client worlds to embed. Skip the
 	// coopClientSaves sequence entirely (SEPARATE keeps embedding as before).
 	bool sharedSave = (_campaignType == CoopCampaignType::Shared);
-	if (_coop && connectionTCP::saveID != 0 && !isSidecarWrite && !sharedSave)
-	{
-		// Blob identity comes from the locked roster (host at [0], clients after),
-		// NOT from reverse-parsing map keys: each client's world lives under
-		// hostBlobKey(name) at the current saveID (the store keeps one entry per
-		// client and the saveID is stable within a session - see PRD-04). This
-		// removes the fragile filename find/substr + lexicographic-id selection
-		// that could pick the wrong blob (S8). Keyed by exact name, so player
-		// "Bob" can never collide with "Super_Bob".
-		std::lock_guard<std::mutex> lock(connectionTCP::coopFilesMutex);
-		std::vector<std::pair<std::string, const std::string*>> toEmbed; // (key, blob)
-		for (size_t i = 1; i < _coopPlayers.size(); ++i)
-		{
-			// blob matched by exact roster name (any saveID); the embedded key is
-			// normalized to the CURRENT saveID so the reconnect flow finds it
-			// after this save is loaded.
-			const std::string* blob = connectionTCP::findHostClientBlob(_coopPlayers[i]);
-			if (blob && !blob->empty())
-				toEmbed.emplace_back(connectionTCP::hostBlobKey(_coopPlayers[i]), blob);
-		}
-		if (!toEmbed.empty())
-		{
-			auto seq = writer["coopClientSaves"];
-			seq.setAsSeq();
-			for (const auto& kb : toEmbed)
-			{
-				auto e = seq.write();
-				e.setAsMap();
-				e.write("key", kb.first);
-				e.writeBase64("blob", const_cast<char*>(kb.second->data()), kb.second->size());
-			}
-		}
+	if (!_coop || connectionTCP::saveID == 0 || isSidecarWrite || sharedSave)
+	{
+		return std::string();
 	}
 
-	writer.write("monthsPassed", _monthsPassed);
-	writer.write("daysPassed", _daysPassed);
-	writer.write("vehiclesLost", _vehiclesLost);
-	writer.write("graphRegionToggles", _graphRegionToggles);
-	writer.write("graphCountryToggles", _graphCountryToggles);
-	writer.write("graphFinanceToggles", _graphFinanceToggles);
-	writer.write("rng", RNG::getSeed());
-	writer.write("funds", _funds);
-	writer.write("maintenance", _maintenance);
-	writer.write("userNotes", _userNotes);
-	if (Options::oxceGeoscapeDebugLogMaxEntries > 0 && _geoscapeDebugLog.size() > 0)
+	// Blob identity comes from the locked roster (host at [0], clients after),
+	// NOT from reverse-parsing map keys: each client's world lives under
+	// hostBlobKey(name) at the current saveID (the store keeps one entry per
+	// client and the saveID is stable within a session - see PRD-04). This
+	// removes the fragile filename find/substr + lexicographic-id selection
+	// that could pick the wrong blob (S8). Keyed by exact name, so player
+	// "Bob" can never collide with "Super_Bob".
+	std::lock_guard<std::mutex> lock(connectionTCP::coopFilesMutex);
+	std::vector<std::pair<std::string, const std::string*>> toEmbed; // (key, blob)
+	for (size_t i = 1; i < _coopPlayers.size(); ++i)
 	{
-		auto geoDebugLog = writer["geoscapeDebugLog"];
-		geoDebugLog.setAsSeq();
-		size_t lastEntriesToWrite = std::min(_geoscapeDebugLog.size(), (size_t)Options::oxceGeoscapeDebugLogMaxEntries);
-		for (size_t j = _geoscapeDebugLog.size() - lastEntriesToWrite; j < _geoscapeDebugLog.size(); ++j)
-			geoDebugLog.write(_geoscapeDebugLog[j]);
+		// blob matched by exact roster name (any saveID); the embedded key is
+		// normalized to the CURRENT saveID so the reconnect flow finds it
+		// after this save is loaded.
+		const std::string* blob = connectionTCP::findHostClientBlob(_coopPlayers[i]);
+		if (blob && !blob->empty())
+			toEmbed.emplace_back(connectionTCP::hostBlobKey(_coopPlayers[i]), blob);
 	}
-
-	writer.write("researchScores", _researchScores);
-	writer.write("incomes", _incomes);
-	writer.write("expenditures", _expenditures);
-	writer.write("warned", _warned);
-	writer.write("togglePersonalLight", _togglePersonalLight);
-	writer.write("toggleNightVision", _toggleNightVision);
-	writer.write("toggleBrightness", _toggleBrightness);
-	writer.write("globeLon", _globeLon);
-	writer.write("globeLat", _globeLat);
-	writer.write("globeZoom", _globeZoom);
-	writer.write("ids", _ids);
-
-	saveVector(writer, _countries, "countries", mod->getScriptGlobal());
-	saveVector(writer, _regions, "regions");
-
-	// coop
-	saveVectorIf(writer, _bases, "bases",
-				 [](const Base* b)
-				 { return !b->_coopIcon; });
-	
-	saveVector(writer, _waypoints, "waypoints");
-
-	// coop
-	saveVectorIf(writer, _missionSites, "missionSites",
-				[](const MissionSite* ms)
-				{ return !ms->_coop; });
-
-	// Alien bases must be saved before alien missions.
-	// coop
-	saveVectorIf(writer, _alienBases, "alienBases",
-				 [](const AlienBase* ab)
-				 { return !ab->_coop; });
-
-	// Missions must be saved before UFOs, but after alien bases.
-	// coop
-	saveVectorIf(writer, _activeMissions, "alienMissions",
-				 [](const AlienMission* am)
-				 { return !am->_coop; });
-	// UFOs must be after missions
-	// coop
-	const bool isNewGame = (getMonthsPassed() == -1);
-
-	saveVectorIf(
-		writer, _ufos, "ufos",
-		[](const Ufo* u)
-		{ return !u->_coop; },
-		mod->getScriptGlobal(), isNewGame);
-
-	saveVector(writer, _geoscapeEvents, "geoscapeEvents");
-	if (!_discovered.empty())
+	if (toEmbed.empty())
 	{
-		auto discoveredWriter = writer["discovered"];
-		discoveredWriter.setAsSeq();
-		{
-			auto discoveredCopy = _discovered;
-			std::sort(discoveredCopy.begin(), discoveredCopy.end(), [&](const RuleResearch* a, const RuleResearch* b)
-					  { return a->getName().compare(b->getName()) < 0; });
-			for (const auto* research : discoveredCopy)
-			{
-				discoveredWriter.write(research->getName());
-			}
-		}
+		return std::string();
 	}
-	saveVector(writer, _researchDiary, "researchDiary");
-	writer.write("poppedResearch", _poppedResearch,
-		[](YAML::YamlNodeWriter& w, const RuleResearch* r)
-		{ w.write(r->getName()); });
-	writer.write("generatedEvents", _generatedEvents);
-	writer.write("ufopediaRuleStatus", _ufopediaRuleStatus);
-	writer.write("manufactureRuleStatus", _manufactureRuleStatus);
-	writer.write("researchRuleStatus", _researchRuleStatus);
-	writer.write("monthlyPurchaseLimitLog", _monthlyPurchaseLimitLog);
-	writer.write("hiddenPurchaseItems", _hiddenPurchaseItemsMap);
-	writer.write("customRuleCraftDeployments", _customRuleCraftDeployments);
-	_alienStrategy->save(writer["alienStrategy"]);
 
-	saveVector(writer, _deadSoldiers, "deadSoldiers", mod->getScriptGlobal());
-	for (int j = 0; j < Options::oxceMaxEquipmentLayoutTemplates; ++j)
+	YAML::YamlRootNodeWriter writer;
+	writer.setAsMap();
+	auto seq = writer["coopClientSaves"];
+	seq.setAsSeq();
+	for (const auto& kb : toEmbed)
 	{
-		if (!_globalEquipmentLayout[j].empty())
-			saveVector(writer, _globalEquipmentLayout[j], writer.saveString("globalEquipmentLayout" + std::to_string(j)));
-		if (!_globalEquipmentLayoutName[j].empty())
-			writer.write(writer.saveString("globalEquipmentLayoutName" + std::to_string(j)), _globalEquipmentLayoutName[j]);
-		if (!_globalEquipmentLayoutArmor[j].empty())
-			writer.write(writer.saveString("globalEquipmentLayoutArmor" + std::to_string(j)), _globalEquipmentLayoutArmor[j]);
+		auto e = seq.write();
+		e.setAsMap();
+		e.write("key", kb.first);
+		e.writeBase64("blob", const_cast<char*>(kb.second->data()), kb.second->size());
 	}
-	for (int j = 0; j < MAX_CRAFT_LOADOUT_TEMPLATES; ++j)
+	return writer.emit().yaml;
+}
+
+/**
+ * Saves a saved game's contents into the co-op file store.
+ * @param filename Unused, kept for the save/load symmetry.
+ * @param mod Mod for the script values.
+ * @param key Key of the blob in the co-op file store.
+ */
+void SavedGame::saveCoopToMemory(const std::string& filename, Mod* mod, const std::string& key) const
+{
+	if (!validateCoopBases())
 	{
-		if (!_globalCraftLoadout[j]->getContents()->empty())
-			_globalCraftLoadout[j]->save(writer[writer.saveString("globalCraftLoadout" + std::to_string(j))]);
-		if (!_globalCraftLoadoutName[j].empty())
-			writer.write(writer.saveString("globalCraftLoadoutName" + std::to_string(j)), _globalCraftLoadoutName[j]);
+		connectionTCP::saveError = true;
+		return;
 	}
-	if (Options::soldierDiaries)
-		saveVector(writer, _missionStatistics, "missionStatistics");
 
-	if (!_autosales.empty())
+	storeCoopBlob(key, serialize(mod));
+}
+
+/**
+ * Stores an already serialized world into the co-op file store.
+ * @param key Key of the blob in the co-op file store.
+ * @param data Whole save file contents.
+ */
+void SavedGame::storeCoopBlob(const std::string& key, std::string data)
+{
+	std::lock_guard<std::mutex> lock(connectionTCP::coopFilesMutex);
+	if (connectionTCP::getServerOwner() == true)
 	{
-		auto autoSales = writer["autoSales"];
-		autoSales.setAsSeq();
-		{
-			std::vector<const RuleItem*> autosalesVector(_autosales.begin(), _autosales.end());
-			std::sort(autosalesVector.begin(), autosalesVector.end(), [&](const RuleItem* a, const RuleItem* b)
-				{ return a->getType().compare(b->getType()) < 0; });
-			for (const auto* sale : autosalesVector)
-			{
-				autoSales.write(sale->getType());
-			}
-		}
+		connectionTCP::coopFilesHost[key] = std::move(data);
 	}
-	// snapshot of the user options (just for debugging purposes)
-	auto optionsWriter = writer["options"];
-	optionsWriter.setAsMap();
-	for (const auto& optionInfo : Options::getOptionInfo())
-		optionInfo.save(optionsWriter);
-
-	if (_battleGame)
-		_battleGame->save(writer["battleGame"]);
-	_scriptValues.save(writer.toBase(), mod->getScriptGlobal());
+	else
+	{
+		connectionTCP::coopFilesClient[key] = std::move(data);
+	}
+}
 
-	// concatenate header + separator + body
-	// per yaml standard, "bare documents" in a yaml "stream" can be separated by either a "document end" or "directives end" marker line
-	YAML::YamlString headerString = headerWriter.emit();
-	std::string directivesEndMarker = "---\n";
-	YAML::YamlString bodyString = writer.emit();
-	std::string finalString;
-	finalString.reserve(headerString.yaml.size() + directivesEndMarker.size() + bodyString.yaml.size());
-	finalString += headerString.yaml;
-	finalString	+= directivesEndMarker;
-	finalString += bodyString.yaml;
+/**
+ * Saves a saved game's contents to a YAML file.
+ * @param filename YAML filename.
+ * @param mod Mod for the script values.
+ */
+void SavedGame::save(const std::string &filename, Mod *mod) const
+{
+	std::string finalString = serialize(mod);
+	finalString += serializeClientSaves(filename);
 
+	// a queued autosave must not land on top of this one
+	SaveWriter::wait();
 	std::string filepath = Options::getMasterUserFolder() + filename;
 	if (!CrossPlatform::writeFile(filepath, finalString))
 	{
 		throw Exception("Failed to save " + filepath);
 	}
+}
 
+/**
+ * Saves a saved game's contents to a YAML file without waiting
+ * for the disk. The game is serialized right away, so it can keep
+ * changing while SaveWriter writes the file, a backup file first
+ * that is then renamed over the old save.
+ * @param filename YAML filename.
+ * @param mod Mod for the script values.
+ */
+void SavedGame::saveAsync(const std::string &filename, Mod *mod) const
+{
+	std::string finalString = serialize(mod);
+	finalString += serializeClientSaves(filename);
+
+	SaveWriter::queue(Options::getMasterUserFolder() + filename, std::move(finalString));
 }
 
 /**
@@ -2320,6 +2195,7 @@ void SavedGame::setManufactureRuleStatus(const std::string &manufactureRule, int
 void SavedGame::setResearchRuleStatus(const std::string &researchRule, int newStatus)
 {
 	_researchRuleStatus[researchRule] = newStatus;
+	_researchRuleStatusCache.clear();
 }
 
 /**
@@ -2353,7 +2229,7 @@ const RuleResearch* SavedGame::selectGetOneFree(const RuleResearch* research)
 		std::vector<const RuleResearch*> possibilities;
 		for (auto* free : research->getGetOneFree())
 		{
-			if (isResearchRuleStatusDisabled(free->getName()))
+			if (isResearchRuleStatusDisabled(free))
 			{
 				continue; // skip disabled topics
 			}
@@ -2368,7 +2244,7 @@ const RuleResearch* SavedGame::selectGetOneFree(const RuleResearch* research)
 			{
 				for (auto* res : pair.second)
 				{
-					if (isResearchRuleStatusDisabled(res->getName()))
+					if (isResearchRuleStatusDisabled(res))
 					{
 						continue; // skip disabled topics
 					}
@@ -2403,6 +2279,10 @@ void SavedGame::removeDiscoveredResearch(const RuleResearch * research)
 	if (r != _discovered.end())
 	{
 		_discovered.erase(r);
+		if (!haveReserchVector(_discovered, research))
+		{
+			_researchFrontier.remove(research);
+		}
 	}
 }
 
@@ -2417,6 +2297,7 @@ void SavedGame::makeAllResearchDiscovered(const Mod* mod)
 		_discovered.push_back(pair.second);
 	}
 	sortReserchVector(_discovered);
+	_researchFrontier.rebuild(_discovered);
 }
 
 /**
@@ -2428,7 +2309,7 @@ void SavedGame::makeAllResearchDiscovered(const Mod* mod)
  */
 void SavedGame::addFinishedResearch(const RuleResearch * research, const Mod * mod, Base * base, bool score)
 {
-	if (isResearchRuleStatusDisabled(research->getName()))
+	if (isResearchRuleStatusDisabled(research))
 	{
 		return;
 	}
@@ -2452,8 +2333,8 @@ void SavedGame::addFinishedResearch(const RuleResearch * research, const Mod * m
 		{
 			if (!research->isRepeatable())
 			{
-				_discovered.push_back(currentQueueItem);
-				sortReserchVector(_discovered);
+				insertReserchVector(_discovered, currentQueueItem);
+				_researchFrontier.add(currentQueueItem);
 			}
 
 			if (currentQueueItem != research)
@@ -2498,7 +2379,7 @@ void SavedGame::addFinishedResearch(const RuleResearch * research, const Mod * m
 		// process "re-enables": https://openxcom.org/forum/index.php?topic=12071.0
 		for (const auto* ree : currentQueueItem->getReenabled())
 		{
-			if (isResearchRuleStatusDisabled(ree->getName()))
+			if (isResearchRuleStatusDisabled(ree))
 			{
 				setResearchRuleStatus(ree->getName(), RuleResearch::RESEARCH_STATUS_NEW); // reset status
 			}
@@ -2593,7 +2474,7 @@ bool SavedGame::isResearchable(const RuleItem* item, const Mod* mod) const
 		if (pair.second->needItem() && pair.second->getNeededItem() == item)
 		{
 			// This research topic is "permanently" disabled, ignore it!
-			if (isResearchRuleStatusDisabled(pair.first))
+			if (isResearchRuleStatusDisabled(pair.second))
 			{
 				continue;
 			}
@@ -2636,37 +2517,30 @@ bool SavedGame::isResearchable(const RuleItem* item, const Mod* mod) const
  */
 void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> &projects, const Mod *mod, Base *base, bool considerDebugMode) const
 {
-	// This list is used for topics that can be researched even if *not all* dependencies have been discovered yet (e.g. STR_ALIEN_ORIGINS)
+	// Topics on the "unlocked list" can be researched even if *not all* dependencies have been discovered yet (e.g. STR_ALIEN_ORIGINS)
 	// Note: all requirements of such topics *have to* be discovered though! This will be handled elsewhere.
-	std::vector<const RuleResearch *> unlocked;
-	for (const auto* research : _discovered)
-	{
-		for (const auto* unl : research->getUnlocked())
-		{
-			unlocked.push_back(unl);
-		}
-		sortReserchVector(unlocked);
-	}
+	// Both are tracked by _researchFrontier as topics get discovered, so these checks don't search the discovered list.
+	bool debug = considerDebugMode && _debug;
 
 	// Create a list of research topics available for research in the given base
 	for (const auto& pair : mod->getResearchMap())
 	{
 		// This research topic is permanently disabled, ignore it!
-		if (isResearchRuleStatusDisabled(pair.first))
+		if (isResearchRuleStatusDisabled(pair.second))
 		{
 			continue;
 		}
 
 		RuleResearch *research = pair.second;
 
-		if ((considerDebugMode && _debug) || haveReserchVector(unlocked, research))
+		if (debug || _researchFrontier.isUnlocked(research))
 		{
 			// Empty, these research topics are on the "unlocked list", *don't* check the dependencies!
 		}
 		else
 		{
 			// These items are not on the "unlocked list", we must check if "dependencies" are satisfied!
-			if (!isResearched(research->getDependencies(), considerDebugMode))
+			if (!_researchFrontier.hasDependencies(research))
 			{
 				continue;
 			}
@@ -2678,13 +2552,13 @@ void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> &projec
 		//   - there is an additional filter in NewPossibleResearchState::NewPossibleResearchState()
 		//   - we do this check for other functionality using this method, namely SavedGame::addFinishedResearch()
 		//     - Note: when called from there, parameter considerDebugMode = false
-		if (!isResearched(research->getRequirements(), considerDebugMode))
+		if (!debug && !_researchFrontier.hasRequirements(research))
 		{
 			continue;
 		}
 
 		// Remove the already researched topics from the list *UNLESS* they can still give you something more
-		if (isResearched(research->getName(), false))
+		if (_researchFrontier.isDiscovered(research))
 		{
 			if (hasUndiscoveredGetOneFree(research, true))
 			{
@@ -2822,19 +2696,17 @@ void SavedGame::getAvailableProductions (std::vector<RuleManufacture *> & produc
  */
 void SavedGame::getDependableManufacture (std::vector<RuleManufacture *> & dependables, const RuleResearch *research, const Mod * mod, Base *) const
 {
-	for (const auto& manuf : mod->getManufactureList())
+	for (auto* m : mod->getDependencyGraph()->getResearch(research).manufacture)
 	{
 		// don't show previously unlocked (and seen!) manufacturing topics
-		auto i = _manufactureRuleStatus.find(manuf);
+		auto i = _manufactureRuleStatus.find(m->getName());
 		if (i != _manufactureRuleStatus.end())
 		{
 			if (i->second != RuleManufacture::MANU_STATUS_NEW)
 				continue;
 		}
 
-		RuleManufacture *m = mod->getManufacture(manuf);
-		const auto& reqs = m->getRequirements();
-		if (isResearched(reqs) && std::find(reqs.begin(), reqs.end(), research) != reqs.end())
+		if (isResearched(m->getRequirements()))
 		{
 			dependables.push_back(m);
 		}
@@ -2881,21 +2753,13 @@ void SavedGame::getAvailableTransformations (std::vector<RuleSoldierTransformati
  */
 void SavedGame::getDependablePurchase(std::vector<RuleItem *> & dependables, const RuleResearch *research, const Mod * mod) const
 {
-	for (const auto& itemType : mod->getItemsList())
+	for (auto* item : mod->getDependencyGraph()->getResearch(research).items)
 	{
-		RuleItem *item = mod->getItem(itemType);
 		if (item->getBuyCost() != 0)
 		{
-			const auto& reqs = item->getRequirements();
-			bool found = std::find(reqs.begin(), reqs.end(), research) != reqs.end();
-			const auto& reqsBuy = item->getBuyRequirements();
-			bool foundBuy = std::find(reqsBuy.begin(), reqsBuy.end(), research) != reqsBuy.end();
-			if (found || foundBuy)
+			if (isResearched(item->getBuyRequirements()) && isResearched(item->getRequirements()))
 			{
-				if (isResearched(item->getBuyRequirements()) && isResearched(item->getRequirements()))
-				{
-					dependables.push_back(item);
-				}
+				dependables.push_back(item);
 			}
 		}
 	}
@@ -2909,18 +2773,13 @@ void SavedGame::getDependablePurchase(std::vector<RuleItem *> & dependables, con
  */
 void SavedGame::getDependableCraft(std::vector<RuleCraft *> & dependables, const RuleResearch *research, const Mod * mod) const
 {
-	for (const auto& craftType : mod->getCraftsList())
+	for (auto* craftItem : mod->getDependencyGraph()->getResearch(research).crafts)
 	{
-		RuleCraft *craftItem = mod->getCraft(craftType);
 		if (craftItem->getBuyCost() != 0)
 		{
-			const auto& reqs = craftItem->getRequirements();
-			if (std::find(reqs.begin(), reqs.end(), research->getName()) != reqs.end())
+			if (isResearched(craftItem->getRequirements()))
 			{
-				if (isResearched(craftItem->getRequirements()))
-				{
-					dependables.push_back(craftItem);
-				}
+				dependables.push_back(craftItem);
 			}
 		}
 	}
@@ -2934,16 +2793,11 @@ void SavedGame::getDependableCraft(std::vector<RuleCraft *> & dependables, const
  */
 void SavedGame::getDependableFacilities(std::vector<RuleBaseFacility *> & dependables, const RuleResearch *research, const Mod * mod) const
 {
-	for (const auto& facType : mod->getBaseFacilitiesList())
+	for (auto* facilityItem : mod->getDependencyGraph()->getResearch(research).facilities)
 	{
-		RuleBaseFacility *facilityItem = mod->getBaseFacility(facType);
-		const auto& reqs = facilityItem->getRequirements();
-		if (std::find(reqs.begin(), reqs.end(), research->getName()) != reqs.end())
+		if (isResearched(facilityItem->getRequirements()))
 		{
-			if (isResearched(facilityItem->getRequirements()))
-			{
-				dependables.push_back(facilityItem);
-			}
+			dependables.push_back(facilityItem);
 		}
 	}
 }
@@ -3001,6 +2855,42 @@ bool SavedGame::isResearchRuleStatusDisabled(const std::string &researchRule) co
 	return false;
 }
 
+/**
+ * Gets the status of a research rule without a name lookup once it
+ * was asked for, the status map is only read on the first call per
+ * topic after a change.
+ * @param research Research rule.
+ * @return Status (0=new, 1=normal, 2=disabled, 3=hidden).
+ */
+int SavedGame::getResearchRuleStatus(const RuleResearch *research) const
+{
+	if (research->getIndex() < 0)
+	{
+		return getResearchRuleStatus(research->getName());
+	}
+	size_t index = research->getIndex();
+	if (index >= _researchRuleStatusCache.size())
+	{
+		_researchRuleStatusCache.resize(index + 1, -1);
+	}
+	int &status = _researchRuleStatusCache[index];
+	if (status < 0)
+	{
+		status = getResearchRuleStatus(research->getName());
+	}
+	return status;
+}
+
+/**
+ * Is the research permanently disabled?
+ * @param research Research rule.
+ * @return True, if the research rule status is disabled.
+ */
+bool SavedGame::isResearchRuleStatusDisabled(const RuleResearch *research) const
+{
+	return getResearchRuleStatus(research) == RuleResearch::RESEARCH_STATUS_DISABLED;
+}
+
 /**
  * Returns if a research still has undiscovered non-disabled "getOneFree".
  * @param r Research to check.
@@ -3044,7 +2934,7 @@ bool SavedGame::hasUndiscoveredProtectedUnlock(const RuleResearch * r) const
 	// Note: checking for not yet discovered unlocks protected by "requires" (which also implies cost = 0)
 	for (const auto* unlock : r->getUnlocked())
 	{
-		if (isResearchRuleStatusDisabled(unlock->getName()))
+		if (isResearchRuleStatusDisabled(unlock))
 		{
 			// ignore all disabled topics (as if they didn't exist)
 			continue;
@@ -3083,7 +2973,7 @@ bool SavedGame::isResearched(const RuleResearch *research, bool considerDebugMod
 	if (considerDebugMode && _debug)
 		return true;
 
-	return haveReserchVector(_discovered, research);
+	return _researchFrontier.isDiscovered(research);
 }
 
 bool SavedGame::isResearched(const std::vector<std::string> &research, bool considerDebugMode) const
@@ -3123,12 +3013,12 @@ bool SavedGame::isResearched(const std::vector<const RuleResearch *> &research,
 		if (skipDisabled)
 		{
 			// ignore all disabled topics (as if they didn't exist)
-			if (isResearchRuleStatusDisabled(res->getName()))
+			if (isResearchRuleStatusDisabled(res))
 			{
 				continue;
 			}
 		}
-		if (!haveReserchVector(_discovered, res))
+		if (!_researchFrontier.isDiscovered(res))
 		{
 			return false;
 		}
@@ -4244,7 +4134,7 @@ bool SavedGame::handleResearchUnlockedByMissions(const RuleResearch* research, c
 
 	auto addResearchDiaryEntryForMission = [&](const RuleResearch* discoveredResearch, DiscoverySourceType sourceType, const AlienDeployment* sourceMission, const RuleResearch* sourceResearch)
 	{
-		if (!isResearched(discoveredResearch, false) && !isResearchRuleStatusDisabled(discoveredResearch->getName()))
+		if (!isResearched(discoveredResearch, false) && !isResearchRuleStatusDisabled(discoveredResearch))
 		{
 			ResearchDiaryEntry* entry = new ResearchDiaryEntry(discoveredResearch);
 			entry->setDate(_time);
@@ -32,6 +32,7 @@
 #include "../Mod/RuleCraft.h"
 #include "../Engine/Script.h"
 #include "ResearchDiary.h"
+#include "ResearchFrontier.h"
 
 namespace OpenXcom
 {
@@ -195,11 +196,13 @@ private:
 	AlienStrategy *_alienStrategy;
 	SavedBattleGame *_battleGame;
 	std::vector<const RuleResearch*> _discovered;
+	ResearchFrontier _researchFrontier;
 	std::vector<ResearchDiaryEntry*> _researchDiary;
 	std::map<std::string, int> _generatedEvents;
 	std::map<std::string, int> _ufopediaRuleStatus;
 	std::map<std::string, int> _manufactureRuleStatus;
 	std::map<std::string, int> _researchRuleStatus;
+	mutable std::vector<int> _researchRuleStatusCache;
 	std::map<std::string, int> _monthlyPurchaseLimitLog;
 	std::map<std::string, bool> _hiddenPurchaseItemsMap;
 	std::map<std::string, RuleCraftDeployment> _customRuleCraftDeployments;
@@ -232,6 +235,12 @@ private:
 	ScriptValues<SavedGame> _scriptValues;
 
 	static SaveInfo getSaveInfo(const std::string &file, Language *lang);
+	/// Serializes the game into the whole save file contents.
+	std::string serialize(Mod *mod) const;
+	/// Serializes the client worlds embedded in host saves.
+	std::string serializeClientSaves(const std::string &filename) const;
+	/// Checks if the bases can be sent to a co-op peer.
+	bool validateCoopBases() const;
   public:
 	// coop
 	void setMonthsPassed(int months);
@@ -252,7 +261,11 @@ private:
 	void loadUfopediaRuleStatus(const YAML::YamlNodeReader& reader);
 	/// Saves a saved game to YAML.
 	void saveCoopToMemory(const std::string& filename, Mod* mod, const std::string& key) const;
+	/// Stores an already serialized world as a co-op blob.
+	static void storeCoopBlob(const std::string& key, std::string data);
 	void save(const std::string &filename, Mod *mod) const;
+	/// Saves a saved game to YAML, writing the file in the background.
+	void saveAsync(const std::string &filename, Mod *mod) const;
 	/// Gets the game name.
 	std::string getName() const;
 	/// Sets the game name.
@@ -428,6 +441,10 @@ private:
 	int getResearchRuleStatus(const std::string &researchRule) const;
 	/// Is the research permanently disabled?
 	bool isResearchRuleStatusDisabled(const std::string &researchRule) const;
+	/// Gets the status of a research rule, cached by research index.
+	int getResearchRuleStatus(const RuleResearch *research) const;
+	/// Is the research permanently disabled? Cached by research index.
+	bool isResearchRuleStatusDisabled(const RuleResearch *research) const;
 	/// Gets if a research still has undiscovered non-disabled "getOneFree".
 	bool hasUndiscoveredGetOneFree(const RuleResearch * r, bool checkOnlyAvailableTopics) const;
 	/// Gets if a research still has undiscovered non-disabled "protected unlocks".
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TargetIndex.h"
+#include <algorithm>
+#include <cmath>
+#include "Target.h"
+#include "../fmath.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates an empty index.
+ */
+TargetIndex::TargetIndex() : _cells(LatCells * LonCells), _size(0)
+{
+}
+
+/**
+ * Gets the latitude band, bands go from the north pole (-PI/2) to the south.
+ * @param lat Latitude in radians.
+ * @return Band index.
+ */
+int TargetIndex::latCell(double lat)
+{
+	int cell = (int)std::floor((lat + M_PI_2) / M_PI * LatCells);
+	return Clamp(cell, 0, LatCells - 1);
+}
+
+/**
+ * Gets the longitude cell, wrapping around the globe.
+ * @param lon Longitude in radians.
+ * @return Cell index.
+ */
+int TargetIndex::lonCell(double lon)
+{
+	int cell = (int)std::floor(lon / (2 * M_PI) * LonCells) % LonCells;
+	return cell < 0 ? cell + LonCells : cell;
+}
+
+/**
+ * Removes all targets, keeping the cell storage.
+ */
+void TargetIndex::clear()
+{
+	if (_size == 0)
+	{
+		return;
+	}
+	for (auto &cell : _cells)
+	{
+		cell.clear();
+	}
+	_size = 0;
+}
+
+/**
+ * Adds a target at its current position.
+ * @param target Target to add.
+ * @param order Position of the target in the caller's list, returned by queries.
+ */
+void TargetIndex::insert(const Target *target, int order)
+{
+	_cells[latCell(target->getLatitude()) * LonCells + lonCell(target->getLongitude())].push_back(Entry{ target, order });
+	++_size;
+}
+
+/**
+ * Collects targets in cells touched by the spherical cap around a point.
+ * @param lon Longitude of the center in radians.
+ * @param lat Latitude of the center in radians.
+ * @param range Radius of the cap in radians (great circle distance).
+ * @param orders Receives the positions passed to insert(), sorted ascending.
+ */
+void TargetIndex::query(double lon, double lat, double range, std::vector<int> &orders) const
+{
+	orders.clear();
+	if (_size == 0 || range < 0)
+	{
+		return;
+	}
+
+	int latMin = latCell(lat - range);
+	int latMax = latCell(lat + range);
+	// widest longitude extent of the cap, the whole band if it covers a pole
+	bool allLon = lat - range <= -M_PI_2 || lat + range >= M_PI_2 || range >= M_PI_2;
+	double dlon = 0;
+	if (!allLon)
+	{
+		double s = std::sin(range) / std::cos(lat);
+		allLon = s >= 1.0;
+		if (!allLon)
+		{
+			dlon = std::asin(s);
+		}
+	}
+	int lonFirst = 0;
+	int lonCount = LonCells;
+	if (!allLon)
+	{
+		lonFirst = lonCell(lon - dlon);
+		int lonLast = lonCell(lon + dlon);
+		lonCount = std::min(LonCells, (lonLast - lonFirst + LonCells) % LonCells + 1);
+	}
+
+	for (int y = latMin; y <= latMax; ++y)
+	{
+		for (int i = 0; i < lonCount; ++i)
+		{
+			for (const auto &entry : _cells[y * LonCells + (lonFirst + i) % LonCells])
+			{
+				orders.push_back(entry.order);
+			}
+		}
+	}
+	std::sort(orders.begin(), orders.end());
+}
+
+}
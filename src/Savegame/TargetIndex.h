@@ -0,0 +1,67 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+
+namespace OpenXcom
+{
+
+class Target;
+
+/**
+ * Spatial index of targets on the globe, for range queries.
+ * The sphere is split into latitude bands and each band into
+ * longitude cells, a query only visits the cells touched by
+ * the spherical cap around the point. Results are a superset,
+ * callers still check the exact distance. Targets move, so the
+ * index is rebuilt whenever the owner refreshes its target list,
+ * which is cheap next to the pairwise checks it saves.
+ */
+class TargetIndex
+{
+	static const int LatCells = 90;
+	static const int LonCells = 180;
+
+	struct Entry
+	{
+		const Target *target;
+		int order;
+	};
+
+	std::vector<std::vector<Entry>> _cells;
+	int _size;
+
+	/// Gets the latitude band of a latitude.
+	static int latCell(double lat);
+	/// Gets the longitude cell of a longitude.
+	static int lonCell(double lon);
+public:
+	/// Creates an empty index.
+	TargetIndex();
+	/// Removes all targets.
+	void clear();
+	/// Adds a target with its position in the caller's list.
+	void insert(const Target *target, int order);
+	/// Gets the number of targets in the index.
+	int size() const { return _size; }
+	/// Gets the positions of targets possibly within range of a point.
+	void query(double lon, double lat, double range, std::vector<int> &orders) const;
+};
+
+}
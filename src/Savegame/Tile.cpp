@@ -32,6 +32,7 @@
 #include "../Battlescape/BattlescapeGame.h"
 #include "../fmath.h"
 #include "SavedBattleGame.h"
+#include "../CoopMod/CoopMessages.h"
 
 namespace OpenXcom
 {
@@ -550,21 +551,7 @@ bool Tile::destroy(TilePart part, SpecialTileType type)
 	if (connectionTCP::getCoopStatic() == true && connectionTCP::getHost() == true)
 	{
 
-		Json::Value root;
-		root["state"] = "destroy_tile";
-
-		root["tile_pos_x"] = _pos.x;
-		root["tile_pos_y"] = _pos.y;
-		root["tile_pos_z"] = _pos.z;
-
-		root["tile_part"] = (int)part;
-		root["special_tile_type"] = (int)type;
-
-		root["explosive"] = _explosive;
-		root["explosive_type"] = _explosiveType;
-		
-
-		connectionTCP::sendTCPPacketStaticData2(root.toStyledString());
+		CoopJson::send(TileDestroy{ _pos, (int)part, (int)type, _explosive, _explosiveType });
 
 	}
 
@@ -837,17 +824,7 @@ void Tile::setFire(int fire)
 	if (connectionTCP::getCoopStatic() == true && connectionTCP::getHost() == true)
 	{
 
-		Json::Value root;
-		root["state"] = "set_fire_tile";
-
-		root["tile_pos_x"] = _pos.x;
-		root["tile_pos_y"] = _pos.y;
-		root["tile_pos_z"] = _pos.z;
-
-		root["fire"] = _fire;
-		root["animation_offset"] = _animationOffset;
-
-		connectionTCP::sendTCPPacketStaticData2(root.toStyledString());
+		CoopJson::send(TileFire{ _pos, _fire, _animationOffset });
 
 	}
 
@@ -909,18 +886,7 @@ void Tile::setSmoke(int smoke)
 	if (connectionTCP::getCoopStatic() == true && connectionTCP::getHost() == true)
 	{
 
-		Json::Value root;
-		root["state"] = "set_smoke_tile";
-
-		root["tile_pos_x"] = _pos.x;
-		root["tile_pos_y"] = _pos.y;
-		root["tile_pos_z"] = _pos.z;
-
-		root["smoke"] = _smoke;
-		root["animation_offset"] = _animationOffset;
-		root["overlaps"] = _overlaps;
-		
-		connectionTCP::sendTCPPacketStaticData2(root.toStyledString());
+		CoopJson::send(TileSmoke{ _pos, _smoke, _animationOffset, _overlaps });
 
 	}
 
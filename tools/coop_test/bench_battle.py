@@ -0,0 +1,58 @@
+"""Battlescape benchmark. Boots one instance to the main menu and runs the
+in-game bench_battle command: a seeded skirmish is generated, then map
+generation, a full FOV and lighting pass, alien reachability and the AI
+decisions of N alien turns are timed (the decisions are carried out between
+turns, so every turn decides on a changed battle). Prints the report as JSON (or writes it with --out),
+so runs can be compared across builds. Not a coop test.
+
+    python tools/coop_test/bench_battle.py --mission STR_UFO_SCOUT --seed 7 --turns 5
+"""
+import argparse, json, os, sys, time
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from harness import GameClient, make_user_dir
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--mission", default="", help="deployment or UFO type, empty = first deployment")
+    ap.add_argument("--terrain", default="", help="empty = first terrain New Battle offers")
+    ap.add_argument("--craft", default="")
+    ap.add_argument("--race", default="")
+    ap.add_argument("--seed", type=int, default=1)
+    ap.add_argument("--turns", type=int, default=3)
+    ap.add_argument("--difficulty", type=int, default=0)
+    ap.add_argument("--crashed", action="store_true", help="crash site instead of a landed UFO")
+    ap.add_argument("--runs", type=int, default=1, help="repeat and keep every report")
+    ap.add_argument("--out", default="", help="write the reports here instead of stdout")
+    args = ap.parse_args()
+
+    d = make_user_dir("bench")
+    g = GameClient("bench-host", 45998, d)
+    g.spawn()
+    reports = []
+    try:
+        g.connect(timeout=180)
+        g.wait_for("main menu",
+                   lambda: (lambda s: s if s and s[0] != "class OpenXcom::StartState" else None)(
+                       g.cmd({"cmd": "get_state"}).get("states")),
+                   timeout=180, interval=2)
+        g.sock.settimeout(600)  # big maps with many aliens take a while
+        for _ in range(args.runs):
+            reports.append(g.ok({"cmd": "bench_battle", "mission": args.mission, "terrain": args.terrain,
+                                 "craft": args.craft, "alienRace": args.race, "seed": args.seed,
+                                 "turns": args.turns, "difficulty": args.difficulty,
+                                 "ufoLanded": not args.crashed}))
+    finally:
+        time.sleep(1)
+        g.shutdown()
+
+    text = json.dumps(reports if args.runs > 1 else reports[0], indent=2)
+    if args.out:
+        with open(args.out, "w") as f:
+            f.write(text + "\n")
+    else:
+        print(text)
+
+
+if __name__ == "__main__":
+    main()
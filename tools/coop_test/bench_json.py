@@ -0,0 +1,50 @@
+"""Co-op message encoding benchmark. Boots one instance to the main menu and
+runs the in-game bench_json command: typical battle messages (tile, walk,
+shot, hit, AI progress) are encoded the old way, a Json::Value tree built key
+by key as the senders used to plus toStyledString(), and with the CoopJson
+streaming writer. Prints nanoseconds
+and bytes per message for both, and fails if any message got bigger or the two
+encodings parse to different values. Not a coop test.
+
+    python tools/coop_test/bench_json.py --iterations 50000
+"""
+import argparse, json, os, sys, time
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from harness import GameClient, make_user_dir
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--iterations", type=int, default=20000, help="encodings per message and way")
+    ap.add_argument("--out", default="", help="write the report here as JSON")
+    args = ap.parse_args()
+
+    d = make_user_dir("bench_json")
+    g = GameClient("bench-json", 45997, d)
+    g.spawn()
+    try:
+        g.connect(timeout=180)
+        g.sock.settimeout(300)
+        report = g.ok({"cmd": "bench_json", "iterations": args.iterations})
+    finally:
+        time.sleep(1)
+        g.shutdown()
+
+    print(f"{'message':<22} {'styled':>10} {'streamed':>10} {'speedup':>8} {'bytes':>12}")
+    for m in report["messages"]:
+        print(f"{m['state']:<22} {m['styledNs']:8.0f}ns {m['streamedNs']:8.0f}ns "
+              f"{m['styledNs'] / max(m['streamedNs'], 1e-9):7.1f}x "
+              f"{m['styledBytes']:5} -> {m['streamedBytes']:<5}")
+    if args.out:
+        with open(args.out, "w") as f:
+            json.dump(report, f, indent=2)
+            f.write("\n")
+
+    for m in report["messages"]:
+        assert m["same"], f"{m['state']}: streamed text parses to different values"
+        assert m["streamedBytes"] <= m["styledBytes"], f"{m['state']}: wire size grew"
+    print("PASS")
+
+
+if __name__ == "__main__":
+    main()
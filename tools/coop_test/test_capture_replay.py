@@ -0,0 +1,137 @@
+"""Packet capture + replay: record a real client session, play it back headless.
+
+  CAPTURE  a host and a client bring up a SHARED campaign and let the geoscape
+           run for a while; the client records every message in and out of its
+           transport (`net_capture` .. `net_capture_stop`).
+  REPLAY   a fresh instance at the main menu replays the client's inbound side
+           at full speed (`net_replay`, speed 0) and then at the recorded pace,
+           acting as a client that just joined. Everything fed has to be
+           handled by the normal updateCoopTask path.
+
+Prints the throughput (messages/sec), the main-thread cost per message type and
+the message types the replay sent back next to what the captured client sent.
+With --baseline FILE the sent types are compared against an earlier run (the
+file is written if it doesn't exist yet): a new or missing type is a protocol
+change and fails the run.
+
+Run:  python tools/coop_test/test_capture_replay.py [--seconds 60] [--baseline FILE]
+"""
+
+import argparse
+import json
+import os
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from harness import GameClient, make_user_dir
+import session
+
+HOST_PORT = 49020
+CLIENT_PORT = 49021
+REPLAY_PORT = 49022
+COOP_PORT = "48320"
+
+# sent on timers or in answer to timers, so their counts differ between runs
+TIMED_TYPES = {"PING", "PONG", "time", "target_positions"}
+
+
+def replay(gc, capture, speed, timeout):
+    """Plays the capture into gc and waits until everything fed got handled."""
+    r = gc.ok({"cmd": "net_replay", "file": capture, "speed": speed})
+    total = r["messages"]
+    deadline = time.time() + timeout
+    last, stalled_since = -1, time.time()
+    while True:
+        st = gc.ok({"cmd": "net_replay_stats"})
+        if st["drained"]:
+            break
+        if st["handled"] != last:
+            last, stalled_since = st["handled"], time.time()
+        elif time.time() - stalled_since > 15:
+            raise RuntimeError(f"replay stalled: fed {st['fed']}/{total}, handled {st['handled']}")
+        if time.time() > deadline:
+            raise TimeoutError(f"replay too slow: fed {st['fed']}/{total}, handled {st['handled']}")
+        time.sleep(0.5)
+    gc.ok({"cmd": "net_replay_stop"})
+    assert st["fed"] == total, f"fed {st['fed']} of {total}"
+    assert st["handled"] == total, f"handled {st['handled']} of {total} fed messages"
+    return st
+
+
+def report(tag, st):
+    print(f"{tag}: {st['handled']} messages in {st['wallMs']:.0f} ms "
+          f"({st['messagesPerSecond']:.0f}/s)")
+    for h in st["handlers"][:10]:
+        print(f"  {h['name']:<32} x{h['count']:<6} total {h['totalMs']:8.2f} ms"
+              f"  mean {h['meanMs']:7.3f}  max {h['maxMs']:7.3f}")
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--seconds", type=int, default=60, help="geoscape time to capture")
+    ap.add_argument("--baseline", help="sent-types baseline to compare against (written if missing)")
+    args = ap.parse_args()
+
+    host = GameClient("host", HOST_PORT, make_user_dir("capture_host"))
+    client_dir = make_user_dir("capture_client")
+    client = GameClient("client", CLIENT_PORT, client_dir)
+    player = GameClient("replay", REPLAY_PORT, make_user_dir("capture_replay"))
+    capture = os.path.join(client_dir, "session.oxcap")
+    try:
+        # ================================================================
+        # 1) CAPTURE a real client session
+        # ================================================================
+        for gc in (host, client):
+            gc.spawn()
+            gc.connect()
+        client.ok({"cmd": "net_capture", "file": capture})
+        session.new_campaign(host, client, port=COOP_PORT, campaign_mode="shared")
+        for gc in (host, client):
+            gc.cmd({"cmd": "geo_set_speed", "idx": 2})
+        time.sleep(args.seconds)
+        recorded = client.ok({"cmd": "net_capture_stop"})["recorded"]
+        assert recorded > 0, "nothing captured"
+        print(f"PASS capture: {recorded} messages recorded to {capture}")
+        for gc in (client, host):
+            gc.shutdown()
+
+        # ================================================================
+        # 2) REPLAY it headless, full speed and recorded pace
+        # ================================================================
+        player.spawn()
+        player.connect()
+        fast = replay(player, capture, 0, timeout=300)
+        report("PASS replay (full speed)", fast)
+        player.ok({"cmd": "disconnect_to_menu"})
+        paced = replay(player, capture, 1.0, timeout=args.seconds * 3 + 300)
+        report("PASS replay (recorded pace)", paced)
+        assert paced["total"] == fast["total"], "the two replays fed different captures"
+
+        # ================================================================
+        # 3) PROTOCOL: what the replayed client sends back
+        # ================================================================
+        sent = {k: v for k, v in fast.get("sent", {}).items() if k not in TIMED_TYPES}
+        captured = {k: v for k, v in fast.get("capturedSent", {}).items() if k not in TIMED_TYPES}
+        for name in sorted(set(sent) | set(captured)):
+            print(f"  sent {name:<32} replay {sent.get(name, 0):<6} captured {captured.get(name, 0)}")
+        if args.baseline:
+            if os.path.exists(args.baseline):
+                with open(args.baseline, encoding="utf-8") as f:
+                    expected = set(json.load(f))
+                added, missing = set(sent) - expected, expected - set(sent)
+                assert not added and not missing, f"protocol changed: new {sorted(added)}, gone {sorted(missing)}"
+                print(f"PASS protocol: sent types match {args.baseline}")
+            else:
+                with open(args.baseline, "w", encoding="utf-8") as f:
+                    json.dump(sorted(sent), f, indent=1)
+                print(f"baseline written to {args.baseline}")
+
+        print("ALL PASS")
+    finally:
+        for gc in (host, client, player):
+            gc.shutdown()
+
+
+if __name__ == "__main__":
+    main()
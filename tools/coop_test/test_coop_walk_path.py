@@ -0,0 +1,148 @@
+"""Co-op walk path: the walker sends the path it will really walk, cut where its
+time units, energy or time unit reserve run out, and the peer walks exactly that.
+A SHARED battle is entered as in test_shared_battle_turn_control.py, then the
+host moves one of its own soldiers through `battle_action move`:
+
+  WALK      a short move -> both machines end with the unit on the same tile,
+            with the same time units and energy.
+  RESERVE   the host reserves time units for a snap shot (the client does not)
+            and sends the unit far away -> the walk stops short where the
+            reserve starts, on both machines alike.
+  NO STEP   the same move again: the first step already eats into the reserve,
+            the path goes out empty and interrupted -> neither machine moves the
+            unit or charges it anything.
+
+Run:  python tools/coop_test/test_coop_walk_path.py
+"""
+
+import os
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import shared_fixture
+import test_shared_battle as B
+import test_shared_battle_turn_control as T
+
+
+def _unit(gc, uid):
+    for u in B._battle(gc)["units"]:
+        if u["id"] == uid:
+            return u
+    raise AssertionError(f"{gc.name}: no unit {uid}")
+
+
+def _where(gc, uid):
+    u = _unit(gc, uid)
+    return (u["x"], u["y"], u["z"], u["tu"], u["energy"], u["status"])
+
+
+def _settled(host, client, uid):
+    """Both machines idle with the unit standing in the same place and state."""
+    if B._battle(host).get("isBusy"):
+        return None
+    h, c = _where(host, uid), _where(client, uid)
+    return (h, c) if h == c and h[5] == 0 else None
+
+
+def _move(host, uid, pos, offsets):
+    """Walk to the first of pos + offsets that has a path; returns the target."""
+    for dx, dy in offsets:
+        x, y, z = pos[0] + dx, pos[1] + dy, pos[2]
+        r = host.cmd({"cmd": "battle_action", "action": "move", "unit": uid, "x": x, "y": y, "z": z})
+        if r.get("ok"):
+            return (x, y, z)
+    raise AssertionError(f"no reachable target around {pos} for unit {uid}")
+
+
+def main():
+    js = shared_fixture.bring_up("jwalk", (48994, 48995, 48294))
+    host, client = js.host, js.client
+    try:
+        owner = {s["id"]: s["owner"] for s in B._roster(host)}
+        squad = sorted(sid for sid, o in owner.items() if o == 0)[:2]
+        assert len(squad) == 2, f"need 2 host-owned soldiers, have {squad}"
+        cid = B._skyranger(host)["id"]
+        for sid in owner:
+            host.ok({"cmd": "craft_assign", "craft_id": cid, "soldier_id": sid, "on": sid in squad})
+        for gc in (host, client):
+            gc.wait_for("squad aboard", lambda gc=gc: (T._aboard(gc, cid) == squad) or None,
+                        timeout=45, interval=0.5)
+
+        b0 = B._base0(host)
+        blon, blat = b0["lon"], b0["lat"]
+        site_id = host.ok({"cmd": "spawn_mission_site", "mission": "STR_ALIEN_TERROR",
+                           "deployment": "STR_TERROR_MISSION", "lon": blon + 0.35,
+                           "lat": blat + 0.10, "race": "STR_SECTOID", "hours": 240})["site_id"]
+        host.wait_for("site on host",
+                      lambda: any(s["id"] == site_id for s in B._geo(host)["missionSites"]) or None,
+                      timeout=30)
+        host.ok({"cmd": "craft_force", "craft_id": cid, "status": "STR_OUT",
+                 "lon": blon + 0.34, "lat": blat + 0.10, "dest": f"site:{site_id}",
+                 "fuel": 999999, "lowFuel": False})
+
+        def _landing_prompt():
+            if B._has(host, "ConfirmLandingState"):
+                return True
+            host.cmd({"cmd": "geo_set_speed", "idx": 2})
+            return None
+        host.wait_for("ConfirmLandingState on host", _landing_prompt, timeout=90, interval=0.5)
+        host.ok({"cmd": "confirm_landing"})
+        for gc in (host, client):
+            gc.wait_for("briefing", lambda gc=gc: B._has(gc, "BriefingState") or None,
+                        timeout=180, interval=0.5)
+            gc.ok({"cmd": "close_briefing"})
+        for gc in (host, client):
+            gc.wait_for("inventory", lambda gc=gc: B._has(gc, "InventoryState") or None,
+                        timeout=30, interval=0.5)
+            gc.ok({"cmd": "battle_inventory", "action": "ok"})
+        T._drain_to_tactical(host, client)
+        host.wait_for("host turn active",
+                      lambda: (B._battle(host).get("coopTurn") == 2) or None,
+                      timeout=30, interval=0.5)
+
+        uid = next(u["id"] for u in B._battle(host)["units"]
+                   if u["soldierId"] in squad and u.get("selectable"))
+        start = host.wait_for("unit settled", lambda: _settled(host, client, uid),
+                              timeout=30, interval=0.5)[0]
+
+        # ================================================================
+        # 1) WALK: a short move ends the same on both machines.
+        # ================================================================
+        near = [(3, 0), (0, 3), (-3, 0), (0, -3), (2, 2), (-2, -2), (2, -2), (-2, 2)]
+        target = _move(host, uid, start, near)
+        walked = host.wait_for("walk settled on both", lambda: _settled(host, client, uid),
+                               timeout=60, interval=0.5)[0]
+        assert walked[:3] == target, f"walked to {walked[:3]}, asked for {target}"
+        assert walked[3] < start[3], f"the walk cost no time units: {start[3]} -> {walked[3]}"
+        print(f"PASS walk: unit {uid} {start[:3]} -> {walked[:3]}, "
+              f"tu {walked[3]} energy {walked[4]} on both")
+
+        # ================================================================
+        # 2) RESERVE: the host's reserve cuts the path the client walks.
+        # ================================================================
+        host.ok({"cmd": "battle_action", "action": "reserve", "mode": "snap"})
+        far = [(dx * 5, dy * 5) for dx, dy in near]
+        target = _move(host, uid, walked, far)
+        cut = host.wait_for("reserve walk settled on both", lambda: _settled(host, client, uid),
+                            timeout=90, interval=0.5)[0]
+        assert cut[:3] != target, f"walked all the way to {target} through the reserve"
+        print(f"PASS reserve: stopped at {cut[:3]} short of {target}, "
+              f"tu {cut[3]} energy {cut[4]} on both")
+
+        # ================================================================
+        # 3) NO STEP: an interrupted path with no steps moves nobody.
+        # ================================================================
+        host.ok({"cmd": "battle_action", "action": "move", "unit": uid,
+                 "x": target[0], "y": target[1], "z": target[2]})
+        time.sleep(3)
+        still = host.wait_for("no-step walk settled on both", lambda: _settled(host, client, uid),
+                              timeout=30, interval=0.5)[0]
+        assert still == cut, f"unit moved or was charged: {cut} -> {still}"
+        print(f"PASS no step: unit {uid} stays at {still[:3]} with tu {still[3]} on both")
+    finally:
+        js.shutdown()
+
+
+if __name__ == "__main__":
+    main()
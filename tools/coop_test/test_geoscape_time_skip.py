@@ -0,0 +1,62 @@
+"""Geoscape idle time skip must not change the game. Runs the same seeded solo
+campaign twice, once with geoscapeTimeSkip off and once on, advancing a fixed
+number of days at 1 day speed through geo_advance (the frame clock is held, so
+the frame rate doesn't matter), and saves both. The two saves must be
+identical; the first differing lines are printed otherwise.
+
+    python tools/coop_test/test_geoscape_time_skip.py --days 45
+"""
+import argparse, os, sys, time
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from harness import GameClient, make_user_dir
+import session
+
+SAVE = "time_skip.sav"
+
+
+def run_campaign(skip, seed, days, port):
+    d = make_user_dir(f"time_skip_{'on' if skip else 'off'}")
+    g = GameClient(f"skip-{'on' if skip else 'off'}", port, d)
+    g.spawn()
+    try:
+        g.connect(timeout=180)
+        g.sock.settimeout(600)
+        g.ok({"cmd": "set_option", "name": "geoscapeTimeSkip", "value": skip})
+        g.ok({"cmd": "open_new_game", "mode": "solo"})
+        g.wait_for("difficulty", lambda: session.has_state(g, "NewGameState"))
+        g.ok({"cmd": "set_seed", "seed": seed})
+        g.ok({"cmd": "newgame_ok"})
+        g.wait_for("base", lambda: session.has_state(g, "BuildNewBaseState"))
+        # hold the clock before the first frame of the campaign can move it
+        g.ok({"cmd": "geo_advance", "ticks": 0})
+        g.ok({"cmd": "place_first_base", "lon": session.HOST_LON, "lat": session.HOST_LAT, "name": "SkipBase"})
+        g.wait_for("geoscape", lambda: not session.has_state(g, "BuildNewBaseState"))
+        r = g.ok({"cmd": "geo_advance", "speed": 5, "ticks": days})
+        print(f"  skip {'on ' if skip else 'off'}: reached {r['time']}")
+        g.ok({"cmd": "save_game", "file": SAVE})
+    finally:
+        time.sleep(1)
+        g.shutdown()
+    with open(os.path.join(d, "xcom1", SAVE), encoding="utf-8") as f:
+        return f.read().splitlines()
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--days", type=int, default=45, help="game days to run")
+    ap.add_argument("--seed", type=int, default=1234)
+    args = ap.parse_args()
+
+    off = run_campaign(False, args.seed, args.days, 45994)
+    on = run_campaign(True, args.seed, args.days, 45995)
+
+    diffs = [(i, a, b) for i, (a, b) in enumerate(zip(off, on)) if a != b]
+    for i, a, b in diffs[:10]:
+        print(f"  line {i + 1}:\n    off: {a}\n    on:  {b}")
+    assert len(off) == len(on), f"save lengths differ: {len(off)} vs {len(on)} lines"
+    assert not diffs, f"{len(diffs)} lines differ with geoscapeTimeSkip on"
+    print(f"PASS ({len(off)} lines identical after {args.days} days)")
+
+
+if __name__ == "__main__":
+    main()
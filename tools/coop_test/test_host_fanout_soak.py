@@ -0,0 +1,233 @@
+"""Host fan-out soak: one host serving 4-8 clients over the real coop transport.
+
+The host runs the normal game (driven through the TestServer up to its lobby,
+so its TCP host thread is live) with `coopMaxClients` raised. The clients are
+headless: plain sockets in this process that speak the framed transport (BE32
+length + JSON) and only read. No client sends INIT_SERVER, so the host's
+session layer never sees them; what is exercised is the transport alone.
+
+  FANOUT     every fast client receives every numbered SOAK message, in order,
+             and ends on the newest SOAK_SNAP snapshot.
+  ISOLATION  one client stops reading for a while. The fast clients must finish
+             while it is still stalled (no head-of-line blocking); the host shows
+             its backlog in net_peers. Once it reads again it gets everything,
+             in order, with stale snapshots skipped rather than queued.
+  OVERFLOW   a client that never reads is dropped by the host once its backlog
+             passes the per-client limit, while the others keep receiving.
+
+Run:  python tools/coop_test/test_host_fanout_soak.py [clients]   (4-8, default 6)
+"""
+
+import json
+import os
+import socket
+import struct
+import sys
+import threading
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from harness import GameClient, make_user_dir
+import session
+
+TEST_PORT = 49010
+COOP_PORT = 48310
+
+MESSAGES = 20000
+SIZE = 512
+SNAP_EVERY = 50
+STALL_SECONDS = 20
+# more than the host's per-client backlog limit (16 MB) plus socket buffers
+OVERFLOW_MESSAGES = 30000
+OVERFLOW_SIZE = 1024
+
+
+class HeadlessClient:
+    """A transport-only client: connects, reads frames, counts SOAK traffic."""
+
+    def __init__(self, name, stalled=False):
+        self.name = name
+        self.sock = socket.create_connection(("127.0.0.1", COOP_PORT), timeout=10)
+        self.sock.settimeout(None)
+        self.reading = threading.Event()
+        if not stalled:
+            self.reading.set()
+        self.lock = threading.Lock()
+        self.next_n = 0
+        self.out_of_order = None
+        self.last_snap = None
+        self.snaps = 0
+        self.closed = False
+        self.done_at = None
+        self.target = None
+        self.thread = threading.Thread(target=self._run, daemon=True)
+        self.thread.start()
+
+    def _recv_exact(self, n):
+        buf = b""
+        while len(buf) < n:
+            chunk = self.sock.recv(n - len(buf))
+            if not chunk:
+                raise ConnectionError("closed")
+            buf += chunk
+        return buf
+
+    def _run(self):
+        try:
+            while True:
+                self.reading.wait()
+                (length,) = struct.unpack(">I", self._recv_exact(4))
+                msg = json.loads(self._recv_exact(length))
+                kind = msg.get("type")
+                with self.lock:
+                    if kind == "SOAK":
+                        if msg["n"] != self.next_n and self.out_of_order is None:
+                            self.out_of_order = (self.next_n, msg["n"])
+                        self.next_n = msg["n"] + 1
+                        if self.target is not None and self.next_n >= self.target and self.done_at is None:
+                            self.done_at = time.time()
+                    elif kind == "SOAK_SNAP":
+                        self.snaps += 1
+                        self.last_snap = msg["n"]
+        except (ConnectionError, OSError):
+            with self.lock:
+                self.closed = True
+
+    def expect(self, total):
+        with self.lock:
+            self.target = total
+            self.done_at = time.time() if self.next_n >= total else None
+
+    def state(self):
+        with self.lock:
+            return {"next": self.next_n, "snap": self.last_snap, "snaps": self.snaps,
+                    "closed": self.closed, "order": self.out_of_order, "done": self.done_at}
+
+    def close(self):
+        try:
+            self.sock.close()
+        except OSError:
+            pass
+
+
+def _peers(host):
+    return host.ok({"cmd": "net_peers"})["peers"]
+
+
+def _soak(host, first, total, size):
+    """Queue SOAK messages first..total-1 through the host's real TX queue."""
+    n = first
+    while n < total:
+        r = host.ok({"cmd": "net_soak", "first": n, "count": min(1000, total - n),
+                     "size": size, "snapEvery": SNAP_EVERY})
+        n += r["queued"]
+        if r["queued"] == 0:
+            time.sleep(0.01)
+
+
+def _last_snap(first, total):
+    return max(i for i in range(first, total) if i % SNAP_EVERY == 0)
+
+
+def _wait_all(host, clients, total, timeout):
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        if all(c.state()["next"] >= total for c in clients):
+            return
+        time.sleep(0.2)
+    raise TimeoutError("clients did not receive everything: " +
+                       ", ".join(f"{c.name}={c.state()}" for c in clients))
+
+
+def main():
+    count = int(sys.argv[1]) if len(sys.argv) > 1 else 6
+    assert 4 <= count <= 8, "use 4-8 clients"
+
+    host_dir = make_user_dir("fanout_host")
+    with open(os.path.join(host_dir, "options.cfg"), "a", encoding="utf-8") as f:
+        f.write(f"  coopMaxClients: {count + 1}\n")
+    host = GameClient("host", TEST_PORT, host_dir)
+    clients = []
+    try:
+        host.spawn()
+        host.connect()
+
+        # bring the host up to its lobby: that starts the TCP host thread
+        host.ok({"cmd": "open_new_game", "mode": "shared"})
+        host.wait_for("difficulty", lambda: session.has_state(host, "NewGameState"))
+        host.ok({"cmd": "newgame_ok"})
+        host.wait_for("host window", lambda: session.has_state(host, "HostMenu"))
+        host.ok({"cmd": "host_tcp", "server": "SoakSrv", "port": str(COOP_PORT), "player": "HostPlayer"})
+        host.wait_for("host lobby", lambda: session.has_state(host, "LobbyMenu"))
+
+        # ================================================================
+        # 1) FANOUT + ISOLATION: count-1 fast clients, one stalled reader
+        # ================================================================
+        for i in range(count - 1):
+            clients.append(HeadlessClient(f"fast{i}"))
+        slow = HeadlessClient("slow", stalled=True)
+        clients.append(slow)
+        host.wait_for("all clients attached", lambda: len(_peers(host)) == count or None, timeout=30)
+        print(f"PASS attach: host serves {count} clients")
+
+        fast = clients[:-1]
+        for c in clients:
+            c.expect(MESSAGES)
+        started = time.time()
+        _soak(host, 0, MESSAGES, SIZE)
+        _wait_all(host, fast, MESSAGES, timeout=STALL_SECONDS)
+        elapsed = time.time() - started
+        assert not slow.reading.is_set(), "slow client resumed too early"
+        for c in fast:
+            st = c.state()
+            assert st["order"] is None, f"{c.name}: out of order {st['order']}"
+            assert st["snap"] == _last_snap(0, MESSAGES), f"{c.name}: last snapshot {st['snap']}"
+        peers = _peers(host)
+        backlog = peers[-1]["queuedBytes"]
+        assert backlog > 0, f"stalled client shows no backlog: {peers[-1]}"
+        assert all(p["queuedBytes"] < backlog for p in peers[:-1]), f"fast clients backed up: {peers}"
+        print(f"PASS fanout: {len(fast)} clients got {MESSAGES} messages in order in "
+              f"{elapsed:.1f}s while one client was stalled ({backlog} bytes waiting for it)")
+
+        slow.reading.set()
+        _wait_all(host, [slow], MESSAGES, timeout=60)
+        st = slow.state()
+        assert st["order"] is None, f"slow client out of order {st['order']}"
+        assert st["snap"] == _last_snap(0, MESSAGES), f"slow client last snapshot {st['snap']}"
+        skipped = _peers(host)[-1]["snapshotsSkipped"]
+        assert skipped > 0, "slow client was sent every stale snapshot"
+        print(f"PASS isolation: stalled client caught up in order, {st['snaps']} snapshots "
+              f"received, {skipped} stale ones skipped")
+
+        # ================================================================
+        # 2) OVERFLOW: a client that never reads gets dropped, alone
+        # ================================================================
+        dead = HeadlessClient("dead", stalled=True)
+        host.wait_for("dead client attached", lambda: len(_peers(host)) == count + 1 or None, timeout=30)
+        first = MESSAGES
+        total = first + OVERFLOW_MESSAGES
+        for c in clients:
+            c.expect(total)
+        _soak(host, first, total, OVERFLOW_SIZE)
+        _wait_all(host, clients, total, timeout=120)
+        host.wait_for("dead client dropped", lambda: len(_peers(host)) == count or None, timeout=30)
+        dead.reading.set()
+        dead.thread.join(timeout=30)
+        assert dead.state()["closed"], "dropped client's connection is still open"
+        for c in clients:
+            st = c.state()
+            assert st["order"] is None, f"{c.name}: out of order {st['order']}"
+            assert not st["closed"], f"{c.name}: dropped along with the dead client"
+        print(f"PASS overflow: the non-reading client was dropped, {count} others "
+              f"received all {total} messages")
+        dead.close()
+
+        print("ALL PASS")
+    finally:
+        for c in clients:
+            c.close()
+        host.shutdown()
+
+
+if __name__ == "__main__":
+    main()
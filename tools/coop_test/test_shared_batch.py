@@ -0,0 +1,139 @@
+"""SHARED outgoing command batches (shared_batch).
+
+A replica does not send every economy command on its own. Commands queue up and
+go out as one envelope; a command with a coalescing key (res_alloc, craft_equip,
+...) replaces a waiting one with the same key, and a batch ending in such a
+command is held briefly for more clicks. The host runs a batch in order and
+stops at the first rejection: the commands before it stand, the rest are
+refused with it.
+
+  COALESCE  the client queues 50 res_allocs on one project in one frame -> one
+            envelope, the host validates ONE command, both sides end on the
+            last value.
+  PARTIAL   the client queues res_alloc (valid), res_cancel of a project that is
+            not running (rejected), base_rename (valid on its own) -> one
+            shared_batch; the allocation is applied, the rename is refused with
+            the rejection, and the client sees one shared_fail.
+  ORDER     with two projects running, the client queues res_alloc on A, on B,
+            then on A again -> only a repeat of the LAST queued row merges, so
+            the host validates all three in the order they were queued.
+
+Run:  python tools/coop_test/test_shared_batch.py
+"""
+
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import shared_fixture
+
+
+def _base0(gc):
+    """The first real (non-mirror) base from the geoscape snapshot."""
+    for b in gc.ok({"cmd": "geo_state"})["bases"]:
+        if not b.get("coopBase") and not b.get("coopIcon"):
+            return b
+    raise AssertionError("no real base in geo_state")
+
+
+def _assigned(gc, topic):
+    for r in _base0(gc)["research"]:
+        if r["name"] == topic:
+            return r["assigned"]
+    return None
+
+
+def _stats(gc):
+    return gc.ok({"cmd": "shared_stats"})
+
+
+def _alloc(topic, n):
+    return {"jcmd": "res_alloc", "baseId": 0, "payload": {"project": topic, "assigned": n}}
+
+
+def main():
+    js = shared_fixture.bring_up("jbatch", (48992, 48993, 48292))
+    host, client = js.host, js.client
+    try:
+        topics = host.ok({"cmd": "available_research"})["topics"]
+        assert len(topics) >= 2, f"need >=2 startable topics, got {topics}"
+        T, T2 = topics[0], topics[1]
+        r = client.ok({"cmd": "research_start", "topic": T, "scientists": 1})
+        assert r.get("sent"), f"client research_start not sent: {r}"
+        for gc in (host, client):
+            gc.wait_for(f"{gc.name} started {T}",
+                        lambda gc=gc: (_assigned(gc, T) == 1) or None, timeout=30, interval=0.5)
+
+        # ================================================================
+        # 1) COALESCE: 50 absolute allocations of one row in one frame.
+        # ================================================================
+        host.ok({"cmd": "shared_reset_stats"})
+        client.ok({"cmd": "shared_reset_stats"})
+        values = [2 + i % 5 for i in range(49)] + [4]
+        client.ok({"cmd": "shared_cmds", "cmds": [_alloc(T, n) for n in values]})
+        for gc in (host, client):
+            gc.wait_for(f"{gc.name} at the last allocation",
+                        lambda gc=gc: (_assigned(gc, T) == 4) or None, timeout=30, interval=0.5)
+        cs, hs = _stats(client), _stats(host)
+        assert cs["sentCount"] == 1, f"client sent {cs['sentCount']} envelopes for one row"
+        assert hs["cmd"] == 1, f"host validated {hs['cmd']} commands, expected the one coalesced"
+        assert hs["batchCount"] == 0, "a lone coalesced command should travel as shared_cmd"
+        print(f"PASS coalesce: {len(values)} res_allocs -> 1 command, {T} @ 4 on both")
+
+        # ================================================================
+        # 2) PARTIAL: a batch rejected in the middle keeps its applied prefix.
+        # ================================================================
+        host.ok({"cmd": "shared_reset_stats"})
+        client.ok({"cmd": "shared_reset_stats"})
+        name0 = _base0(host)["name"]
+        client.ok({"cmd": "shared_cmds", "cmds": [
+            _alloc(T, 2),
+            {"jcmd": "res_cancel", "baseId": 0, "payload": {"project": T2}},
+            {"jcmd": "base_rename", "baseId": 0, "payload": {"name": "BatchRenamed"}},
+        ]})
+        client.wait_for("client saw the rejection",
+                        lambda: (_stats(client)["failCount"] >= 1) or None, timeout=30, interval=0.5)
+        for gc in (host, client):
+            gc.wait_for(f"{gc.name} applied the prefix",
+                        lambda gc=gc: (_assigned(gc, T) == 2) or None, timeout=30, interval=0.5)
+        cs, hs = _stats(client), _stats(host)
+        assert cs["sentCount"] == 1, f"client sent {cs['sentCount']} envelopes for one batch"
+        assert hs["batchCount"] == 1, f"host got {hs['batchCount']} shared_batch envelopes"
+        assert hs["cmd"] == 2, f"host validated {hs['cmd']} commands, expected to stop at the 2nd"
+        assert cs["failCount"] == 1, f"client got {cs['failCount']} shared_fails, expected one"
+        assert T2 in cs["lastFail"], f"unexpected rejection: {cs['lastFail']}"
+        for gc in (host, client):
+            assert _base0(gc)["name"] == name0, f"{gc.name}: command after the rejection was applied"
+        print(f"PASS partial: prefix applied ({T} @ 2), '{cs['lastFail']}', rename refused")
+        try:
+            client.ok({"cmd": "coop_dialog_back"})
+        except Exception:
+            pass
+
+        # ================================================================
+        # 3) ORDER: a keyed command doesn't merge past another row.
+        # ================================================================
+        r = client.ok({"cmd": "research_start", "topic": T2, "scientists": 1})
+        assert r.get("sent"), f"client research_start not sent: {r}"
+        for gc in (host, client):
+            gc.wait_for(f"{gc.name} started {T2}",
+                        lambda gc=gc: (_assigned(gc, T2) == 1) or None, timeout=30, interval=0.5)
+        host.ok({"cmd": "shared_reset_stats"})
+        client.ok({"cmd": "shared_reset_stats"})
+        client.ok({"cmd": "shared_cmds", "cmds": [_alloc(T, 3), _alloc(T2, 2), _alloc(T, 5)]})
+        for gc in (host, client):
+            gc.wait_for(f"{gc.name} at the interleaved allocations",
+                        lambda gc=gc: (_assigned(gc, T) == 5 and _assigned(gc, T2) == 2) or None,
+                        timeout=30, interval=0.5)
+        cs, hs = _stats(client), _stats(host)
+        assert cs["sentCount"] == 1, f"client sent {cs['sentCount']} envelopes for one batch"
+        assert hs["cmd"] == 3, f"host validated {hs['cmd']} commands, expected all 3 in order"
+        print(f"PASS order: {T} @ 5 and {T2} @ 2 on both, nothing merged across rows")
+
+        js.finish()
+    finally:
+        js.shutdown()
+
+
+if __name__ == "__main__":
+    main()